@@ -0,0 +1,79 @@
+/**
+ * @file archivomapeado.cpp
+ * @brief Implementación de la clase ArchivoMapeado.
+ * @author Tu Nombre
+ * @date 2025-06-15
+ */
+
+#include "archivomapeado.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define ARCHIVOMAPEADO_USA_MMAP 1
+#else
+#include <fstream>
+#include <iterator>
+#endif
+
+ArchivoMapeado::ArchivoMapeado(const std::string& nombreArchivo) {
+#ifdef ARCHIVOMAPEADO_USA_MMAP
+    int fd = ::open(nombreArchivo.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        return;
+    }
+    tamano = static_cast<std::size_t>(info.st_size);
+    if (tamano > 0) {
+        void* mapa = ::mmap(nullptr, tamano, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapa == MAP_FAILED) {
+            ::close(fd);
+            tamano = 0;
+            return;
+        }
+        // El archivo se recorre de principio a fin una sola vez
+        ::madvise(mapa, tamano, MADV_SEQUENTIAL);
+        datos = static_cast<const char*>(mapa);
+    }
+    ::close(fd);
+    abierto = true;
+#else
+    std::ifstream archivo(nombreArchivo, std::ios::binary);
+    if (!archivo.is_open()) {
+        return;
+    }
+    respaldo.assign(std::istreambuf_iterator<char>(archivo), std::istreambuf_iterator<char>());
+    datos = respaldo.data();
+    tamano = respaldo.size();
+    abierto = true;
+#endif
+}
+
+ArchivoMapeado::~ArchivoMapeado() {
+    Cerrar();
+}
+
+void ArchivoMapeado::Cerrar() {
+#ifdef ARCHIVOMAPEADO_USA_MMAP
+    if (datos != nullptr) {
+        ::munmap(const_cast<char*>(datos), tamano);
+    }
+#endif
+    datos = nullptr;
+    tamano = 0;
+    abierto = false;
+}
+
+bool ArchivoMapeado::EstaAbierto() const {
+    return abierto;
+}
+
+std::string_view ArchivoMapeado::GetContenido() const {
+    return std::string_view(datos, tamano);
+}
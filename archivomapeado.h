@@ -0,0 +1,54 @@
+#ifndef ARCHIVOMAPEADO_H
+#define ARCHIVOMAPEADO_H
+
+/**
+ * @file archivomapeado.h
+ * @brief Declaración de la clase ArchivoMapeado.
+ * @author Tu Nombre
+ * @date 2025-06-15
+ */
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/**
+ * @class ArchivoMapeado
+ * @brief Proyecta un archivo completo en memoria de solo lectura.
+ *
+ * En sistemas POSIX usa mmap, de modo que el contenido se lee directamente
+ * de la caché de páginas del sistema operativo sin copias intermedias. En otras
+ * plataformas el archivo se lee completo a un búfer propio.
+ */
+class ArchivoMapeado {
+private:
+    const char* datos = nullptr;
+    std::size_t tamano = 0;
+    bool abierto = false;
+    std::string respaldo; // Solo se usa cuando mmap no está disponible
+
+    void Cerrar();
+
+public:
+    /**
+     * @brief Abre y proyecta el archivo indicado.
+     * @param nombreArchivo La ruta del archivo a proyectar.
+     */
+    explicit ArchivoMapeado(const std::string& nombreArchivo);
+
+    /**
+     * @brief Libera la proyección del archivo.
+     */
+    ~ArchivoMapeado();
+
+    ArchivoMapeado(const ArchivoMapeado&) = delete;
+    ArchivoMapeado& operator=(const ArchivoMapeado&) = delete;
+
+    /** @brief Indica si el archivo pudo abrirse. @return true si el contenido es válido. */
+    bool EstaAbierto() const;
+
+    /** @brief Obtiene el contenido completo del archivo. @return Una vista al contenido proyectado. */
+    std::string_view GetContenido() const;
+};
+
+#endif // ARCHIVOMAPEADO_H
@@ -0,0 +1,1150 @@
+/**
+ * @file benchmarks.cpp
+ * @brief Benchmarks de rendimiento para el Servicio de Streaming.
+ * @author Tu Nombre
+ * @date 2025-06-15
+ *
+ * Uso: StreamingServiceBench [filtro] [--grande]
+ *   filtro    Ejecuta solo los benchmarks cuyo nombre contiene este texto.
+ *   --grande  Agrega los tamaños de catálogo más grandes (lento).
+ */
+
+#include "serviciostreaming.h"
+#include "archivomapeado.h"
+#include "parsercatalogo.h"
+#include "indicecalificaciones.h"
+#include "indicetitulos.h"
+#include "columnascatalogo.h"
+#include "filtrovectorial.h"
+#include "buscadortitulos.h"
+#include "indicetextual.h"
+#include "pelicula.h"
+#include "serie.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// --- Utilidades comunes ---
+
+struct OpcionesBench {
+    bool grande = false;
+};
+
+/**
+ * @brief Mide el tiempo de pared transcurrido desde su construcción.
+ */
+class Cronometro {
+public:
+    Cronometro() : inicio(std::chrono::steady_clock::now()) {}
+
+    double Milisegundos() const {
+        auto fin = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(fin - inicio).count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point inicio;
+};
+
+// Silencia std::cout mientras existe (CargarArchivo y los Mostrar* escriben en consola)
+class SilenciarSalida {
+public:
+    SilenciarSalida() : anterior(std::cout.rdbuf(descarte.rdbuf())) {}
+    ~SilenciarSalida() { std::cout.rdbuf(anterior); }
+
+private:
+    std::stringstream descarte;
+    std::streambuf* anterior;
+};
+
+std::vector<size_t> TamanosCatalogo(const OpcionesBench& opciones) {
+    std::vector<size_t> tamanos = {10000, 100000};
+    if (opciones.grande) {
+        tamanos.push_back(1000000);
+    }
+    return tamanos;
+}
+
+/**
+ * @brief Genera un archivo de catálogo sintético con el formato de datos.txt.
+ * @param nombreArchivo Ruta del archivo a generar.
+ * @param titulos Número de líneas (películas y series alternadas).
+ */
+void GenerarCatalogo(const std::string& nombreArchivo, size_t titulos) {
+    static const char* generos[] = {"Drama", "Comedia", "Accion", "Misterio", "Musical", "Crimen"};
+    std::ofstream archivo(nombreArchivo);
+    for (size_t i = 0; i < titulos; ++i) {
+        const char* genero = generos[i % 6];
+        if (i % 2 == 0) {
+            archivo << "Pelicula,P" << i << ",Pelicula " << i << ',' << 80 + i % 90 << ".0," << genero << ','
+                    << 1 + i % 5 << '-' << 1 + (i / 5) % 5 << '-' << 1 + (i / 25) % 5 << '\n';
+        } else {
+            archivo << "Serie,S" << i << ",Serie " << i << ',' << 20 + i % 40 << ".0," << genero << ','
+                    << 1 + i % 5 << '-' << 1 + (i / 3) % 5 << ';';
+            for (size_t e = 0; e < 4; ++e) {
+                if (e > 0) {
+                    archivo << '|';
+                }
+                archivo << "Episodio " << i << '.' << e << ':' << 1 + e / 2 << ':'
+                        << 1 + (i + e) % 5 << '-' << 1 + (i + 2 * e) % 5;
+            }
+            archivo << '\n';
+        }
+    }
+}
+
+// --- Benchmarks ---
+
+void BenchCargaArchivo(const OpcionesBench& opciones) {
+    const std::string nombreArchivo = "bench_catalogo.txt";
+    for (size_t titulos : TamanosCatalogo(opciones)) {
+        GenerarCatalogo(nombreArchivo, titulos);
+
+        double msFlujo = 0.0;
+        double msMapeado = 0.0;
+        {
+            SilenciarSalida silencio;
+            ServicioStreaming servicio;
+            Cronometro cronometro;
+            servicio.CargarArchivo(nombreArchivo, ModoCarga::Flujo);
+            msFlujo = cronometro.Milisegundos();
+        }
+        {
+            SilenciarSalida silencio;
+            ServicioStreaming servicio;
+            Cronometro cronometro;
+            servicio.CargarArchivo(nombreArchivo, ModoCarga::Mapeado);
+            msMapeado = cronometro.Milisegundos();
+        }
+        std::printf("  %9zu titulos | flujo %9.1f ms | mapeado %9.1f ms | aceleracion %.2fx\n",
+                    titulos, msFlujo, msMapeado, msFlujo / msMapeado);
+    }
+    std::remove(nombreArchivo.c_str());
+}
+
+void BenchCargaParalela(const OpcionesBench& opciones) {
+    const std::string nombreArchivo = "bench_catalogo.txt";
+    const unsigned nucleos = std::max(1u, std::thread::hardware_concurrency());
+    for (size_t titulos : TamanosCatalogo(opciones)) {
+        GenerarCatalogo(nombreArchivo, titulos);
+        double msUnHilo = 0.0;
+        for (unsigned hilos = 1; hilos <= nucleos; hilos *= 2) {
+            SilenciarSalida silencio;
+            ServicioStreaming servicio;
+            Cronometro cronometro;
+            servicio.CargarArchivo(nombreArchivo, ModoCarga::Paralelo, hilos);
+            double ms = cronometro.Milisegundos();
+            if (hilos == 1) {
+                msUnHilo = ms;
+            }
+            std::printf("  %9zu titulos | %2u hilos %9.1f ms | escalado %.2fx\n",
+                        titulos, hilos, ms, msUnHilo / ms);
+        }
+    }
+    std::remove(nombreArchivo.c_str());
+}
+
+void BenchIndiceCalificaciones(const OpcionesBench& opciones) {
+    std::vector<size_t> tamanos = {100000, 1000000};
+    if (opciones.grande) {
+        tamanos.push_back(5000000);
+    }
+    for (size_t titulos : tamanos) {
+        std::vector<PtrVideo> videos;
+        videos.reserve(titulos);
+        for (size_t i = 0; i < titulos; ++i) {
+            videos.push_back(std::make_unique<Pelicula>("P" + std::to_string(i), "Pelicula", 90, "Drama"));
+            videos.back()->Calificar(1 + i % 5);
+            videos.back()->Calificar(1 + (i / 5) % 5);
+            videos.back()->Calificar(1 + (i / 25) % 5);
+        }
+        IndiceCalificaciones indice;
+        indice.Reconstruir(videos);
+
+        // Consulta selectiva: solo ~1 de cada 125 títulos tiene promedio 5.0
+        const double minima = 5.0;
+        Cronometro cronometroLineal;
+        std::vector<size_t> lineal;
+        for (size_t i = 0; i < videos.size(); ++i) {
+            if (videos[i]->GetCalificacionPromedio() >= minima) {
+                lineal.push_back(i);
+            }
+        }
+        double msLineal = cronometroLineal.Milisegundos();
+
+        Cronometro cronometroIndice;
+        std::vector<size_t> indexado = indice.BuscarDesde(minima);
+        double msIndice = cronometroIndice.Milisegundos();
+
+        std::printf("  %9zu titulos | %7zu coincidencias | lineal %8.3f ms | indice %8.3f ms | %s\n",
+                    titulos, indexado.size(), msLineal, msIndice, lineal == indexado ? "ok" : "DIFERENTE");
+    }
+}
+
+std::string ToLowerMapa(const std::string& str) {
+    std::string lower_str = str;
+    std::transform(lower_str.begin(), lower_str.end(), lower_str.begin(),
+                   [](unsigned char c){ return std::tolower(c); });
+    return lower_str;
+}
+
+void BenchIndiceTitulos(const OpcionesBench& opciones) {
+    std::vector<size_t> tamanos = {10000, 1000000};
+    if (opciones.grande) {
+        tamanos.push_back(10000000);
+    }
+    const size_t consultas = 1000000;
+    for (size_t titulos : tamanos) {
+        std::vector<std::string> nombres(titulos);
+        for (size_t i = 0; i < titulos; ++i) {
+            nombres[i] = "Titulo Del Catalogo " + std::to_string(i);
+        }
+
+        std::map<std::string, size_t> mapa;
+        IndiceTitulos<size_t> hash;
+        hash.Reservar(titulos);
+        for (size_t i = 0; i < titulos; ++i) {
+            mapa[ToLowerMapa(nombres[i])] = i;
+            hash.Insertar(nombres[i], i);
+        }
+
+        // Consultas con el título tal como lo escribiría el usuario (mayúsculas mezcladas)
+        size_t encontradosMapa = 0;
+        Cronometro cronometroMapa;
+        for (size_t c = 0; c < consultas; ++c) {
+            const std::string& nombre = nombres[(c * 2654435761u) % titulos];
+            encontradosMapa += mapa.find(ToLowerMapa(nombre)) != mapa.end();
+        }
+        double msMapa = cronometroMapa.Milisegundos();
+
+        size_t encontradosHash = 0;
+        Cronometro cronometroHash;
+        for (size_t c = 0; c < consultas; ++c) {
+            const std::string& nombre = nombres[(c * 2654435761u) % titulos];
+            encontradosHash += hash.Buscar(nombre) != nullptr;
+        }
+        double msHash = cronometroHash.Milisegundos();
+
+        std::printf("  %9zu titulos | std::map %8.1f ns/consulta | hash plano %8.1f ns/consulta | %s\n",
+                    titulos, msMapa * 1e6 / consultas, msHash * 1e6 / consultas,
+                    encontradosMapa == encontradosHash ? "ok" : "DIFERENTE");
+    }
+}
+
+void BenchCalificarLote(const OpcionesBench& opciones) {
+    const std::string nombreArchivo = "bench_catalogo.txt";
+    const size_t titulos = 100000;
+    GenerarCatalogo(nombreArchivo, titulos);
+    std::vector<size_t> cantidades = {100000, 1000000};
+    if (opciones.grande) {
+        cantidades.push_back(10000000);
+    }
+    for (size_t cantidad : cantidades) {
+        std::vector<std::string> nombres(cantidad);
+        std::vector<EventoCalificacion> eventos(cantidad);
+        for (size_t i = 0; i < cantidad; ++i) {
+            size_t titulo = (i * 2654435761u) % titulos;
+            nombres[i] = (titulo % 2 == 0 ? "Pelicula " : "Serie ") + std::to_string(titulo);
+        }
+        for (size_t i = 0; i < cantidad; ++i) {
+            eventos[i] = {nombres[i], static_cast<int>(1 + i % 5)};
+        }
+
+        double msIndividual = 0.0;
+        double msLote = 0.0;
+        {
+            SilenciarSalida silencio;
+            ServicioStreaming servicio;
+            servicio.CargarArchivo(nombreArchivo, ModoCarga::Mapeado);
+            Cronometro cronometro;
+            for (const auto& evento : eventos) {
+                servicio.CalificarVideo(std::string(evento.titulo), evento.calificacion);
+            }
+            msIndividual = cronometro.Milisegundos();
+        }
+        {
+            SilenciarSalida silencio;
+            ServicioStreaming servicio;
+            servicio.CargarArchivo(nombreArchivo, ModoCarga::Mapeado);
+            Cronometro cronometro;
+            servicio.CalificarLote(eventos);
+            msLote = cronometro.Milisegundos();
+        }
+        std::printf("  %9zu eventos | individual %8.0f ev/s | lote %10.0f ev/s\n",
+                    cantidad, cantidad / (msIndividual / 1000.0), cantidad / (msLote / 1000.0));
+    }
+    std::remove(nombreArchivo.c_str());
+}
+
+void BenchCalificacionConcurrente(const OpcionesBench& opciones) {
+    const std::string nombreArchivo = "bench_catalogo.txt";
+    const size_t titulos = 100000;
+    const size_t totalEventos = opciones.grande ? 8000000 : 2000000;
+    const size_t tamanoLote = 256;
+    GenerarCatalogo(nombreArchivo, titulos);
+
+    // Mitad videos (actualizan los índices secundarios) y mitad episodios (solo atómicos)
+    std::vector<std::string> nombres(totalEventos);
+    std::vector<EventoCalificacion> eventos(totalEventos);
+    for (size_t i = 0; i < totalEventos; ++i) {
+        size_t titulo = (i * 2654435761u) % titulos;
+        if (i % 2 == 0) {
+            nombres[i] = (titulo % 2 == 0 ? "Pelicula " : "Serie ") + std::to_string(titulo);
+        } else {
+            titulo |= 1; // Solo las líneas impares son series
+            nombres[i] = "Episodio " + std::to_string(titulo) + '.' + std::to_string(i % 4);
+        }
+    }
+    for (size_t i = 0; i < totalEventos; ++i) {
+        eventos[i] = {nombres[i], static_cast<int>(1 + i % 5)};
+    }
+
+    std::printf("  %zu eventos en lotes de %zu, con un hilo lector consultando en paralelo (%u nucleos)\n",
+                totalEventos, tamanoLote, std::thread::hardware_concurrency());
+    for (unsigned hilos : {1u, 2u, 4u, 8u, 16u, 32u, 64u}) {
+        SilenciarSalida silencio;
+        ServicioStreaming servicio;
+        servicio.CargarArchivo(nombreArchivo, ModoCarga::Mapeado);
+
+        std::atomic<unsigned> activos{hilos};
+        std::atomic<size_t> consultas{0};
+        std::thread lector([&]() {
+            while (activos.load() > 0) {
+                servicio.BuscarVideos(3.0, "Drama");
+                consultas.fetch_add(1);
+            }
+        });
+        Cronometro cronometro;
+        std::vector<std::thread> escritores;
+        for (unsigned h = 0; h < hilos; ++h) {
+            escritores.emplace_back([&, h]() {
+                const size_t inicio = totalEventos * h / hilos;
+                const size_t fin = totalEventos * (h + 1) / hilos;
+                std::vector<EventoCalificacion> lote;
+                for (size_t i = inicio; i < fin; i += tamanoLote) {
+                    lote.assign(eventos.begin() + i, eventos.begin() + std::min(fin, i + tamanoLote));
+                    servicio.CalificarLote(lote);
+                }
+                activos.fetch_sub(1);
+            });
+        }
+        for (auto& escritor : escritores) {
+            escritor.join();
+        }
+        const double ms = cronometro.Milisegundos();
+        lector.join();
+        std::printf("  %2u hilos | %10.0f ev/s | %6.0f consultas/s\n",
+                    hilos, totalEventos / (ms / 1000.0), consultas.load() / (ms / 1000.0));
+    }
+    std::remove(nombreArchivo.c_str());
+}
+
+// Salida anterior a BufferSalida: una línea por std::endl (un vaciado, y por lo tanto
+// una llamada write(2), por línea) y números formateados con el estado del flujo.
+size_t EscribirLineaPorLinea(std::ostream& salida, const Video& video) {
+    size_t lineas = 0;
+    auto linea = [&](auto&&... partes) {
+        (salida << ... << partes) << std::endl;
+        ++lineas;
+    };
+    const Serie* serie = dynamic_cast<const Serie*>(&video);
+    linea(serie != nullptr ? "Tipo: Serie" : "Tipo: Pelicula");
+    linea("ID: ", video.GetId());
+    linea("Nombre: ", video.GetNombre());
+    linea("Duracion: ", video.GetDuracion(), " mins");
+    linea("Genero: ", video.GetGenero());
+    linea("Calificacion promedio: ", std::fixed, std::setprecision(1), video.GetCalificacionPromedio());
+    if (serie != nullptr) {
+        linea("  Episodios:");
+        for (const auto& ep : serie->GetEpisodios()) {
+            linea("    - Titulo Episodio: ", ep.GetTitulo());
+            linea("      Temporada: ", ep.GetTemporada());
+            linea("      Calificacion promedio: ", std::fixed, std::setprecision(1), ep.GetCalificacionPromedio());
+        }
+    }
+    linea("--------------------");
+    return lineas;
+}
+
+void BenchExportarCatalogo(const OpcionesBench& opciones) {
+    const std::string nombreArchivo = "bench_catalogo.txt";
+    const std::string nombreSalida = "bench_exportado.txt";
+    for (size_t titulos : TamanosCatalogo(opciones)) {
+        GenerarCatalogo(nombreArchivo, titulos);
+        ServicioStreaming servicio;
+        {
+            SilenciarSalida silencio;
+            servicio.CargarArchivo(nombreArchivo, ModoCarga::Mapeado);
+        }
+        std::vector<const Video*> todos = servicio.BuscarVideos(0.0, "");
+
+        size_t escriturasAntes = 0;
+        double msAntes = 0.0;
+        {
+            Cronometro cronometro;
+            std::ofstream salida(nombreSalida, std::ios::binary);
+            for (const Video* video : todos) {
+                escriturasAntes += EscribirLineaPorLinea(salida, *video);
+            }
+            salida.close();
+            msAntes = cronometro.Milisegundos();
+        }
+
+        double msDespues = 0.0;
+        size_t escriturasDespues = 0;
+        {
+            Cronometro cronometro;
+            servicio.ExportarCatalogo(nombreSalida);
+            msDespues = cronometro.Milisegundos();
+            std::ifstream exportado(nombreSalida, std::ios::binary | std::ios::ate);
+            size_t bytes = static_cast<size_t>(exportado.tellg());
+            escriturasDespues = (bytes + ServicioStreaming::kBloqueExportacion - 1) / ServicioStreaming::kBloqueExportacion;
+        }
+        std::printf("  %9zu titulos | std::endl %8.1f ms (%9zu escrituras) | BufferSalida %8.1f ms (%5zu escrituras) | x%.1f\n",
+                    titulos, msAntes, escriturasAntes, msDespues, escriturasDespues, msAntes / msDespues);
+    }
+    std::remove(nombreArchivo.c_str());
+    std::remove(nombreSalida.c_str());
+}
+
+void BenchSnapshot(const OpcionesBench& opciones) {
+    const std::string nombreArchivo = "bench_catalogo.txt";
+    const std::string nombreSnapshot = "bench_catalogo.snap";
+    for (size_t titulos : TamanosCatalogo(opciones)) {
+        GenerarCatalogo(nombreArchivo, titulos);
+        double msTexto = 0.0;
+        double msGuardar = 0.0;
+        double msSnapshot = 0.0;
+        {
+            SilenciarSalida silencio;
+            ServicioStreaming servicio;
+            Cronometro cronometro;
+            servicio.CargarArchivo(nombreArchivo, ModoCarga::Mapeado);
+            msTexto = cronometro.Milisegundos();
+            Cronometro cronometroGuardar;
+            servicio.GuardarSnapshot(nombreSnapshot);
+            msGuardar = cronometroGuardar.Milisegundos();
+        }
+        {
+            SilenciarSalida silencio;
+            ServicioStreaming servicio;
+            Cronometro cronometro;
+            servicio.CargarArchivo(nombreSnapshot, ModoCarga::Snapshot);
+            msSnapshot = cronometro.Milisegundos();
+        }
+        std::printf("  %9zu titulos | texto (mmap) %8.1f ms | guardar %8.1f ms | snapshot %8.1f ms | x%.1f\n",
+                    titulos, msTexto, msGuardar, msSnapshot, msTexto / msSnapshot);
+    }
+    std::remove(nombreArchivo.c_str());
+    std::remove(nombreSnapshot.c_str());
+}
+
+// Catálogo en memoria (sin archivo) para los recorridos de filtrado. Nombres cortos y una
+// serie cada diez títulos (cada std::deque vacío ya reserva un bloque) para que 10M quepan en memoria
+std::vector<PtrVideo> GenerarVideos(size_t titulos) {
+    static const char* generos[] = {"Drama", "Comedia", "Accion", "Misterio", "Musical", "Crimen"};
+    std::vector<PtrVideo> videos;
+    videos.reserve(titulos);
+    for (size_t i = 0; i < titulos; ++i) {
+        std::string id = std::to_string(i);
+        if (i % 10 != 0) {
+            videos.push_back(std::make_unique<Pelicula>("P" + id, "P " + id, 80.0 + i % 90, generos[i % 6]));
+        } else {
+            videos.push_back(std::make_unique<Serie>("S" + id, "S " + id, 20.0 + i % 40, generos[i % 6]));
+        }
+        videos.back()->SetGeneroId(static_cast<std::uint32_t>(i % 6));
+        videos.back()->Calificar(static_cast<int>(1 + i % 5), 1 + (i / 5) % 3);
+        videos.back()->Calificar(static_cast<int>(1 + (i / 7) % 5));
+    }
+    return videos;
+}
+
+void BenchEscaneoColumnar(const OpcionesBench& opciones) {
+    std::vector<size_t> tamanos = {1000000};
+    if (opciones.grande) {
+        tamanos.push_back(10000000);
+    }
+    const int repeticiones = 5;
+    const double minimo = 3.5;
+    for (size_t titulos : tamanos) {
+        std::vector<PtrVideo> videos = GenerarVideos(titulos);
+        ColumnasCatalogo columnas;
+        columnas.Reconstruir(videos);
+
+        size_t aciertosObjetos = 0;
+        size_t aciertosColumnas = 0;
+        double msGeneroObjetos = 0.0;
+        double msGeneroColumnas = 0.0;
+        double msPeliculasObjetos = 0.0;
+        double msPeliculasColumnas = 0.0;
+        for (int r = 0; r < repeticiones; ++r) {
+            {
+                Cronometro cronometro;
+                std::vector<size_t> filas;
+                for (size_t i = 0; i < videos.size(); ++i) {
+                    if (videos[i]->GetGeneroId() == 2 && videos[i]->GetCalificacionPromedio() >= minimo) {
+                        filas.push_back(i);
+                    }
+                }
+                msGeneroObjetos += cronometro.Milisegundos();
+                aciertosObjetos = filas.size();
+            }
+            {
+                Cronometro cronometro;
+                CriterioFiltro criterio;
+                criterio.calificacionMinima = minimo;
+                criterio.generoId = 2;
+                aciertosColumnas = columnas.Filtrar(criterio).size();
+                msGeneroColumnas += cronometro.Milisegundos();
+            }
+            {
+                Cronometro cronometro;
+                size_t peliculas = 0;
+                for (const auto& video : videos) {
+                    if (dynamic_cast<const Pelicula*>(video.get()) && video->GetCalificacionPromedio() >= minimo) {
+                        ++peliculas;
+                    }
+                }
+                msPeliculasObjetos += cronometro.Milisegundos();
+                aciertosObjetos += peliculas;
+            }
+            {
+                Cronometro cronometro;
+                CriterioFiltro criterio;
+                criterio.calificacionMinima = minimo;
+                criterio.tipo = ColumnasCatalogo::kTipoPelicula;
+                aciertosColumnas += columnas.Filtrar(criterio).size();
+                msPeliculasColumnas += cronometro.Milisegundos();
+            }
+        }
+        if (aciertosObjetos != aciertosColumnas) {
+            std::printf("  ERROR: resultados distintos (%zu vs %zu)\n", aciertosObjetos, aciertosColumnas);
+        }
+        std::printf("  %9zu titulos | genero+calif: objetos %7.1f ms, columnas %6.1f ms (x%.1f)"
+                    " | pelicula+calif: objetos %7.1f ms, columnas %6.1f ms (x%.1f)\n",
+                    titulos, msGeneroObjetos / repeticiones, msGeneroColumnas / repeticiones,
+                    msGeneroObjetos / msGeneroColumnas, msPeliculasObjetos / repeticiones,
+                    msPeliculasColumnas / repeticiones, msPeliculasObjetos / msPeliculasColumnas);
+    }
+}
+
+void BenchFiltroVectorial(const OpcionesBench& opciones) {
+    std::vector<size_t> tamanos = {1000000};
+    if (opciones.grande) {
+        tamanos.push_back(10000000);
+    }
+    const struct {
+        ImplementacionFiltro implementacion;
+        const char* nombre;
+    } implementaciones[] = {
+        {ImplementacionFiltro::Escalar, "escalar"},
+        {ImplementacionFiltro::SSE2, "sse2"},
+        {ImplementacionFiltro::AVX2, "avx2"},
+    };
+    const int repeticiones = 10;
+    const double minimo = 3.5;
+    for (size_t titulos : tamanos) {
+        ColumnasCatalogo columnas;
+        columnas.Reconstruir(GenerarVideos(titulos));
+        std::printf("  %9zu titulos (deteccion: %s)\n", titulos,
+                    implementaciones[static_cast<int>(FiltroVectorial::GetImplementacion())].nombre);
+
+        size_t referencia = 0;
+        double msReferencia = 0.0;
+        for (const auto& opcion : implementaciones) {
+            if (!FiltroVectorial::EstaDisponible(opcion.implementacion)) {
+                continue;
+            }
+            MapaSeleccion mapa;
+            size_t seleccionadas = 0;
+            double msGenero = 0.0;
+            double msTipo = 0.0;
+            for (int r = 0; r < repeticiones; ++r) {
+                Cronometro cronometroGenero;
+                FiltroVectorial::FiltrarGeneroYCalificacion(columnas.GetGeneroIds(), columnas.GetPromedios(), titulos,
+                                                            2, minimo, mapa, opcion.implementacion);
+                seleccionadas = FiltroVectorial::FilasSeleccionadas(mapa).size();
+                msGenero += cronometroGenero.Milisegundos();
+
+                Cronometro cronometroTipo;
+                FiltroVectorial::FiltrarTipoYCalificacion(columnas.GetTipos(), columnas.GetPromedios(), titulos,
+                                                          ColumnasCatalogo::kTipoPelicula, minimo, mapa, opcion.implementacion);
+                seleccionadas += FiltroVectorial::FilasSeleccionadas(mapa).size();
+                msTipo += cronometroTipo.Milisegundos();
+            }
+            msGenero /= repeticiones;
+            msTipo /= repeticiones;
+            if (opcion.implementacion == ImplementacionFiltro::Escalar) {
+                referencia = seleccionadas;
+                msReferencia = msGenero + msTipo;
+            } else if (seleccionadas != referencia) {
+                std::printf("  ERROR: %s selecciona %zu filas, la escalar %zu\n", opcion.nombre, seleccionadas, referencia);
+            }
+            std::printf("    %-8s genero+calif %6.2f ms | pelicula+calif %6.2f ms | x%.1f\n",
+                        opcion.nombre, msGenero, msTipo, msReferencia / (msGenero + msTipo));
+        }
+    }
+}
+
+void BenchDespachoTipo(const OpcionesBench& opciones) {
+    std::vector<size_t> tamanos = {1000000};
+    if (opciones.grande) {
+        tamanos.push_back(10000000);
+    }
+    const int repeticiones = 5;
+    for (size_t titulos : tamanos) {
+        std::vector<PtrVideo> videos = GenerarVideos(titulos);
+        size_t conRtti = 0;
+        size_t conEtiqueta = 0;
+        double msRtti = 0.0;
+        double msEtiqueta = 0.0;
+        for (int r = 0; r < repeticiones; ++r) {
+            {
+                Cronometro cronometro;
+                size_t contados = 0;
+                for (const auto& video : videos) {
+                    if (const Serie* serie = dynamic_cast<const Serie*>(video.get())) {
+                        contados += serie->GetEpisodios().size();
+                    } else if (dynamic_cast<const Pelicula*>(video.get())) {
+                        ++contados;
+                    }
+                }
+                msRtti += cronometro.Milisegundos();
+                conRtti = contados;
+            }
+            {
+                Cronometro cronometro;
+                size_t contados = 0;
+                for (const auto& video : videos) {
+                    if (const Serie* serie = ComoSerie(*video)) {
+                        contados += serie->GetEpisodios().size();
+                    } else if (ComoPelicula(*video)) {
+                        ++contados;
+                    }
+                }
+                msEtiqueta += cronometro.Milisegundos();
+                conEtiqueta = contados;
+            }
+        }
+        if (conRtti != conEtiqueta) {
+            std::printf("  ERROR: resultados distintos (%zu vs %zu)\n", conRtti, conEtiqueta);
+        }
+        std::printf("  %9zu titulos | dynamic_cast %7.1f ms | TipoContenido %7.1f ms | x%.1f\n",
+                    titulos, msRtti / repeticiones, msEtiqueta / repeticiones, msRtti / msEtiqueta);
+    }
+}
+
+void BenchArenaCatalogo(const OpcionesBench& opciones) {
+    const std::string nombreArchivo = "bench_arena.txt";
+    const int repeticiones = 3;
+    for (size_t titulos : TamanosCatalogo(opciones)) {
+        GenerarCatalogo(nombreArchivo, titulos);
+        ArchivoMapeado archivo(nombreArchivo);
+
+        // Parseo más destrucción: con el heap cada objeto, cadena y bloque de episodios se
+        // reserva y libera por separado; con la arena se libera todo de una vez
+        double msHeapParseo = 0.0, msHeapLiberar = 0.0;
+        double msArenaParseo = 0.0, msArenaLiberar = 0.0;
+        size_t videosHeap = 0, videosArena = 0;
+        for (int r = 0; r < repeticiones; ++r) {
+            {
+                std::vector<PtrVideo> videos;
+                ReporteCarga reporte;
+                ParserCatalogo parser(reporte, std::pmr::new_delete_resource());
+                Cronometro parseo;
+                parser.ParsearTexto(archivo.GetContenido(), videos);
+                msHeapParseo += parseo.Milisegundos();
+                videosHeap = videos.size();
+                Cronometro liberar;
+                videos.clear();
+                videos.shrink_to_fit();
+                msHeapLiberar += liberar.Milisegundos();
+            }
+            {
+                auto arena = std::make_unique<std::pmr::monotonic_buffer_resource>(ServicioStreaming::kBloqueInicialArena);
+                std::vector<PtrVideo> videos;
+                ReporteCarga reporte;
+                ParserCatalogo parser(reporte, arena.get());
+                Cronometro parseo;
+                parser.ParsearTexto(archivo.GetContenido(), videos);
+                msArenaParseo += parseo.Milisegundos();
+                videosArena = videos.size();
+                Cronometro liberar;
+                videos.clear();
+                videos.shrink_to_fit();
+                arena.reset();
+                msArenaLiberar += liberar.Milisegundos();
+            }
+        }
+        if (videosHeap != videosArena) {
+            std::printf("  ERROR: resultados distintos (%zu vs %zu)\n", videosHeap, videosArena);
+        }
+        std::printf("  %8zu titulos | heap: parseo %7.1f ms, liberar %6.1f ms | arena: parseo %7.1f ms, liberar %6.1f ms\n",
+                    titulos, msHeapParseo / repeticiones, msHeapLiberar / repeticiones,
+                    msArenaParseo / repeticiones, msArenaLiberar / repeticiones);
+    }
+    std::remove(nombreArchivo.c_str());
+}
+
+void BenchRecargaEnCaliente(const OpcionesBench& opciones) {
+    const std::string nombreArchivo = "bench_catalogo.txt";
+    const std::string nombreSnapshot = "bench_catalogo.snap";
+    std::vector<size_t> tamanos = {100000};
+    if (opciones.grande) {
+        tamanos.push_back(1000000);
+    }
+
+    std::printf("  Consultas de un hilo lector mientras otro recarga el catalogo en bucle (%u nucleos)\n",
+                std::thread::hardware_concurrency());
+    for (size_t titulos : tamanos) {
+        GenerarCatalogo(nombreArchivo, titulos);
+        SilenciarSalida silencio;
+        ServicioStreaming servicio;
+        servicio.CargarArchivo(nombreArchivo, ModoCarga::Mapeado);
+        servicio.GuardarSnapshot(nombreSnapshot);
+
+        // Sin recarga, con recargas desde texto y con recargas desde snapshot
+        const char* escenarios[] = {"sin recarga", "recarga texto", "recarga snapshot"};
+        for (int escenario = 0; escenario < 3; ++escenario) {
+            const int recargas = 5;
+            std::atomic<bool> activo{true};
+            std::vector<double> latencias;
+            std::thread lector([&]() {
+                size_t i = 0;
+                while (activo.load()) {
+                    Cronometro consulta;
+                    std::shared_ptr<const Catalogo> catalogo = servicio.GetCatalogo();
+                    size_t encontrados = catalogo->BuscarVideos(4.0, "Drama").size();
+                    // Las líneas pares del catálogo generado son películas
+                    encontrados += catalogo->BuscarPosicion("Pelicula " + std::to_string(i * 2 % titulos)) != Catalogo::kNoEncontrado;
+                    latencias.push_back(consulta.Milisegundos());
+                    if (encontrados == 0) {
+                        std::printf("  (consulta sin resultados)\n");
+                    }
+                    ++i;
+                }
+            });
+            Cronometro cronometro;
+            for (int r = 0; r < recargas; ++r) {
+                if (escenario == 1) {
+                    servicio.CargarArchivo(nombreArchivo, ModoCarga::Mapeado);
+                } else if (escenario == 2) {
+                    servicio.CargarArchivo(nombreSnapshot, ModoCarga::Snapshot);
+                } else {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                }
+            }
+            const double ms = cronometro.Milisegundos();
+            activo = false;
+            lector.join();
+
+            std::sort(latencias.begin(), latencias.end());
+            auto percentil = [&](double p) {
+                return latencias.empty() ? 0.0 : latencias[static_cast<size_t>(p * (latencias.size() - 1))];
+            };
+            std::printf("  %8zu titulos | %-16s | %5.0f ms/recarga | %7.0f consultas/s | p50 %6.3f ms | p99 %7.3f ms | max %7.3f ms\n",
+                        titulos, escenarios[escenario], escenario == 0 ? 0.0 : ms / recargas,
+                        latencias.size() / (ms / 1000.0), percentil(0.5), percentil(0.99), percentil(1.0));
+        }
+    }
+    std::remove(nombreArchivo.c_str());
+    std::remove(nombreSnapshot.c_str());
+}
+
+void BenchTopK(const OpcionesBench& opciones) {
+    const std::string nombreArchivo = "bench_catalogo.txt";
+    const size_t k = 100;
+    const int repeticiones = 200;
+    std::printf("  Top-%zu: tablas de posiciones frente a recorrer el catalogo con partial_sort\n", k);
+    for (size_t titulos : TamanosCatalogo(opciones)) {
+        GenerarCatalogo(nombreArchivo, titulos);
+        SilenciarSalida silencio;
+        ServicioStreaming servicio;
+        servicio.CargarArchivo(nombreArchivo, ModoCarga::Mapeado);
+        // Calificaciones repartidas para que los promedios no empaten en bloque
+        std::vector<EventoCalificacion> eventos;
+        std::vector<std::string> nombres(titulos);
+        for (size_t i = 0; i < titulos; ++i) {
+            nombres[i] = (i % 2 == 0 ? "Pelicula " : "Serie ") + std::to_string(i);
+            eventos.push_back({nombres[i], static_cast<int>(1 + (i * 7) % 5)});
+        }
+        servicio.CalificarLote(eventos);
+
+        auto medir = [&](auto&& consulta) {
+            size_t total = 0;
+            Cronometro cronometro;
+            for (int r = 0; r < repeticiones; ++r) {
+                total += consulta();
+            }
+            const double us = cronometro.Milisegundos() * 1000.0 / repeticiones;
+            return std::make_pair(us, total);
+        };
+        auto ordenarParcial = [&](std::vector<const Video*> candidatos) {
+            const size_t n = std::min(k, candidatos.size());
+            std::partial_sort(candidatos.begin(), candidatos.begin() + n, candidatos.end(),
+                              [](const Video* a, const Video* b) {
+                                  return a->GetCalificacionPromedio() > b->GetCalificacionPromedio();
+                              });
+            return n;
+        };
+
+        auto [tablaTodos, r1] = medir([&]() { return servicio.TopK(k).size(); });
+        auto [escaneoTodos, r2] = medir([&]() { return ordenarParcial(servicio.BuscarVideos(0.0, "")); });
+        auto [tablaGenero, r3] = medir([&]() { return servicio.TopK(k, "Drama").size(); });
+        auto [escaneoGenero, r4] = medir([&]() { return ordenarParcial(servicio.BuscarVideos(0.0, "Drama")); });
+        auto [episodios, r5] = medir([&]() { return servicio.TopK(k, "", TipoRanking::Episodios).size(); });
+        if (r1 != r2 || r3 != r4 || r5 == 0) {
+            std::printf("  (resultados distintos)\n");
+        }
+        std::printf("  %8zu titulos | todos: tabla %8.1f us, escaneo %9.1f us | genero: tabla %8.1f us, escaneo %9.1f us | episodios (monticulo) %9.1f us\n",
+                    titulos, tablaTodos, escaneoTodos, tablaGenero, escaneoGenero, episodios);
+
+        // Costo de mantener las tablas: calificar de a un video
+        Cronometro cronometro;
+        for (size_t i = 0; i < eventos.size(); ++i) {
+            eventos[i].calificacion = static_cast<int>(1 + (i * 3) % 5);
+        }
+        servicio.CalificarLote(eventos);
+        std::printf("  %8zu titulos | recalificar todo el catalogo %.1f ms\n", titulos, cronometro.Milisegundos());
+    }
+    std::remove(nombreArchivo.c_str());
+}
+
+void BenchBusquedaTitulos(const OpcionesBench& opciones) {
+    // Títulos de 1 a 4 palabras de 1 a 3 sílabas (ataque + vocal + coda), con una
+    // distribución de trigramas parecida a la de títulos reales
+    static const char* ataques[] = {"", "b", "c", "d", "f", "g", "l", "m", "n", "p",
+                                    "r", "s", "t", "v", "br", "tr", "st", "pl", "ch", "gr"};
+    static const char* vocales[] = {"a", "e", "i", "o", "u", "ai", "ea", "ou"};
+    static const char* codas[] = {"", "n", "r", "s", "l", "st", "nd", "m"};
+    std::mt19937_64 aleatorio(42);
+    auto palabra = [&]() {
+        std::string resultado;
+        for (size_t s = 0, silabas = 1 + aleatorio() % 3; s < silabas; ++s) {
+            resultado += ataques[aleatorio() % 20];
+            resultado += vocales[aleatorio() % 8];
+            resultado += codas[aleatorio() % 8];
+        }
+        return resultado;
+    };
+    std::vector<size_t> tamanos = {100000};
+    if (opciones.grande) {
+        tamanos.push_back(1000000);
+    }
+    const size_t consultas = 500;
+    std::printf("  Prefijo y busqueda aproximada (un error de tipeo) frente a recorrer todos los titulos\n");
+    for (size_t titulos : tamanos) {
+        std::vector<PtrVideo> videos;
+        videos.reserve(titulos);
+        for (size_t i = 0; i < titulos; ++i) {
+            std::string titulo = palabra();
+            for (size_t w = 1, palabras = 1 + aleatorio() % 4; w < palabras; ++w) {
+                titulo += ' ' + palabra();
+            }
+            titulo[0] = static_cast<char>(std::toupper(static_cast<unsigned char>(titulo[0])));
+            videos.push_back(std::make_unique<Pelicula>("P" + std::to_string(i), titulo, 90, "Drama"));
+        }
+
+        BuscadorTitulos buscador;
+        Cronometro cronometroConstruccion;
+        buscador.Reconstruir(videos);
+        const double msConstruccion = cronometroConstruccion.Milisegundos();
+
+        std::vector<std::string> prefijos, conErrores;
+        for (size_t q = 0; q < consultas; ++q) {
+            std::string titulo(videos[(q * 7919) % titulos]->GetNombre());
+            prefijos.push_back(titulo.substr(0, 5));
+            // Intercambia dos letras: un error de tipeo típico
+            if (titulo.size() > 4) {
+                std::swap(titulo[2], titulo[3]);
+            }
+            conErrores.push_back(titulo);
+        }
+
+        size_t encontrados = 0;
+        Cronometro cronometroPrefijo;
+        for (const auto& prefijo : prefijos) {
+            encontrados += buscador.BuscarPrefijo(prefijo, 10).size();
+        }
+        const double usPrefijo = cronometroPrefijo.Milisegundos() * 1000.0 / consultas;
+        Cronometro cronometroAproximado;
+        for (const auto& texto : conErrores) {
+            encontrados += buscador.BuscarAproximado(texto, 10).size();
+        }
+        const double usAproximado = cronometroAproximado.Milisegundos() * 1000.0 / consultas;
+
+        // Alternativa sin índice: normalizar y comparar cada título (solo unas pocas consultas)
+        const size_t consultasLineales = 20;
+        std::string normalizado, buscado;
+        Cronometro cronometroLineal;
+        for (size_t q = 0; q < consultasLineales; ++q) {
+            BuscadorTitulos::Normalizar(prefijos[q], buscado);
+            for (const auto& video : videos) {
+                BuscadorTitulos::Normalizar(video->GetNombre(), normalizado);
+                encontrados += normalizado.compare(0, buscado.size(), buscado) == 0;
+            }
+        }
+        const double usLineal = cronometroLineal.Milisegundos() * 1000.0 / consultasLineales;
+
+        std::printf("  %8zu titulos | construccion %7.1f ms | prefijo %7.2f us | aproximado %8.1f us | recorrido lineal %9.1f us | %zu\n",
+                    titulos, msConstruccion, usPrefijo, usAproximado, usLineal, encontrados);
+    }
+}
+
+void BenchIndiceTextual(const OpcionesBench& opciones) {
+    const std::string nombreArchivo = "bench_catalogo.txt";
+    const int repeticiones = 50;
+    // Una consulta amplia, una con NOT, una con OR y una selectiva (palabra rara AND palabra frecuente)
+    const char* consultas[] = {"drama AND pelicula", "misterio AND episodio NOT 2",
+                               "(drama OR crimen) AND NOT pelicula", "episodio AND 777"};
+    std::printf("  Consultas booleanas sobre listas comprimidas frente a recorrer todos los documentos\n");
+    for (size_t titulos : TamanosCatalogo(opciones)) {
+        GenerarCatalogo(nombreArchivo, titulos);
+        SilenciarSalida silencio;
+        ServicioStreaming servicio;
+        servicio.CargarArchivo(nombreArchivo, ModoCarga::Mapeado);
+        auto catalogo = servicio.GetCatalogo();
+
+        // Costo que el índice agrega a la carga: los mismos Agregar* que hace Catalogo::Indexar
+        IndiceTextual indice;
+        Cronometro cronometroConstruccion;
+        for (const auto& video : catalogo->GetVideos()) {
+            indice.AgregarVideo(*video);
+            if (const Serie* serie = ComoSerie(*video)) {
+                for (const auto& episodio : serie->GetEpisodios()) {
+                    indice.AgregarEpisodio(*serie, episodio);
+                }
+            }
+        }
+        const double msConstruccion = cronometroConstruccion.Milisegundos();
+        std::printf("  %8zu titulos | %zu documentos, %zu palabras | construccion %.1f ms | listas %.2f MB\n",
+                    titulos, indice.GetDocumentos(), indice.GetPalabras(), msConstruccion,
+                    indice.GetBytesListas() / (1024.0 * 1024.0));
+
+        for (const char* consulta : consultas) {
+            size_t encontrados = 0;
+            Cronometro cronometro;
+            for (int r = 0; r < repeticiones; ++r) {
+                encontrados = servicio.BuscarTexto(consulta).size();
+            }
+            std::printf("  %8zu titulos | %-36s %9.1f us | %zu documentos\n",
+                        titulos, consulta, cronometro.Milisegundos() * 1000.0 / repeticiones, encontrados);
+        }
+
+        // Alternativa sin índice para la primera consulta: normalizar título y género de cada documento
+        std::string normalizado;
+        size_t encontrados = 0;
+        Cronometro cronometroLineal;
+        for (const auto& video : catalogo->GetVideos()) {
+            BuscadorTitulos::Normalizar(std::string(video->GetNombre()) + " " + std::string(video->GetGenero()), normalizado);
+            normalizado = " " + normalizado + " ";
+            encontrados += normalizado.find(" drama ") != std::string::npos && normalizado.find(" pelicula ") != std::string::npos;
+            if (const Serie* serie = ComoSerie(*video)) {
+                for (const auto& episodio : serie->GetEpisodios()) {
+                    BuscadorTitulos::Normalizar(std::string(episodio.GetTitulo()) + " " + std::string(video->GetGenero()), normalizado);
+                    normalizado = " " + normalizado + " ";
+                    encontrados += normalizado.find(" drama ") != std::string::npos && normalizado.find(" pelicula ") != std::string::npos;
+                }
+            }
+        }
+        std::printf("  %8zu titulos | %-36s %9.1f us | %zu documentos (recorrido lineal)\n",
+                    titulos, consultas[0], cronometroLineal.Milisegundos() * 1000.0, encontrados);
+    }
+    std::remove(nombreArchivo.c_str());
+}
+
+// Pico de memoria residente del proceso en KB (VmHWM), o 0 si el sistema no lo informa
+size_t MemoriaPicoKb() {
+    return ReporteCarga::LeerMemoriaPicoKb();
+}
+
+// Lleva el pico de memoria al uso actual (Linux: escribir 5 en clear_refs)
+void ReiniciarMemoriaPico() {
+    std::ofstream("/proc/self/clear_refs") << "5";
+}
+
+void BenchFiltroFlujo(const OpcionesBench& opciones) {
+    const std::string nombreArchivo = "bench_catalogo.txt";
+    std::printf("  Filtro (Drama, calificacion >= 3) en una pasada con memoria acotada frente a cargar y consultar\n");
+    for (size_t titulos : TamanosCatalogo(opciones)) {
+        GenerarCatalogo(nombreArchivo, titulos);
+        SilenciarSalida silencio;
+        CriterioFlujo criterio;
+        criterio.genero = "Drama";
+        criterio.calificacionMinima = 3.0;
+
+        size_t coincidenciasFlujo = 0;
+        ReiniciarMemoriaPico();
+        const size_t baseFlujo = MemoriaPicoKb();
+        Cronometro cronometroFlujo;
+        {
+            ServicioStreaming servicio;
+            servicio.FiltrarArchivo(nombreArchivo, criterio, [&](const Video&) { ++coincidenciasFlujo; });
+        }
+        const double msFlujo = cronometroFlujo.Milisegundos();
+        const size_t kbFlujo = MemoriaPicoKb() - baseFlujo;
+
+        size_t coincidenciasCarga = 0;
+        ReiniciarMemoriaPico();
+        const size_t baseCarga = MemoriaPicoKb();
+        Cronometro cronometroCarga;
+        {
+            ServicioStreaming servicio;
+            servicio.CargarArchivo(nombreArchivo, ModoCarga::Mapeado);
+            coincidenciasCarga = servicio.BuscarVideos(3.0, "Drama").size();
+        }
+        const double msCarga = cronometroCarga.Milisegundos();
+        const size_t kbCarga = MemoriaPicoKb() - baseCarga;
+
+        std::printf("  %8zu titulos | flujo %8.1f ms, pico +%7zu KB | cargar y consultar %8.1f ms, pico +%8zu KB | %zu/%zu\n",
+                    titulos, msFlujo, kbFlujo, msCarga, kbCarga, coincidenciasFlujo, coincidenciasCarga);
+    }
+    std::remove(nombreArchivo.c_str());
+}
+
+void BenchFasesCarga(const OpcionesBench& opciones) {
+    const std::string nombreArchivo = "bench_catalogo.txt";
+    const std::string nombreSnapshot = "bench_catalogo.snap";
+    std::printf("  Milisegundos por fase (los indices, desglosados en tablas/buscador/columnas/calificaciones)\n");
+    for (size_t titulos : TamanosCatalogo(opciones)) {
+        GenerarCatalogo(nombreArchivo, titulos);
+        SilenciarSalida silencio;
+        ServicioStreaming servicio;
+        servicio.CargarArchivo(nombreArchivo, ModoCarga::Mapeado);
+        servicio.GuardarSnapshot(nombreSnapshot);
+        for (ModoCarga modo : {ModoCarga::Flujo, ModoCarga::Mapeado, ModoCarga::Paralelo, ModoCarga::Snapshot}) {
+            const ReporteCarga r = servicio.CargarArchivo(modo == ModoCarga::Snapshot ? nombreSnapshot : nombreArchivo, modo);
+            const TiemposIndexado& i = r.tiempos.indices;
+            std::printf("  %8zu titulos | %-8s | lectura %7.1f | parseo %7.1f (series %7.1f) | indices %7.1f "
+                        "(%.1f/%.1f/%.1f/%.1f) | publicacion %6.1f | total %7.1f | %6.1f MB, %9.0f lineas/s | pico %zu MB\n",
+                        titulos, r.modo.c_str(), r.tiempos.lectura, r.tiempos.parseo, r.tiempos.parseoSeries,
+                        i.Total(), i.tablas, i.buscador, i.columnas, i.calificaciones,
+                        r.tiempos.publicacion, r.tiempos.total, r.bytes / 1e6, r.GetLineasPorSegundo(),
+                        r.memoriaPicoKb / 1024);
+        }
+    }
+    std::remove(nombreArchivo.c_str());
+    std::remove(nombreSnapshot.c_str());
+}
+
+/**
+ * @brief Genera un catálogo con datos sucios: calificaciones separadas por ';' y muchas inválidas.
+ * @param nombreArchivo Ruta del archivo a generar.
+ * @param titulos Número de líneas (películas y series alternadas).
+ */
+void GenerarCatalogoSucio(const std::string& nombreArchivo, size_t titulos) {
+    std::ofstream archivo(nombreArchivo);
+    for (size_t i = 0; i < titulos; ++i) {
+        if (i % 2 == 0) {
+            // Tres válidas, dos inválidas y una fuera de rango por película
+            archivo << "Pelicula,P" << i << ",Pelicula " << i << ',' << 80 + i % 90 << ".0,Drama,"
+                    << 1 + i % 5 << ";n/a;" << 1 + (i / 5) % 5 << ";?;9;" << 1 + (i / 25) % 5 << '\n';
+        } else {
+            archivo << "Serie,S" << i << ",Serie " << i << ",sin dato,Comedia," << 1 + i % 5 << "-x;";
+            for (size_t e = 0; e < 4; ++e) {
+                if (e > 0) {
+                    archivo << '|';
+                }
+                archivo << "Episodio " << i << '.' << e << ':' << (e == 3 ? "T" : "1") << ':'
+                        << 1 + (i + e) % 5 << "-nd";
+            }
+            archivo << '\n';
+        }
+    }
+}
+
+void BenchCargaSucia(const OpcionesBench& opciones) {
+    const std::string nombreArchivo = "bench_catalogo_sucio.txt";
+    for (size_t titulos : TamanosCatalogo(opciones)) {
+        GenerarCatalogoSucio(nombreArchivo, titulos);
+        double msFlujo = 0.0, msMapeado = 0.0;
+        ReporteCarga flujo, mapeado;
+        {
+            SilenciarSalida silencio;
+            ServicioStreaming servicio;
+            Cronometro cronometro;
+            flujo = servicio.CargarArchivo(nombreArchivo, ModoCarga::Flujo);
+            msFlujo = cronometro.Milisegundos();
+        }
+        {
+            SilenciarSalida silencio;
+            ServicioStreaming servicio;
+            Cronometro cronometro;
+            mapeado = servicio.CargarArchivo(nombreArchivo, ModoCarga::Mapeado);
+            msMapeado = cronometro.Milisegundos();
+        }
+        if (flujo.GetTotalErrores() != mapeado.GetTotalErrores() || flujo.calificaciones != mapeado.calificaciones) {
+            std::printf("  ERROR: reportes distintos\n");
+        }
+        std::printf("  %9zu titulos | flujo %9.1f ms | mapeado %9.1f ms | %zu calificaciones, %zu errores (%zu muestras)\n",
+                    titulos, msFlujo, msMapeado, flujo.calificaciones, flujo.GetTotalErrores(), flujo.GetMuestras().size());
+    }
+    std::remove(nombreArchivo.c_str());
+}
+
+struct Benchmark {
+    const char* nombre;
+    void (*funcion)(const OpcionesBench&);
+};
+
+const Benchmark kBenchmarks[] = {
+    {"carga_archivo", BenchCargaArchivo},
+    {"carga_paralela", BenchCargaParalela},
+    {"carga_sucia", BenchCargaSucia},
+    {"fases_carga", BenchFasesCarga},
+    {"indice_calificaciones", BenchIndiceCalificaciones},
+    {"indice_titulos", BenchIndiceTitulos},
+    {"calificar_lote", BenchCalificarLote},
+    {"calificacion_concurrente", BenchCalificacionConcurrente},
+    {"exportar_catalogo", BenchExportarCatalogo},
+    {"snapshot", BenchSnapshot},
+    {"escaneo_columnar", BenchEscaneoColumnar},
+    {"filtro_vectorial", BenchFiltroVectorial},
+    {"despacho_tipo", BenchDespachoTipo},
+    {"arena_catalogo", BenchArenaCatalogo},
+    {"recarga_en_caliente", BenchRecargaEnCaliente},
+    {"top_k", BenchTopK},
+    {"busqueda_titulos", BenchBusquedaTitulos},
+    {"indice_textual", BenchIndiceTextual},
+    {"filtro_flujo", BenchFiltroFlujo},
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    OpcionesBench opciones;
+    std::string filtro;
+    for (int i = 1; i < argc; ++i) {
+        std::string argumento = argv[i];
+        if (argumento == "--grande") {
+            opciones.grande = true;
+        } else {
+            filtro = argumento;
+        }
+    }
+
+    for (const auto& benchmark : kBenchmarks) {
+        if (!filtro.empty() && std::string(benchmark.nombre).find(filtro) == std::string::npos) {
+            continue;
+        }
+        std::printf("[%s]\n", benchmark.nombre);
+        benchmark.funcion(opciones);
+    }
+    return 0;
+}
@@ -0,0 +1,81 @@
+/**
+ * @file buffersalida.cpp
+ * @brief Implementación de la clase BufferSalida.
+ * @author Tu Nombre
+ * @date 2025-06-15
+ */
+
+#include "buffersalida.h"
+#include <charconv>
+
+namespace {
+// Suficiente para cualquier entero de 64 bits o un double con formato fijo razonable
+constexpr std::size_t kMaxNumero = 64;
+}
+
+BufferSalida::BufferSalida(std::ostream& destino, std::size_t tamanoBloque)
+    : destino(destino), tamanoBloque(tamanoBloque == 0 ? 1 : tamanoBloque) {
+    buffer.reserve(this->tamanoBloque + kMaxNumero);
+}
+
+BufferSalida::~BufferSalida() {
+    Vaciar();
+}
+
+void BufferSalida::AsegurarEspacio() {
+    if (buffer.size() >= tamanoBloque) {
+        Vaciar();
+    }
+}
+
+BufferSalida& BufferSalida::Agregar(std::string_view texto) {
+    buffer.append(texto.data(), texto.size());
+    AsegurarEspacio();
+    return *this;
+}
+
+BufferSalida& BufferSalida::Agregar(char caracter) {
+    buffer.push_back(caracter);
+    AsegurarEspacio();
+    return *this;
+}
+
+BufferSalida& BufferSalida::AgregarEntero(long long valor) {
+    char numero[kMaxNumero];
+    auto resultado = std::to_chars(numero, numero + kMaxNumero, valor);
+    return Agregar(std::string_view(numero, static_cast<std::size_t>(resultado.ptr - numero)));
+}
+
+BufferSalida& BufferSalida::AgregarDecimal(double valor, int decimales) {
+    char numero[kMaxNumero];
+    auto resultado = std::to_chars(numero, numero + kMaxNumero, valor, std::chars_format::fixed, decimales);
+    if (resultado.ec != std::errc()) { // Valores enormes: se recurre al formato científico
+        resultado = std::to_chars(numero, numero + kMaxNumero, valor);
+    }
+    return Agregar(std::string_view(numero, static_cast<std::size_t>(resultado.ptr - numero)));
+}
+
+BufferSalida& BufferSalida::AgregarDecimal(double valor) {
+    char numero[kMaxNumero];
+    auto resultado = std::to_chars(numero, numero + kMaxNumero, valor);
+    return Agregar(std::string_view(numero, static_cast<std::size_t>(resultado.ptr - numero)));
+}
+
+void BufferSalida::Vaciar() {
+    if (buffer.empty()) {
+        return;
+    }
+    destino.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    destino.flush();
+    ++bloquesEscritos;
+    bytesEscritos += buffer.size();
+    buffer.clear();
+}
+
+std::size_t BufferSalida::GetBloquesEscritos() const {
+    return bloquesEscritos;
+}
+
+std::size_t BufferSalida::GetBytesEscritos() const {
+    return bytesEscritos;
+}
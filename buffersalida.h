@@ -0,0 +1,87 @@
+#ifndef BUFFERSALIDA_H
+#define BUFFERSALIDA_H
+
+/**
+ * @file buffersalida.h
+ * @brief Declaración de la clase BufferSalida.
+ * @author Tu Nombre
+ * @date 2025-06-15
+ */
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+/**
+ * @class BufferSalida
+ * @brief Acumula texto en un búfer propio y lo escribe en bloques grandes.
+ *
+ * Sustituye a escribir línea por línea con std::endl (que fuerza un vaciado por
+ * línea): el texto se formatea en memoria, los números se convierten con
+ * std::to_chars y el destino solo recibe una escritura por bloque. El búfer se
+ * vacía al llenarse, al llamar a Vaciar() y al destruirse.
+ */
+class BufferSalida {
+private:
+    std::ostream& destino;
+    std::string buffer;
+    std::size_t tamanoBloque;
+    std::size_t bloquesEscritos = 0;
+    std::size_t bytesEscritos = 0;
+
+    void AsegurarEspacio();
+
+public:
+    /** @brief Tamaño de bloque por defecto (64 KiB). */
+    static constexpr std::size_t kTamanoBloque = 64 * 1024;
+
+    /**
+     * @brief Constructor de la clase BufferSalida.
+     * @param destino El flujo donde se escriben los bloques.
+     * @param tamanoBloque Bytes acumulados antes de escribir un bloque.
+     */
+    explicit BufferSalida(std::ostream& destino, std::size_t tamanoBloque = kTamanoBloque);
+
+    /**
+     * @brief Escribe lo pendiente en el destino.
+     */
+    ~BufferSalida();
+
+    BufferSalida(const BufferSalida&) = delete;
+    BufferSalida& operator=(const BufferSalida&) = delete;
+
+    /** @brief Agrega texto. @param texto El texto. @return El propio búfer, para encadenar llamadas. */
+    BufferSalida& Agregar(std::string_view texto);
+    /** @brief Agrega un carácter. @param caracter El carácter. @return El propio búfer. */
+    BufferSalida& Agregar(char caracter);
+    /** @brief Agrega un entero en base 10. @param valor El entero. @return El propio búfer. */
+    BufferSalida& AgregarEntero(long long valor);
+
+    /**
+     * @brief Agrega un número con una cantidad fija de decimales (como std::fixed).
+     * @param valor El número.
+     * @param decimales El número de decimales.
+     * @return El propio búfer.
+     */
+    BufferSalida& AgregarDecimal(double valor, int decimales);
+
+    /**
+     * @brief Agrega un número con la representación más corta que lo identifica (ej. 169, 22.5).
+     * @param valor El número.
+     * @return El propio búfer.
+     */
+    BufferSalida& AgregarDecimal(double valor);
+
+    /**
+     * @brief Escribe en el destino todo lo acumulado.
+     */
+    void Vaciar();
+
+    /** @brief Obtiene cuántas escrituras se hicieron en el destino. @return El número de bloques. */
+    std::size_t GetBloquesEscritos() const;
+    /** @brief Obtiene cuántos bytes se escribieron en el destino. @return El número de bytes. */
+    std::size_t GetBytesEscritos() const;
+};
+
+#endif // BUFFERSALIDA_H
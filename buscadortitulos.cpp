@@ -0,0 +1,384 @@
+/**
+ * @file buscadortitulos.cpp
+ * @brief Implementación de la clase BuscadorTitulos.
+ * @author Tu Nombre
+ * @date 2025-06-15
+ */
+
+#include "buscadortitulos.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Símbolos de los trigramas: espacio, a-z, 0-9 y cuatro grupos para los bytes no ASCII
+constexpr std::uint32_t kSimbolos = 1 + 26 + 10 + 4;
+constexpr std::uint32_t kCodigosTrigrama = kSimbolos * kSimbolos * kSimbolos;
+
+std::uint32_t Simbolo(unsigned char c) {
+    if (c >= 'a' && c <= 'z') {
+        return 1 + (c - 'a');
+    }
+    if (c >= '0' && c <= '9') {
+        return 27 + (c - '0');
+    }
+    if (c >= 0x80) {
+        return 37 + (c & 3);
+    }
+    return 0;
+}
+
+bool EsParteDePalabra(unsigned char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c >= 0x80;
+}
+
+bool EmpiezaCon(std::string_view texto, std::string_view prefijo) {
+    return texto.substr(0, prefijo.size()) == prefijo;
+}
+
+// Primeros 8 bytes del texto como entero (big-endian, completado con ceros): comparar dos
+// claves equivale a comparar esos bytes, y el texto normalizado nunca contiene '\0'
+std::uint64_t Prefijo8(std::string_view texto) {
+    std::uint64_t clave = 0;
+    for (std::size_t i = 0; i < 8; ++i) {
+        clave = (clave << 8) | (i < texto.size() ? static_cast<unsigned char>(texto[i]) : 0u);
+    }
+    return clave;
+}
+
+// Elemento a ordenar: la clave resuelve casi todas las comparaciones sin leer el búfer de textos
+template <typename Valor>
+struct ConPrefijo {
+    std::uint64_t prefijo;
+    Valor valor;
+};
+
+// Ordena por texto y, a igual texto, por posición en el catálogo
+template <typename Valor, typename Texto, typename Posicion>
+void OrdenarPorTexto(std::vector<Valor>& valores, Texto texto, Posicion posicion) {
+    std::vector<ConPrefijo<Valor>> claves;
+    claves.reserve(valores.size());
+    for (const auto& valor : valores) {
+        claves.push_back({Prefijo8(texto(valor)), valor});
+    }
+    std::sort(claves.begin(), claves.end(), [&](const ConPrefijo<Valor>& a, const ConPrefijo<Valor>& b) {
+        if (a.prefijo != b.prefijo) {
+            return a.prefijo < b.prefijo;
+        }
+        const std::string_view restoA = texto(a.valor).substr(std::min<std::size_t>(8, texto(a.valor).size()));
+        const std::string_view restoB = texto(b.valor).substr(std::min<std::size_t>(8, texto(b.valor).size()));
+        return restoA != restoB ? restoA < restoB : posicion(a.valor) < posicion(b.valor);
+    });
+    for (std::size_t i = 0; i < claves.size(); ++i) {
+        valores[i] = claves[i].valor;
+    }
+}
+
+} // namespace
+
+void BuscadorTitulos::Normalizar(std::string_view texto, std::string& destino) {
+    destino.clear();
+    bool separador = false;
+    for (char c : texto) {
+        const unsigned char u = static_cast<unsigned char>(c);
+        if (!EsParteDePalabra(u)) {
+            separador = !destino.empty();
+            continue;
+        }
+        if (separador) {
+            destino += ' ';
+            separador = false;
+        }
+        destino += (u >= 'A' && u <= 'Z') ? static_cast<char>(u - 'A' + 'a') : c;
+    }
+    if (separador) {
+        destino += ' '; // Un espacio final indica que la última palabra está completa
+    }
+}
+
+void BuscadorTitulos::Trigramas(std::string_view normalizado, std::vector<std::uint32_t>& codigos) {
+    codigos.clear();
+    if (!normalizado.empty() && normalizado.back() == ' ') {
+        normalizado.remove_suffix(1);
+    }
+    if (normalizado.empty()) {
+        return;
+    }
+    // El texto se rodea de espacios para que el comienzo y el final de las palabras cuenten
+    std::uint32_t anterior = 0;
+    std::uint32_t actual = 0;
+    auto agregar = [&](std::uint32_t simbolo) {
+        codigos.push_back((anterior * kSimbolos + actual) * kSimbolos + simbolo);
+        anterior = actual;
+        actual = simbolo;
+    };
+    actual = Simbolo(static_cast<unsigned char>(normalizado[0]));
+    for (std::size_t i = 1; i < normalizado.size(); ++i) {
+        agregar(Simbolo(static_cast<unsigned char>(normalizado[i])));
+    }
+    agregar(0);
+}
+
+std::string_view BuscadorTitulos::Titulo(std::uint32_t titulo) const {
+    return std::string_view(textos).substr(inicios[titulo], inicios[titulo + 1] - inicios[titulo]);
+}
+
+std::string_view BuscadorTitulos::Sufijo(const EntradaPalabra& palabra) const {
+    return std::string_view(textos).substr(palabra.inicio, inicios[palabra.titulo + 1] - palabra.inicio);
+}
+
+void BuscadorTitulos::Reconstruir(const std::vector<PtrVideo>& videos) {
+    textos.clear();
+    inicios.assign(1, 0);
+    ordenPalabras.clear();
+    std::string normalizado;
+    for (std::size_t i = 0; i < videos.size(); ++i) {
+        Normalizar(videos[i]->GetNombre(), normalizado);
+        if (!normalizado.empty() && normalizado.back() == ' ') {
+            normalizado.pop_back();
+        }
+        for (std::size_t j = 1; j < normalizado.size(); ++j) {
+            if (normalizado[j - 1] == ' ') {
+                ordenPalabras.push_back({textos.size() + j, static_cast<std::uint32_t>(i)});
+            }
+        }
+        textos += normalizado;
+        inicios.push_back(textos.size());
+    }
+
+    // Prefijos: orden alfabético y, a igual texto, orden del catálogo
+    ordenTitulos.resize(videos.size());
+    for (std::size_t i = 0; i < videos.size(); ++i) {
+        ordenTitulos[i] = static_cast<std::uint32_t>(i);
+    }
+    OrdenarPorTexto(ordenTitulos, [this](std::uint32_t titulo) { return Titulo(titulo); },
+                    [](std::uint32_t titulo) { return titulo; });
+    OrdenarPorTexto(ordenPalabras, [this](const EntradaPalabra& palabra) { return Sufijo(palabra); },
+                    [](const EntradaPalabra& palabra) { return palabra.titulo; });
+
+    // Trigramas en dos pasadas: contar y después llenar. Como los títulos se recorren en
+    // orden, cada lista queda ordenada por posición sin ordenarla aparte. Un trigrama repetido
+    // en un título se cuenta una vez: ultimoTitulo recuerda el último título que lo agregó
+    comienzosTrigrama.assign(kCodigosTrigrama + 1, 0);
+    trigramasPorTitulo.resize(videos.size());
+    std::vector<std::uint32_t> codigos;
+    std::vector<std::uint32_t> ultimoTitulo(kCodigosTrigrama, UINT32_MAX);
+    for (std::size_t i = 0; i < videos.size(); ++i) {
+        Trigramas(Titulo(static_cast<std::uint32_t>(i)), codigos);
+        std::size_t distintos = 0;
+        for (std::uint32_t codigo : codigos) {
+            if (ultimoTitulo[codigo] != i) {
+                ultimoTitulo[codigo] = static_cast<std::uint32_t>(i);
+                ++comienzosTrigrama[codigo + 1];
+                ++distintos;
+            }
+        }
+        trigramasPorTitulo[i] = static_cast<std::uint16_t>(std::min<std::size_t>(distintos, UINT16_MAX));
+    }
+    for (std::uint32_t codigo = 0; codigo < kCodigosTrigrama; ++codigo) {
+        comienzosTrigrama[codigo + 1] += comienzosTrigrama[codigo];
+    }
+    posicionesTrigrama.resize(comienzosTrigrama.back());
+    std::vector<std::uint64_t> cursores(comienzosTrigrama.begin(), comienzosTrigrama.end() - 1);
+    std::fill(ultimoTitulo.begin(), ultimoTitulo.end(), UINT32_MAX);
+    for (std::size_t i = 0; i < videos.size(); ++i) {
+        Trigramas(Titulo(static_cast<std::uint32_t>(i)), codigos);
+        for (std::uint32_t codigo : codigos) {
+            if (ultimoTitulo[codigo] != i) {
+                ultimoTitulo[codigo] = static_cast<std::uint32_t>(i);
+                posicionesTrigrama[cursores[codigo]++] = static_cast<std::uint32_t>(i);
+            }
+        }
+    }
+}
+
+std::vector<CoincidenciaTitulo> BuscadorTitulos::BuscarPrefijo(std::string_view prefijo, std::size_t limite) const {
+    std::vector<CoincidenciaTitulo> resultado;
+    std::string normalizado;
+    Normalizar(prefijo, normalizado);
+    if (normalizado.empty() || limite == 0) {
+        return resultado;
+    }
+    const std::string_view buscado = normalizado;
+    auto agregar = [&](std::uint32_t titulo) {
+        for (const auto& coincidencia : resultado) {
+            if (coincidencia.posicion == titulo) {
+                return; // Un título con varias palabras que empiezan igual aparece una sola vez
+            }
+        }
+        const std::size_t longitud = inicios[titulo + 1] - inicios[titulo];
+        resultado.push_back({titulo, std::min(1.0, static_cast<double>(buscado.size()) / static_cast<double>(longitud))});
+    };
+
+    auto titulo = std::lower_bound(ordenTitulos.begin(), ordenTitulos.end(), buscado,
+                                   [this](std::uint32_t a, std::string_view b) { return Titulo(a) < b; });
+    for (; titulo != ordenTitulos.end() && resultado.size() < limite && EmpiezaCon(Titulo(*titulo), buscado); ++titulo) {
+        agregar(*titulo);
+    }
+    auto palabra = std::lower_bound(ordenPalabras.begin(), ordenPalabras.end(), buscado,
+                                    [this](const EntradaPalabra& a, std::string_view b) { return Sufijo(a) < b; });
+    for (; palabra != ordenPalabras.end() && resultado.size() < limite && EmpiezaCon(Sufijo(*palabra), buscado); ++palabra) {
+        agregar(palabra->titulo);
+    }
+    return resultado;
+}
+
+std::vector<CoincidenciaTitulo> BuscadorTitulos::BuscarAproximado(std::string_view texto, std::size_t limite) const {
+    std::vector<CoincidenciaTitulo> resultado;
+    std::string normalizado;
+    Normalizar(texto, normalizado);
+    std::vector<std::uint32_t> codigos;
+    Trigramas(normalizado, codigos);
+    std::sort(codigos.begin(), codigos.end());
+    codigos.erase(std::unique(codigos.begin(), codigos.end()), codigos.end());
+    if (codigos.empty() || limite == 0 || inicios.size() <= 1) {
+        return resultado;
+    }
+
+    // Listas de los trigramas de la consulta, de la más corta a la más larga
+    struct Lista {
+        const std::uint32_t* actual;
+        const std::uint32_t* fin;
+    };
+    std::vector<Lista> listas;
+    for (std::uint32_t codigo : codigos) {
+        listas.push_back({posicionesTrigrama.data() + comienzosTrigrama[codigo],
+                          posicionesTrigrama.data() + comienzosTrigrama[codigo + 1]});
+    }
+    std::sort(listas.begin(), listas.end(), [](const Lista& a, const Lista& b) {
+        return a.fin - a.actual < b.fin - b.actual;
+    });
+
+    // Un título con al menos 'minimo' trigramas en común aparece en alguna de las
+    // listas.size() - minimo + 1 listas más cortas: solo esas se recorren completas,
+    // mezcladas con un montículo para obtener los candidatos en orden de posición
+    const std::size_t total = listas.size();
+    const std::size_t minimo = MinimoComunes(total);
+    const std::size_t recorridas = total - minimo + 1;
+    auto posterior = [](const Lista& a, const Lista& b) { return *a.actual > *b.actual; };
+    std::vector<Lista> monticulo;
+    for (std::size_t i = 0; i < recorridas; ++i) {
+        if (listas[i].actual != listas[i].fin) {
+            monticulo.push_back(listas[i]);
+        }
+    }
+    std::make_heap(monticulo.begin(), monticulo.end(), posterior);
+
+    while (!monticulo.empty()) {
+        const std::uint32_t titulo = *monticulo.front().actual;
+        std::size_t comunes = 0;
+        while (!monticulo.empty() && *monticulo.front().actual == titulo) {
+            ++comunes;
+            std::pop_heap(monticulo.begin(), monticulo.end(), posterior);
+            if (++monticulo.back().actual == monticulo.back().fin) {
+                monticulo.pop_back();
+            } else {
+                std::push_heap(monticulo.begin(), monticulo.end(), posterior);
+            }
+        }
+        // Las listas largas se verifican con búsqueda exponencial desde la última posición:
+        // los candidatos llegan en orden, así que sus cursores solo avanzan
+        for (std::size_t j = recorridas; j < total && comunes + (total - j) >= minimo; ++j) {
+            Lista& lista = listas[j];
+            std::size_t salto = 1;
+            const std::uint32_t* desde = lista.actual;
+            while (desde + salto < lista.fin && desde[salto] < titulo) {
+                desde += salto;
+                salto *= 2;
+            }
+            lista.actual = std::lower_bound(desde, std::min(desde + salto + 1, lista.fin), titulo);
+            comunes += lista.actual != lista.fin && *lista.actual == titulo;
+        }
+        if (comunes >= minimo) {
+            // Coeficiente de Dice entre los trigramas de la consulta y los del título
+            const double similitud = 2.0 * static_cast<double>(comunes) / static_cast<double>(total + trigramasPorTitulo[titulo]);
+            resultado.push_back({titulo, similitud});
+        }
+    }
+
+    const std::size_t cantidad = std::min(limite, resultado.size());
+    std::partial_sort(resultado.begin(), resultado.begin() + cantidad, resultado.end(),
+                      [](const CoincidenciaTitulo& a, const CoincidenciaTitulo& b) {
+                          return a.puntaje > b.puntaje || (a.puntaje == b.puntaje && a.posicion < b.posicion);
+                      });
+    resultado.resize(cantidad);
+    return resultado;
+}
+
+std::size_t BuscadorTitulos::MinimoComunes(std::size_t trigramas) {
+    // Cada error de tipeo cambia como mucho tres trigramas de la consulta. Se exigen ambos
+    // umbrales, así que el mínimo es el mayor de los dos
+    const std::size_t porErrores = trigramas > 3 * kErroresMaximos ? trigramas - 3 * kErroresMaximos : 0;
+    const std::size_t porFraccion = static_cast<std::size_t>(std::ceil(static_cast<double>(trigramas) * kFraccionMinima));
+    return std::max<std::size_t>({1, porErrores, porFraccion});
+}
+
+std::size_t BuscadorTitulos::GetTamano() const {
+    return inicios.empty() ? 0 : inicios.size() - 1;
+}
+
+void BuscadorTitulos::Guardar(EscritorSnapshot& salida) const {
+    // Las entradas de palabras tienen relleno: cada campo va en su propio arreglo
+    std::vector<std::uint64_t> iniciosPalabra(ordenPalabras.size());
+    std::vector<std::uint32_t> titulosPalabra(ordenPalabras.size());
+    for (std::size_t i = 0; i < ordenPalabras.size(); ++i) {
+        iniciosPalabra[i] = ordenPalabras[i].inicio;
+        titulosPalabra[i] = ordenPalabras[i].titulo;
+    }
+    salida.EscribirArreglo(textos);
+    salida.EscribirArreglo(inicios);
+    salida.EscribirArreglo(ordenTitulos);
+    salida.EscribirArreglo(iniciosPalabra);
+    salida.EscribirArreglo(titulosPalabra);
+    salida.EscribirArreglo(comienzosTrigrama);
+    salida.EscribirArreglo(posicionesTrigrama);
+    salida.EscribirArreglo(trigramasPorTitulo);
+}
+
+bool BuscadorTitulos::Restaurar(LectorSnapshot& entrada, std::size_t titulos) {
+    std::string nuevosTextos;
+    std::vector<std::uint64_t> nuevosInicios;
+    std::vector<std::uint32_t> nuevoOrdenTitulos;
+    std::vector<std::uint64_t> iniciosPalabra;
+    std::vector<std::uint32_t> titulosPalabra;
+    std::vector<std::uint64_t> nuevosComienzos;
+    std::vector<std::uint32_t> nuevasPosiciones;
+    std::vector<std::uint16_t> nuevosPorTitulo;
+    if (!entrada.LeerArreglo(nuevosTextos) || !entrada.LeerArreglo(nuevosInicios) ||
+        !entrada.LeerArreglo(nuevoOrdenTitulos) || !entrada.LeerArreglo(iniciosPalabra) ||
+        !entrada.LeerArreglo(titulosPalabra) || !entrada.LeerArreglo(nuevosComienzos) ||
+        !entrada.LeerArreglo(nuevasPosiciones) || !entrada.LeerArreglo(nuevosPorTitulo)) {
+        return false;
+    }
+    if (nuevosInicios.size() != titulos + 1 || nuevoOrdenTitulos.size() != titulos ||
+        nuevosPorTitulo.size() != titulos || titulosPalabra.size() != iniciosPalabra.size() ||
+        nuevosComienzos.size() != kCodigosTrigrama + 1) {
+        return false;
+    }
+    // Desplazamientos crecientes que terminan justo al final de lo que indexan
+    auto crecientes = [](const std::vector<std::uint64_t>& valores, std::uint64_t final) {
+        return valores.front() == 0 && valores.back() == final && std::is_sorted(valores.begin(), valores.end());
+    };
+    auto esTitulo = [titulos](std::uint32_t titulo) { return titulo < titulos; };
+    if (!crecientes(nuevosInicios, nuevosTextos.size()) || !crecientes(nuevosComienzos, nuevasPosiciones.size()) ||
+        !std::all_of(nuevoOrdenTitulos.begin(), nuevoOrdenTitulos.end(), esTitulo) ||
+        !std::all_of(nuevasPosiciones.begin(), nuevasPosiciones.end(), esTitulo)) {
+        return false;
+    }
+    std::vector<EntradaPalabra> nuevoOrdenPalabras(iniciosPalabra.size());
+    for (std::size_t i = 0; i < iniciosPalabra.size(); ++i) {
+        const std::uint32_t titulo = titulosPalabra[i];
+        if (!esTitulo(titulo) || iniciosPalabra[i] < nuevosInicios[titulo] || iniciosPalabra[i] > nuevosInicios[titulo + 1]) {
+            return false;
+        }
+        nuevoOrdenPalabras[i] = {iniciosPalabra[i], titulo};
+    }
+    textos = std::move(nuevosTextos);
+    inicios = std::move(nuevosInicios);
+    ordenTitulos = std::move(nuevoOrdenTitulos);
+    ordenPalabras = std::move(nuevoOrdenPalabras);
+    comienzosTrigrama = std::move(nuevosComienzos);
+    posicionesTrigrama = std::move(nuevasPosiciones);
+    trigramasPorTitulo = std::move(nuevosPorTitulo);
+    return true;
+}
@@ -0,0 +1,130 @@
+#ifndef BUSCADORTITULOS_H
+#define BUSCADORTITULOS_H
+
+/**
+ * @file buscadortitulos.h
+ * @brief Declaración de la clase BuscadorTitulos.
+ * @author Tu Nombre
+ * @date 2025-06-15
+ */
+
+#include "video.h"
+#include "seccionsnapshot.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @struct CoincidenciaTitulo
+ * @brief Un resultado de BuscadorTitulos.
+ */
+struct CoincidenciaTitulo {
+    std::size_t posicion; ///< Posición del video en el catálogo.
+    double puntaje;       ///< Entre 0 y 1: fracción del título escrita (prefijo) o similitud de trigramas (aproximada).
+};
+
+/**
+ * @class BuscadorTitulos
+ * @brief Búsqueda de títulos por prefijo y aproximada (tolerante a errores de tipeo).
+ *
+ * Los títulos se normalizan (minúsculas ASCII, signos de puntuación como espacios)
+ * y se guardan en un único búfer. Para la búsqueda por prefijo hay dos arreglos
+ * ordenados de posiciones en ese búfer: el comienzo de cada título y el comienzo
+ * de cada una de sus demás palabras, así que "bad" también encuentra "Breaking Bad".
+ *
+ * La búsqueda aproximada usa un índice invertido de trigramas. Las letras fuera de
+ * a-z y 0-9 se agrupan en pocos símbolos, de modo que todos los trigramas posibles
+ * caben en una tabla directa y las listas de posiciones quedan contiguas en un solo
+ * arreglo, ordenadas por posición. Una consulta solo recorre sus listas más cortas
+ * y verifica las más largas con búsqueda binaria.
+ */
+class BuscadorTitulos {
+public:
+    /** @brief Fracción mínima de los trigramas de la consulta que debe tener un título aproximado. */
+    static constexpr double kFraccionMinima = 0.5;
+    /** @brief Errores de tipeo (letras cambiadas, agregadas o faltantes) tolerados por la búsqueda aproximada. */
+    static constexpr std::size_t kErroresMaximos = 2;
+
+    /**
+     * @brief Reconstruye el buscador a partir del catálogo completo.
+     * @param videos El catálogo; la posición de cada video es su identificador.
+     */
+    void Reconstruir(const std::vector<PtrVideo>& videos);
+
+    /**
+     * @brief Busca los títulos que empiezan con un texto, o que tienen una palabra que empieza con él.
+     *
+     * Primero van los títulos que empiezan con el texto y después los que lo tienen
+     * al comienzo de otra palabra; cada grupo, en orden alfabético.
+     * @param prefijo El texto (no sensible a mayúsculas/minúsculas ni a signos de puntuación).
+     * @param limite El número máximo de resultados.
+     * @return Las coincidencias, sin posiciones repetidas.
+     */
+    std::vector<CoincidenciaTitulo> BuscarPrefijo(std::string_view prefijo, std::size_t limite) const;
+
+    /**
+     * @brief Busca los títulos parecidos a un texto.
+     * @param texto El texto, posiblemente con errores.
+     * @param limite El número máximo de resultados.
+     * @return Las coincidencias de mayor a menor similitud; a igual similitud, en el orden del catálogo.
+     */
+    std::vector<CoincidenciaTitulo> BuscarAproximado(std::string_view texto, std::size_t limite) const;
+
+    /** @brief Obtiene el número de títulos indexados. @return El tamaño del buscador. */
+    std::size_t GetTamano() const;
+
+    /** @brief Escribe el buscador tal como está en memoria. @param salida El escritor de la sección. */
+    void Guardar(EscritorSnapshot& salida) const;
+
+    /**
+     * @brief Reemplaza el contenido con un buscador escrito por Guardar.
+     *
+     * Verifica que los desplazamientos queden dentro de los textos y que cada
+     * posición sea un título; si algo no cuadra, el buscador no cambia.
+     * @param entrada El lector de la sección.
+     * @param titulos El número de videos del catálogo.
+     * @return true si el buscador se restauró y tiene exactamente titulos títulos.
+     */
+    bool Restaurar(LectorSnapshot& entrada, std::size_t titulos);
+
+    /**
+     * @brief Normaliza un texto como lo hace el buscador.
+     * @param texto El texto.
+     * @param destino Recibe el texto en minúsculas, con cada secuencia de signos y espacios
+     *        reducida a un espacio y sin espacios al comienzo.
+     */
+    static void Normalizar(std::string_view texto, std::string& destino);
+
+    /**
+     * @brief Calcula cuántos trigramas de la consulta debe tener un título aproximado.
+     *
+     * Un título a kErroresMaximos errores de la consulta conserva al menos
+     * trigramas - 3 * kErroresMaximos de ellos, y además debe tener kFraccionMinima
+     * de ellos: se exigen los dos umbrales, no uno u otro.
+     * @param trigramas El número de trigramas distintos de la consulta.
+     * @return El mínimo de trigramas en común.
+     */
+    static std::size_t MinimoComunes(std::size_t trigramas);
+
+private:
+    struct EntradaPalabra {
+        std::uint64_t inicio;  // Posición de la palabra en textos
+        std::uint32_t titulo;  // Posición del video en el catálogo
+    };
+
+    std::string textos;                       // Títulos normalizados, uno tras otro
+    std::vector<std::uint64_t> inicios;       // Comienzo de cada título en textos (y el final del último)
+    std::vector<std::uint32_t> ordenTitulos;  // Títulos ordenados alfabéticamente
+    std::vector<EntradaPalabra> ordenPalabras; // Palabras (salvo la primera) ordenadas alfabéticamente
+    std::vector<std::uint64_t> comienzosTrigrama; // Por trigrama, comienzo de su lista en posicionesTrigrama
+    std::vector<std::uint32_t> posicionesTrigrama;
+    std::vector<std::uint16_t> trigramasPorTitulo; // Trigramas distintos de cada título
+
+    std::string_view Titulo(std::uint32_t titulo) const;
+    std::string_view Sufijo(const EntradaPalabra& palabra) const;
+    static void Trigramas(std::string_view normalizado, std::vector<std::uint32_t>& codigos); // Con repetidos
+};
+
+#endif // BUSCADORTITULOS_H
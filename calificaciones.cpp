@@ -0,0 +1,117 @@
+/**
+ * @file calificaciones.cpp
+ * @brief Implementación de la clase AgregadoCalificaciones.
+ * @author Tu Nombre
+ * @date 2025-06-15
+ */
+
+#include "calificaciones.h"
+#include <cmath>
+
+AgregadoCalificaciones::AgregadoCalificaciones(const AgregadoCalificaciones& otro) {
+    *this = otro;
+}
+
+AgregadoCalificaciones& AgregadoCalificaciones::operator=(const AgregadoCalificaciones& otro) {
+    if (this != &otro) {
+        conteoYSuma.store(otro.conteoYSuma.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        for (std::size_t i = 0; i < histograma.size(); ++i) {
+            histograma[i].store(otro.histograma[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+    }
+    return *this;
+}
+
+bool AgregadoCalificaciones::Agregar(int calificacion) {
+    return Agregar(calificacion, 1);
+}
+
+bool AgregadoCalificaciones::Agregar(int calificacion, std::uint64_t veces) {
+    if (calificacion < kMinima || calificacion > kMaxima) {
+        return false;
+    }
+    Frecuencias frecuencias{};
+    frecuencias[calificacion - kMinima] = veces;
+    return Agregar(frecuencias);
+}
+
+bool AgregadoCalificaciones::Agregar(const Frecuencias& frecuencias) {
+    std::uint64_t veces = 0;
+    std::uint64_t suma = 0;
+    for (std::size_t i = 0; i < frecuencias.size(); ++i) {
+        if (frecuencias[i] > kConteoMaximo - veces) {
+            return false;
+        }
+        veces += frecuencias[i];
+        suma += frecuencias[i] * (kMinima + i);
+    }
+    if (veces == 0) {
+        return true;
+    }
+    // Conteo y suma de todo el grupo cambian juntos en un solo compare-exchange; con
+    // kConteoMaximo la suma (como mucho 5 * kConteoMaximo) cabe en los 34 bits altos
+    std::uint64_t actual = conteoYSuma.load(std::memory_order_relaxed);
+    std::uint64_t nuevo = 0;
+    do {
+        const std::uint64_t conteo = actual & kMascaraConteo;
+        if (veces > kConteoMaximo - conteo) {
+            return false;
+        }
+        nuevo = actual + (suma << kBitsConteo) + veces;
+    } while (!conteoYSuma.compare_exchange_weak(actual, nuevo, std::memory_order_relaxed));
+    for (std::size_t i = 0; i < frecuencias.size(); ++i) {
+        if (frecuencias[i] != 0) {
+            histograma[i].fetch_add(frecuencias[i], std::memory_order_relaxed);
+        }
+    }
+    return true;
+}
+
+std::uint64_t AgregadoCalificaciones::GetConteo() const {
+    return conteoYSuma.load(std::memory_order_relaxed) & kMascaraConteo;
+}
+
+std::uint64_t AgregadoCalificaciones::GetSuma() const {
+    return conteoYSuma.load(std::memory_order_relaxed) >> kBitsConteo;
+}
+
+double AgregadoCalificaciones::GetPromedio() const {
+    // Una sola lectura: el conteo y la suma son siempre del mismo instante
+    const std::uint64_t valor = conteoYSuma.load(std::memory_order_relaxed);
+    const std::uint64_t conteo = valor & kMascaraConteo;
+    if (conteo == 0) {
+        return 0.0;
+    }
+    return static_cast<double>(valor >> kBitsConteo) / conteo;
+}
+
+std::uint64_t AgregadoCalificaciones::GetFrecuencia(int calificacion) const {
+    if (calificacion < kMinima || calificacion > kMaxima) {
+        return 0;
+    }
+    return histograma[calificacion - kMinima].load(std::memory_order_relaxed);
+}
+
+int AgregadoCalificaciones::GetPercentil(double percentil) const {
+    // Se trabaja sobre una copia del histograma para que el rango y las frecuencias coincidan
+    std::array<std::uint64_t, kMaxima> frecuencias{};
+    std::uint64_t conteo = 0;
+    for (std::size_t i = 0; i < frecuencias.size(); ++i) {
+        frecuencias[i] = histograma[i].load(std::memory_order_relaxed);
+        conteo += frecuencias[i];
+    }
+    if (conteo == 0) {
+        return 0;
+    }
+    // Rango más cercano: la menor calificación cuya frecuencia acumulada alcanza el rango
+    double rango = std::ceil(percentil / 100.0 * static_cast<double>(conteo));
+    std::uint64_t objetivo = rango < 1.0 ? 1 : static_cast<std::uint64_t>(rango);
+    std::uint64_t acumulado = 0;
+    for (int calificacion = kMinima; calificacion <= kMaxima; ++calificacion) {
+        acumulado += frecuencias[calificacion - kMinima];
+        if (acumulado >= objetivo) {
+            return calificacion;
+        }
+    }
+    return kMaxima;
+}
@@ -0,0 +1,101 @@
+#ifndef CALIFICACIONES_H
+#define CALIFICACIONES_H
+
+/**
+ * @file calificaciones.h
+ * @brief Declaración de la clase AgregadoCalificaciones.
+ * @author Tu Nombre
+ * @date 2025-06-15
+ */
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @class AgregadoCalificaciones
+ * @brief Resumen incremental de las calificaciones (1-5) de un video o episodio.
+ *
+ * En lugar de guardar cada calificación, mantiene el conteo, la suma y un
+ * histograma de cinco posiciones. Ocupa memoria constante sin importar cuántas
+ * calificaciones reciba, y el promedio, el histograma y los percentiles se
+ * obtienen en O(1).
+ *
+ * Es seguro entre hilos sin bloqueos: el conteo (30 bits bajos) y la suma (34
+ * bits altos) comparten un único entero atómico que se actualiza con
+ * compare-exchange, así que un lector siempre obtiene un par conteo/suma (y un
+ * promedio) que existió realmente. Cada posición del histograma es un atómico
+ * aparte; mientras haya escritores, el histograma puede ir una calificación por
+ * detrás del conteo.
+ */
+class AgregadoCalificaciones {
+public:
+    static constexpr int kMinima = 1;
+    static constexpr int kMaxima = 5;
+    /** @brief Máximo de calificaciones que admite un agregado (2^30 - 1). */
+    static constexpr std::uint64_t kConteoMaximo = (std::uint64_t{1} << 30) - 1;
+    /** @brief Cuántas veces se registra cada calificación (la posición 0 es la 1). */
+    using Frecuencias = std::array<std::uint64_t, kMaxima>;
+
+    AgregadoCalificaciones() = default;
+    /** @brief Copia una instantánea del agregado. @param otro El agregado a copiar. */
+    AgregadoCalificaciones(const AgregadoCalificaciones& otro);
+    /** @brief Reemplaza el contenido con una instantánea de otro agregado. @param otro El agregado a copiar. @return Este agregado. */
+    AgregadoCalificaciones& operator=(const AgregadoCalificaciones& otro);
+
+    /**
+     * @brief Registra una calificación.
+     * @param calificacion Un entero entre 1 y 5. Calificaciones fuera de este rango son ignoradas.
+     * @return true si la calificación fue registrada (false si está fuera de rango o el agregado está lleno).
+     */
+    bool Agregar(int calificacion);
+
+    /**
+     * @brief Registra varias veces la misma calificación de una sola vez.
+     * @param calificacion Un entero entre 1 y 5. Calificaciones fuera de este rango son ignoradas.
+     * @param veces Cuántas veces se registra.
+     * @return true si la calificación fue registrada; false si está fuera de rango o si el
+     *         conteo superaría kConteoMaximo (en ese caso no se registra ninguna).
+     */
+    bool Agregar(int calificacion, std::uint64_t veces);
+
+    /**
+     * @brief Registra de una sola vez un grupo de calificaciones distintas.
+     * @param frecuencias Cuántas veces se registra cada calificación.
+     * @return true si el grupo fue registrado; false si el conteo superaría kConteoMaximo
+     *         (en ese caso no se registra ninguna calificación del grupo).
+     */
+    bool Agregar(const Frecuencias& frecuencias);
+
+    /** @brief Obtiene el número de calificaciones registradas. @return El conteo. */
+    std::uint64_t GetConteo() const;
+    /** @brief Obtiene la suma de las calificaciones registradas. @return La suma. */
+    std::uint64_t GetSuma() const;
+    /** @brief Calcula el promedio de las calificaciones. @return El promedio (0.0 si no hay calificaciones). */
+    double GetPromedio() const;
+
+    /**
+     * @brief Obtiene cuántas veces se registró una calificación.
+     * @param calificacion Un entero entre 1 y 5.
+     * @return La frecuencia (0 si la calificación está fuera de rango).
+     */
+    std::uint64_t GetFrecuencia(int calificacion) const;
+
+    /**
+     * @brief Obtiene el percentil indicado usando el método del rango más cercano.
+     * @param percentil Un valor entre 0 y 100 (50 es la mediana).
+     * @return La calificación del percentil (0 si no hay calificaciones).
+     */
+    int GetPercentil(double percentil) const;
+
+private:
+    static constexpr unsigned kBitsConteo = 30;
+    static constexpr std::uint64_t kMascaraConteo = kConteoMaximo;
+
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "AgregadoCalificaciones requiere atómicos de 64 bits sin bloqueo");
+
+    std::atomic<std::uint64_t> conteoYSuma{0}; // (suma << kBitsConteo) | conteo
+    std::array<std::atomic<std::uint64_t>, kMaxima> histograma{};
+};
+
+#endif // CALIFICACIONES_H
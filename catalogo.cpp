@@ -0,0 +1,509 @@
+/**
+ * @file catalogo.cpp
+ * @brief Implementación de la clase Catalogo.
+ * @author Tu Nombre
+ * @date 2025-06-15
+ */
+
+#include "catalogo.h"
+#include <algorithm>
+#include <charconv>
+#include <mutex>
+#include <unordered_map>
+
+Catalogo::Catalogo(bool indiceGlobalEpisodios)
+    : indiceGlobalEpisodios(indiceGlobalEpisodios) {}
+
+Catalogo::~Catalogo() {
+    // Primero se destruyen los videos y después se libera su memoria, arena por arena
+    videos.clear();
+    arenas.clear();
+}
+
+std::pmr::memory_resource* Catalogo::NuevaArena() {
+    arenas.push_back(std::make_unique<std::pmr::monotonic_buffer_resource>(kBloqueInicialArena));
+    return arenas.back().get();
+}
+
+std::pmr::memory_resource* Catalogo::GetArena() {
+    return arenas.empty() ? NuevaArena() : arenas.back().get();
+}
+
+std::vector<PtrVideo>& Catalogo::GetVideosMutables() {
+    return videos;
+}
+
+TiemposIndexado Catalogo::Indexar() {
+    using Reloj = ReporteCarga::Reloj;
+    TiemposIndexado tiempos;
+    Reloj::time_point inicio = Reloj::now();
+    auto etapa = [&](double& milisegundos) {
+        const Reloj::time_point fin = Reloj::now();
+        milisegundos = ReporteCarga::Milisegundos(fin - inicio);
+        inicio = fin;
+    };
+
+    videosPorTituloLower.Limpiar();
+    episodiosPorTituloLower.Limpiar();
+    episodiosPorClave.Limpiar();
+    videosPorTituloLower.Reservar(videos.size());
+    // Contar los episodios antes evita que sus índices se redimensionen durante la carga
+    std::size_t totalEpisodios = 0;
+    for (const auto& video : videos) {
+        if (const Serie* serie = ComoSerie(*video)) {
+            totalEpisodios += serie->GetEpisodios().size();
+        }
+    }
+    if (indiceGlobalEpisodios) {
+        episodiosPorTituloLower.Reservar(totalEpisodios);
+    }
+    episodiosPorClave.Reservar(totalEpisodios);
+    generos.Limpiar();
+    videosPorGenero.clear();
+    indiceTextual.Limpiar();
+
+    for (std::size_t i = 0; i < videos.size(); ++i) {
+        videosPorTituloLower.Insertar(videos[i]->GetNombre(), i);
+        std::uint32_t generoId = generos.Registrar(videos[i]->GetGenero());
+        videos[i]->SetGeneroId(generoId);
+        if (generoId == videosPorGenero.size()) {
+            videosPorGenero.emplace_back();
+        }
+        videosPorGenero[generoId].push_back(i);
+        indiceTextual.AgregarVideo(*videos[i]);
+        if (Serie* serie = ComoSerie(*videos[i])) {
+            for (auto& episodio : serie->GetEpisodiosMutables()) {
+                IndexarEpisodio(*serie, episodio);
+            }
+        }
+    }
+    etapa(tiempos.tablas);
+    buscadorTitulos.Reconstruir(videos);
+    etapa(tiempos.buscador);
+    columnas.Reconstruir(videos);
+    etapa(tiempos.columnas);
+    indiceCalificaciones.Reconstruir(videos);
+    etapa(tiempos.calificaciones);
+    return tiempos;
+}
+
+void Catalogo::GuardarIndices(EscritorSnapshot& salida) const {
+    // Los índices guardan punteros; en el archivo van como posiciones
+    std::unordered_map<const Video*, std::uint64_t> posicionVideo;
+    std::unordered_map<const Episodio*, std::uint64_t> numeroEpisodio;
+    posicionVideo.reserve(videos.size());
+    for (std::size_t i = 0; i < videos.size(); ++i) {
+        posicionVideo.emplace(videos[i].get(), i);
+        if (const Serie* serie = ComoSerie(*videos[i])) {
+            for (const auto& episodio : serie->GetEpisodios()) {
+                numeroEpisodio.emplace(&episodio, numeroEpisodio.size());
+            }
+        }
+    }
+    auto comoNumero = [&numeroEpisodio](const Episodio* episodio) { return numeroEpisodio.at(episodio); };
+
+    salida.Escribir(static_cast<std::uint8_t>(indiceGlobalEpisodios));
+    salida.Escribir(static_cast<std::uint64_t>(videos.size()));
+    salida.Escribir(static_cast<std::uint64_t>(numeroEpisodio.size()));
+    videosPorTituloLower.Guardar(salida, [](std::size_t posicion) { return static_cast<std::uint64_t>(posicion); });
+    if (indiceGlobalEpisodios) {
+        episodiosPorTituloLower.Guardar(salida, comoNumero);
+    }
+    episodiosPorClave.Guardar(salida, comoNumero);
+
+    // Géneros: los nombres en orden de identificador y el de cada video (sus listas de videos
+    // se reconstruyen al restaurar, así que no pueden contradecir a los identificadores)
+    salida.Escribir(static_cast<std::uint64_t>(generos.GetTamano()));
+    for (std::uint32_t id = 0; id < generos.GetTamano(); ++id) {
+        salida.EscribirArreglo(generos.GetNombre(id));
+    }
+    std::vector<std::uint32_t> generoIds(videos.size());
+    for (std::size_t i = 0; i < videos.size(); ++i) {
+        generoIds[i] = videos[i]->GetGeneroId();
+    }
+    salida.EscribirArreglo(generoIds);
+
+    // Documentos del índice textual: los videos por su posición y los episodios a continuación
+    const std::vector<ResultadoTexto>& documentos = indiceTextual.GetListaDocumentos();
+    std::vector<std::uint64_t> numerosDocumento(documentos.size());
+    for (std::size_t i = 0; i < documentos.size(); ++i) {
+        numerosDocumento[i] = documentos[i].episodio != nullptr ? videos.size() + comoNumero(documentos[i].episodio)
+                                                                : posicionVideo.at(documentos[i].video);
+    }
+    salida.EscribirArreglo(numerosDocumento);
+    indiceTextual.Guardar(salida);
+    buscadorTitulos.Guardar(salida);
+}
+
+bool Catalogo::RestaurarIndices(std::string_view seccion, TiemposIndexado& tiempos) {
+    using Reloj = ReporteCarga::Reloj;
+    Reloj::time_point inicio = Reloj::now();
+    auto etapa = [&](double& milisegundos) {
+        const Reloj::time_point fin = Reloj::now();
+        milisegundos = ReporteCarga::Milisegundos(fin - inicio);
+        inicio = fin;
+    };
+
+    std::vector<Episodio*> episodios;
+    std::vector<const Video*> serieDeEpisodio;
+    for (const auto& video : videos) {
+        if (Serie* serie = ComoSerie(*video)) {
+            for (auto& episodio : serie->GetEpisodiosMutables()) {
+                episodios.push_back(&episodio);
+                serieDeEpisodio.push_back(serie);
+            }
+        }
+    }
+    LectorSnapshot entrada(seccion);
+    std::uint8_t conIndiceGlobal = 0;
+    std::uint64_t totalVideos = 0;
+    std::uint64_t totalEpisodios = 0;
+    if (!entrada.Leer(conIndiceGlobal) || !entrada.Leer(totalVideos) || !entrada.Leer(totalEpisodios) ||
+        (conIndiceGlobal != 0) != indiceGlobalEpisodios || totalVideos != videos.size() ||
+        totalEpisodios != episodios.size()) {
+        return false;
+    }
+    auto aVideo = [this](std::uint64_t guardada, std::size_t& posicion) {
+        posicion = static_cast<std::size_t>(guardada);
+        return guardada < videos.size();
+    };
+    auto aEpisodio = [&episodios](std::uint64_t numero, Episodio*& episodio) {
+        if (numero >= episodios.size()) {
+            return false;
+        }
+        episodio = episodios[numero];
+        return true;
+    };
+    if (!videosPorTituloLower.Restaurar<std::uint64_t>(entrada, aVideo) ||
+        (indiceGlobalEpisodios && !episodiosPorTituloLower.Restaurar<std::uint64_t>(entrada, aEpisodio)) ||
+        !episodiosPorClave.Restaurar<std::uint64_t>(entrada, aEpisodio)) {
+        return false;
+    }
+
+    // Registrar los nombres en el mismo orden reproduce los identificadores
+    std::uint64_t totalGeneros = 0;
+    if (!entrada.Leer(totalGeneros)) {
+        return false;
+    }
+    generos.Limpiar();
+    std::string nombre;
+    for (std::uint64_t id = 0; id < totalGeneros; ++id) {
+        if (!entrada.LeerArreglo(nombre) || generos.Registrar(nombre) != id) {
+            return false;
+        }
+    }
+    std::vector<std::uint32_t> generoIds;
+    if (!entrada.LeerArreglo(generoIds) || generoIds.size() != videos.size()) {
+        return false;
+    }
+    videosPorGenero.assign(totalGeneros, {});
+    for (std::size_t i = 0; i < videos.size(); ++i) {
+        if (generoIds[i] >= totalGeneros) {
+            return false;
+        }
+        videos[i]->SetGeneroId(generoIds[i]);
+        videosPorGenero[generoIds[i]].push_back(i);
+    }
+
+    std::vector<std::uint64_t> numerosDocumento;
+    if (!entrada.LeerArreglo(numerosDocumento)) {
+        return false;
+    }
+    std::vector<ResultadoTexto> documentos(numerosDocumento.size());
+    for (std::size_t i = 0; i < documentos.size(); ++i) {
+        const std::uint64_t numero = numerosDocumento[i];
+        if (numero < videos.size()) {
+            documentos[i].video = videos[numero].get();
+        } else if (numero - videos.size() < episodios.size()) {
+            documentos[i] = {serieDeEpisodio[numero - videos.size()], episodios[numero - videos.size()]};
+        } else {
+            return false;
+        }
+    }
+    if (!indiceTextual.Restaurar(entrada, std::move(documentos))) {
+        return false;
+    }
+    etapa(tiempos.tablas);
+    if (!buscadorTitulos.Restaurar(entrada, videos.size()) || !entrada.Terminado()) {
+        return false;
+    }
+    etapa(tiempos.buscador);
+    columnas.Reconstruir(videos);
+    etapa(tiempos.columnas);
+    indiceCalificaciones.Reconstruir(videos);
+    etapa(tiempos.calificaciones);
+    return true;
+}
+
+void Catalogo::IndexarEpisodio(const Serie& serie, Episodio& episodio) {
+    if (indiceGlobalEpisodios) {
+        episodiosPorTituloLower.Insertar(episodio.GetTitulo(), &episodio);
+    }
+    ClaveEpisodio(bufferClave, serie.GetId(), episodio.GetTemporada(), episodio.GetTitulo());
+    episodiosPorClave.Insertar(bufferClave, &episodio);
+    indiceTextual.AgregarEpisodio(serie, episodio);
+}
+
+void Catalogo::ClaveEpisodio(std::string& clave, std::string_view serieId, int temporada, std::string_view titulo) {
+    // El separador \x1f (unit separator) no aparece en los datos del catálogo
+    char digitos[16];
+    const auto [fin, error] = std::to_chars(digitos, digitos + sizeof(digitos), temporada);
+    (void)error;
+    clave.clear();
+    clave.append(serieId);
+    clave += '\x1f';
+    clave.append(digitos, fin);
+    clave += '\x1f';
+    clave.append(titulo);
+}
+
+std::size_t Catalogo::BuscarPosicion(std::string_view titulo) const {
+    // videosPorTituloLower no cambia después de publicar el catálogo
+    const std::size_t* indice = videosPorTituloLower.Buscar(titulo);
+    return indice == nullptr ? kNoEncontrado : *indice;
+}
+
+Episodio* Catalogo::BuscarEpisodio(std::string_view titulo) const {
+    std::shared_lock<std::shared_mutex> bloqueo(mutexEstructura);
+    Episodio* const* episodio = episodiosPorTituloLower.Buscar(titulo);
+    return episodio == nullptr ? nullptr : *episodio;
+}
+
+Episodio* Catalogo::BuscarEpisodio(std::string_view serieId, int temporada, std::string_view titulo) const {
+    std::string clave; // Local: esta llamada puede ejecutarse en varios hilos a la vez
+    ClaveEpisodio(clave, serieId, temporada, titulo);
+    std::shared_lock<std::shared_mutex> bloqueo(mutexEstructura);
+    Episodio* const* episodio = episodiosPorClave.Buscar(clave);
+    return episodio == nullptr ? nullptr : *episodio;
+}
+
+void Catalogo::ActualizarIndicesDeVideo(std::size_t indice) {
+    // Ninguno de los dos toma un cerrojo global: la columna se escribe con un atómico y
+    // el índice bloquea solo la tabla del género y tipo del video. Ambos leen el agregado
+    // al escribir, así que si dos hilos califican el mismo video queda el valor más reciente
+    const Video& video = *videos[indice];
+    columnas.ActualizarCalificaciones(indice, video.GetCalificaciones());
+    indiceCalificaciones.Actualizar(indice, video.GetCalificaciones());
+}
+
+bool Catalogo::AgregarEpisodio(std::string_view tituloSerie, const Episodio& episodio) {
+    const std::size_t indice = BuscarPosicion(tituloSerie);
+    if (indice == kNoEncontrado) {
+        return false;
+    }
+    Serie* serie = ComoSerie(*videos[indice]);
+    if (serie == nullptr) {
+        return false;
+    }
+    std::unique_lock<std::shared_mutex> bloqueo(mutexEstructura);
+    IndexarEpisodio(*serie, serie->AgregarEpisodio(episodio));
+    return true;
+}
+
+void Catalogo::DesactivarIndiceGlobalEpisodios() {
+    std::unique_lock<std::shared_mutex> bloqueo(mutexEstructura);
+    indiceGlobalEpisodios = false;
+    episodiosPorTituloLower.Limpiar();
+}
+
+std::shared_lock<std::shared_mutex> Catalogo::BloquearEstructura() const {
+    return std::shared_lock<std::shared_mutex>(mutexEstructura);
+}
+
+std::vector<std::size_t> Catalogo::CandidatosPorCalificacion(double calificacionMinima) const {
+    if (calificacionMinima > 0.0) {
+        return indiceCalificaciones.BuscarDesde(calificacionMinima);
+    }
+    // Todo promedio es >= 0, así que no hace falta consultar el índice
+    std::vector<std::size_t> todos(videos.size());
+    for (std::size_t i = 0; i < todos.size(); ++i) {
+        todos[i] = i;
+    }
+    return todos;
+}
+
+std::vector<const Video*> Catalogo::BuscarVideos(double calificacionMinima, std::string_view genero) const {
+    std::vector<const Video*> resultado;
+    if (genero.empty()) {
+        // Los candidatos ya cumplen la calificación mínima
+        for (std::size_t indice : CandidatosPorCalificacion(calificacionMinima)) {
+            resultado.push_back(videos[indice].get());
+        }
+        return resultado;
+    }
+
+    std::uint32_t generoId = generos.Buscar(genero);
+    if (generoId == DiccionarioGeneros::kSinGenero) {
+        return resultado;
+    }
+    if (calificacionMinima <= 0.0) {
+        // Solo género: la lista del género ya es la respuesta
+        for (std::size_t indice : videosPorGenero[generoId]) {
+            resultado.push_back(videos[indice].get());
+        }
+        return resultado;
+    }
+    // Género y calificación: recorrido vectorial de las columnas
+    CriterioFiltro criterio;
+    criterio.calificacionMinima = calificacionMinima;
+    criterio.generoId = generoId;
+    for (std::size_t indice : columnas.Filtrar(criterio)) {
+        resultado.push_back(videos[indice].get());
+    }
+    return resultado;
+}
+
+std::vector<const Video*> Catalogo::BuscarPeliculas(double calificacionMinima) const {
+    // Tipo y calificación: recorrido vectorial de las columnas, ya en orden de catálogo
+    std::vector<const Video*> resultado;
+    CriterioFiltro criterio;
+    criterio.calificacionMinima = calificacionMinima;
+    criterio.tipo = ColumnasCatalogo::kTipoPelicula;
+    for (std::size_t indice : columnas.Filtrar(criterio)) {
+        resultado.push_back(videos[indice].get());
+    }
+    return resultado;
+}
+
+const Serie* Catalogo::BuscarSerie(std::string_view tituloSerie) const {
+    const std::size_t indice = BuscarPosicion(tituloSerie);
+    if (indice == kNoEncontrado) {
+        return nullptr;
+    }
+    return ComoSerie(*videos[indice]);
+}
+
+std::vector<const Episodio*> Catalogo::BuscarEpisodiosDeSerie(std::string_view tituloSerie, double calificacionMinima) const {
+    const Serie* serie = BuscarSerie(tituloSerie);
+    if (serie == nullptr) {
+        return {};
+    }
+    std::shared_lock<std::shared_mutex> bloqueo(mutexEstructura);
+    return serie->BuscarEpisodiosConCalificacion(calificacionMinima);
+}
+
+std::vector<const Video*> Catalogo::BuscarTitulos(std::string_view texto, std::size_t limite) const {
+    std::vector<const Video*> resultado;
+    std::vector<CoincidenciaTitulo> coincidencias = buscadorTitulos.BuscarPrefijo(texto, limite);
+    const std::size_t porPrefijo = coincidencias.size();
+    if (porPrefijo < limite) {
+        // Se completa con títulos parecidos; como mucho porPrefijo de ellos ya estaban, así que pedir limite alcanza
+        for (const auto& coincidencia : buscadorTitulos.BuscarAproximado(texto, limite)) {
+            auto repetida = std::find_if(coincidencias.begin(), coincidencias.begin() + porPrefijo,
+                                         [&](const CoincidenciaTitulo& c) { return c.posicion == coincidencia.posicion; });
+            if (repetida == coincidencias.begin() + porPrefijo) {
+                coincidencias.push_back(coincidencia);
+            }
+        }
+    }
+    coincidencias.resize(std::min(limite, coincidencias.size()));
+    for (const auto& coincidencia : coincidencias) {
+        resultado.push_back(videos[coincidencia.posicion].get());
+    }
+    return resultado;
+}
+
+std::vector<ResultadoTexto> Catalogo::BuscarTexto(std::string_view consulta) const {
+    std::shared_lock<std::shared_mutex> bloqueo(mutexEstructura);
+    return indiceTextual.Buscar(consulta);
+}
+
+std::vector<PosicionRanking> Catalogo::TopK(std::size_t k, std::string_view genero, TipoRanking tipo) const {
+    std::vector<PosicionRanking> resultado;
+    std::uint32_t generoId = ColumnasCatalogo::kCualquierGenero;
+    if (!genero.empty()) {
+        generoId = generos.Buscar(genero);
+        if (generoId == DiccionarioGeneros::kSinGenero) {
+            return resultado;
+        }
+    }
+    if (k == 0) {
+        return resultado;
+    }
+    if (tipo == TipoRanking::Episodios) {
+        return TopKEpisodios(k, generoId);
+    }
+
+    CriterioFiltro criterio;
+    criterio.generoId = generoId;
+    if (tipo == TipoRanking::Peliculas) {
+        criterio.tipo = ColumnasCatalogo::kTipoPelicula;
+    } else if (tipo == TipoRanking::Series) {
+        criterio.tipo = ColumnasCatalogo::kTipoSerie;
+    }
+    for (const auto& [promedio, indice] : indiceCalificaciones.Mejores(k, criterio)) {
+        resultado.push_back({videos[indice].get(), nullptr, promedio});
+    }
+    return resultado;
+}
+
+std::vector<PosicionRanking> Catalogo::TopKEpisodios(std::size_t k, std::uint32_t generoId) const {
+    // Los episodios no tienen índice propio: se recorren manteniendo un montículo con los
+    // k mejores vistos hasta el momento, cuya raíz es el peor de ellos
+    struct Candidato {
+        double promedio;
+        std::size_t serie;
+        std::size_t posicion;
+        const Episodio* episodio;
+    };
+    auto mejor = [](const Candidato& a, const Candidato& b) {
+        if (a.promedio != b.promedio) {
+            return a.promedio > b.promedio;
+        }
+        return a.serie != b.serie ? a.serie < b.serie : a.posicion < b.posicion;
+    };
+    std::vector<Candidato> monticulo;
+    auto considerar = [&](std::size_t indice) {
+        const Serie* serie = ComoSerie(*videos[indice]);
+        if (serie == nullptr) {
+            return;
+        }
+        std::size_t posicion = 0;
+        for (const auto& episodio : serie->GetEpisodios()) {
+            const Candidato candidato{episodio.GetCalificacionPromedio(), indice, posicion++, &episodio};
+            if (monticulo.size() < k) {
+                monticulo.push_back(candidato);
+                std::push_heap(monticulo.begin(), monticulo.end(), mejor);
+            } else if (mejor(candidato, monticulo.front())) {
+                std::pop_heap(monticulo.begin(), monticulo.end(), mejor);
+                monticulo.back() = candidato;
+                std::push_heap(monticulo.begin(), monticulo.end(), mejor);
+            }
+        }
+    };
+
+    std::shared_lock<std::shared_mutex> bloqueo(mutexEstructura);
+    if (generoId == ColumnasCatalogo::kCualquierGenero) {
+        for (std::size_t i = 0; i < videos.size(); ++i) {
+            considerar(i);
+        }
+    } else {
+        for (std::size_t indice : videosPorGenero[generoId]) {
+            considerar(indice);
+        }
+    }
+    std::sort_heap(monticulo.begin(), monticulo.end(), mejor);
+
+    std::vector<PosicionRanking> resultado;
+    resultado.reserve(monticulo.size());
+    for (const auto& candidato : monticulo) {
+        resultado.push_back({videos[candidato.serie].get(), candidato.episodio, candidato.promedio});
+    }
+    return resultado;
+}
+
+const std::vector<PtrVideo>& Catalogo::GetVideos() const {
+    return videos;
+}
+
+Video& Catalogo::GetVideo(std::size_t indice) const {
+    return *videos[indice];
+}
+
+std::size_t Catalogo::GetTamano() const {
+    return videos.size();
+}
+
+std::size_t Catalogo::GetNumeroArenas() const {
+    return arenas.size();
+}
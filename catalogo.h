@@ -0,0 +1,223 @@
+#ifndef CATALOGO_H
+#define CATALOGO_H
+
+/**
+ * @file catalogo.h
+ * @brief Declaración de la clase Catalogo.
+ * @author Tu Nombre
+ * @date 2025-06-15
+ */
+
+#include "video.h"
+#include "serie.h"
+#include "episodio.h"
+#include "indicecalificaciones.h"
+#include "diccionariogeneros.h"
+#include "indicetitulos.h"
+#include "columnascatalogo.h"
+#include "tablaposiciones.h"
+#include "buscadortitulos.h"
+#include "indicetextual.h"
+#include "reportecarga.h"
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @class Catalogo
+ * @brief Una versión completa del catálogo: videos, su memoria y todos sus índices.
+ *
+ * ServicioStreaming construye cada catálogo aparte (al cargar un archivo) y lo
+ * publica de forma atómica como std::shared_ptr; las consultas en curso siguen
+ * usando la versión que tomaron y esta se libera cuando termina la última.
+ *
+ * Una vez publicado, el conjunto de videos no cambia. Lo que sí cambia en sitio:
+ * - Las calificaciones (atómicas, ver AgregadoCalificaciones) y los índices
+ *   derivados de ellas, protegidos por un cerrojo propio que las consultas por
+ *   calificación toman en modo compartido.
+ * - Los episodios agregados con AgregarEpisodio, protegidos por el cerrojo de
+ *   estructura; quien recorra los episodios de una serie debe tomarlo con
+ *   BloquearEstructura mientras lo hace.
+ */
+class Catalogo {
+public:
+    /** @brief Valor de BuscarPosicion cuando el título no existe. */
+    static constexpr std::size_t kNoEncontrado = static_cast<std::size_t>(-1);
+    /** @brief Tamaño del primer bloque de cada arena (las siguientes reservas crecen de forma geométrica). */
+    static constexpr std::size_t kBloqueInicialArena = 256 * 1024;
+
+    /**
+     * @brief Crea un catálogo vacío.
+     * @param indiceGlobalEpisodios true para indexar los episodios por título (ver ServicioStreaming::SetIndiceGlobalEpisodios).
+     */
+    explicit Catalogo(bool indiceGlobalEpisodios = true);
+
+    Catalogo(const Catalogo&) = delete;
+    Catalogo& operator=(const Catalogo&) = delete;
+
+    /** @brief Destruye los videos y después libera sus arenas de una sola vez. */
+    ~Catalogo();
+
+    // --- Construcción (antes de publicar, desde un solo hilo) ---
+
+    /**
+     * @brief Crea una arena nueva para construir videos de este catálogo.
+     * @return La arena; vive tanto como el catálogo.
+     */
+    std::pmr::memory_resource* NuevaArena();
+
+    /** @brief Obtiene la arena actual (la crea si todavía no hay ninguna). @return La arena. */
+    std::pmr::memory_resource* GetArena();
+
+    /** @brief Obtiene los videos para agregarlos durante la carga. @return Una referencia mutable al vector. */
+    std::vector<PtrVideo>& GetVideosMutables();
+
+    /** @brief Construye todos los índices a partir de los videos cargados. @return La duración de cada etapa. */
+    TiemposIndexado Indexar();
+
+    /**
+     * @brief Restaura los índices escritos por GuardarIndices en lugar de construirlos.
+     *
+     * Las tablas por título, los géneros, el índice textual y el buscador de títulos se
+     * copian de la sección sin recalcular nada. La copia columnar y el índice de
+     * calificaciones se reconstruyen, porque dependen de calificaciones que cambian.
+     * @param seccion La sección de índices del snapshot (ver SnapshotCatalogo::SeccionIndices).
+     * @param tiempos Recibe la duración de cada etapa.
+     * @return false si la sección no corresponde a estos videos, está dañada o se guardó
+     *         con otra configuración del índice global de episodios; en ese caso los
+     *         índices quedan incompletos y hay que llamar a Indexar.
+     */
+    bool RestaurarIndices(std::string_view seccion, TiemposIndexado& tiempos);
+
+    // --- Búsquedas por título (seguras entre hilos) ---
+
+    /**
+     * @brief Busca un video por su título.
+     * @param titulo El título (no sensible a mayúsculas/minúsculas).
+     * @return La posición del video, o kNoEncontrado.
+     */
+    std::size_t BuscarPosicion(std::string_view titulo) const;
+
+    /**
+     * @brief Busca un episodio en el índice global por título.
+     * @param titulo El título (no sensible a mayúsculas/minúsculas).
+     * @return El episodio, o nullptr si no existe o el índice global está desactivado.
+     */
+    Episodio* BuscarEpisodio(std::string_view titulo) const;
+
+    /**
+     * @brief Busca un episodio por su serie, temporada y título.
+     * @param serieId El identificador de la serie.
+     * @param temporada La temporada.
+     * @param titulo El título (no sensible a mayúsculas/minúsculas).
+     * @return El episodio, o nullptr si no existe.
+     */
+    Episodio* BuscarEpisodio(std::string_view serieId, int temporada, std::string_view titulo) const;
+
+    // --- Modificaciones en sitio (seguras entre hilos) ---
+
+    /**
+     * @brief Lleva a los índices derivados el promedio actual de un video recién calificado.
+     *
+     * No bloquea las consultas: las columnas se actualizan sin cerrojo y el índice por
+     * calificación bloquea solo la tabla del género y tipo del video.
+     * @param indice La posición del video.
+     */
+    void ActualizarIndicesDeVideo(std::size_t indice);
+
+    /**
+     * @brief Agrega un episodio a una serie y lo indexa.
+     * @param tituloSerie El título de la serie (no sensible a mayúsculas/minúsculas).
+     * @param episodio El episodio.
+     * @return true si la serie existe y el episodio fue agregado.
+     */
+    bool AgregarEpisodio(std::string_view tituloSerie, const Episodio& episodio);
+
+    /** @brief Libera el índice global de episodios por título y deja de mantenerlo. */
+    void DesactivarIndiceGlobalEpisodios();
+
+    /**
+     * @brief Toma el cerrojo de estructura en modo compartido.
+     *
+     * Mientras exista el bloqueo devuelto, ningún hilo agrega episodios, así que
+     * pueden recorrerse las listas de episodios de las series.
+     * @return El bloqueo.
+     */
+    std::shared_lock<std::shared_mutex> BloquearEstructura() const;
+
+    // --- Consultas (seguras entre hilos; los punteros viven tanto como el catálogo) ---
+
+    /** @copydoc ServicioStreaming::BuscarVideos */
+    std::vector<const Video*> BuscarVideos(double calificacionMinima, std::string_view genero) const;
+    /** @copydoc ServicioStreaming::BuscarPeliculas */
+    std::vector<const Video*> BuscarPeliculas(double calificacionMinima) const;
+    /** @copydoc ServicioStreaming::BuscarSerie */
+    const Serie* BuscarSerie(std::string_view tituloSerie) const;
+    /** @copydoc ServicioStreaming::BuscarEpisodiosDeSerie */
+    std::vector<const Episodio*> BuscarEpisodiosDeSerie(std::string_view tituloSerie, double calificacionMinima) const;
+    /** @copydoc ServicioStreaming::BuscarTitulos */
+    std::vector<const Video*> BuscarTitulos(std::string_view texto, std::size_t limite) const;
+    /** @copydoc ServicioStreaming::BuscarTexto */
+    std::vector<ResultadoTexto> BuscarTexto(std::string_view consulta) const;
+    /** @copydoc ServicioStreaming::TopK */
+    std::vector<PosicionRanking> TopK(std::size_t k, std::string_view genero, TipoRanking tipo) const;
+
+    /**
+     * @brief Escribe los índices para restaurarlos con RestaurarIndices.
+     *
+     * Los videos se identifican por su posición y los episodios por su número en el
+     * orden del catálogo (serie por serie), el mismo en que los guarda SnapshotCatalogo.
+     * Requiere el cerrojo de estructura (ver BloquearEstructura).
+     * @param salida El escritor de la sección.
+     */
+    void GuardarIndices(EscritorSnapshot& salida) const;
+
+    /** @brief Obtiene los videos en orden de catálogo. @return Una referencia a los videos. */
+    const std::vector<PtrVideo>& GetVideos() const;
+    /** @brief Obtiene una posición del catálogo. @param indice La posición. @return El video. */
+    Video& GetVideo(std::size_t indice) const;
+    /** @brief Obtiene el número de videos. @return El tamaño del catálogo. */
+    std::size_t GetTamano() const;
+    /** @brief Obtiene el número de arenas (una por bloque en la carga paralela). @return El número de arenas. */
+    std::size_t GetNumeroArenas() const;
+
+private:
+    // Las arenas se declaran antes que los videos para destruirse después de ellos
+    std::vector<std::unique_ptr<std::pmr::monotonic_buffer_resource>> arenas;
+    std::vector<PtrVideo> videos;
+    // Índices hash por título, no sensibles a mayúsculas/minúsculas (valor: posición en videos)
+    IndiceTitulos<std::size_t> videosPorTituloLower;
+    IndiceTitulos<Episodio*> episodiosPorTituloLower;
+    // Índice exacto de episodios por (id de serie, temporada, título)
+    IndiceTitulos<Episodio*> episodiosPorClave;
+    bool indiceGlobalEpisodios;
+    std::string bufferClave; // Se reutiliza al indexar, con el cerrojo de estructura exclusivo
+    // Índice secundario para consultas por calificación mínima y por los mejores calificados
+    // (cerrojo por tabla de género y tipo, ver IndiceCalificaciones)
+    IndiceCalificaciones indiceCalificaciones;
+    // Géneros internados y, por cada género, las posiciones de sus videos en orden de catálogo
+    DiccionarioGeneros generos;
+    std::vector<std::vector<std::size_t>> videosPorGenero;
+    // Búsqueda por prefijo y aproximada de los títulos (no cambia después de publicar)
+    BuscadorTitulos buscadorTitulos;
+    // Índice invertido de palabras de títulos, episodios y géneros; crece con AgregarEpisodio
+    // y por eso lo protege el cerrojo de estructura
+    IndiceTextual indiceTextual;
+    // Copia columnar de tipo, género y calificaciones para los recorridos de filtrado. Ni
+    // ella ni indiceCalificaciones usan un cerrojo global: los promedios de las columnas son
+    // atómicos y el índice tiene un cerrojo por tabla de género y tipo
+    ColumnasCatalogo columnas;
+    // Protege las listas de episodios y sus índices: exclusivo al agregar episodios
+    mutable std::shared_mutex mutexEstructura;
+
+    void IndexarEpisodio(const Serie& serie, Episodio& episodio);
+    std::vector<std::size_t> CandidatosPorCalificacion(double calificacionMinima) const;
+    std::vector<PosicionRanking> TopKEpisodios(std::size_t k, std::uint32_t generoId) const;
+    static void ClaveEpisodio(std::string& clave, std::string_view serieId, int temporada, std::string_view titulo);
+};
+
+#endif // CATALOGO_H
@@ -0,0 +1,101 @@
+/**
+ * @file columnascatalogo.cpp
+ * @brief Implementación de la clase ColumnasCatalogo.
+ * @author Tu Nombre
+ * @date 2025-06-15
+ */
+
+#include "columnascatalogo.h"
+#include "filtrovectorial.h"
+#include <utility>
+
+void ColumnasCatalogo::Reconstruir(const std::vector<PtrVideo>& videos) {
+    Limpiar();
+    tipos.reserve(videos.size());
+    generoIds.reserve(videos.size());
+    // Los atómicos no se mueven: la columna se crea de su tamaño final
+    std::vector<std::atomic<double>> nuevos(videos.size());
+    for (std::size_t i = 0; i < videos.size(); ++i) {
+        tipos.push_back(static_cast<std::uint8_t>(videos[i]->GetTipo()));
+        generoIds.push_back(videos[i]->GetGeneroId());
+        nuevos[i].store(videos[i]->GetCalificaciones().GetPromedio(), std::memory_order_relaxed);
+    }
+    promedios = std::move(nuevos);
+}
+
+void ColumnasCatalogo::ActualizarCalificaciones(std::size_t fila, const AgregadoCalificaciones& calificaciones) {
+    if (fila >= promedios.size()) {
+        return;
+    }
+    // Sin cerrojo, dos hilos pueden escribir fuera de orden; cada uno vuelve a leer el agregado
+    // después de escribir, así que el último en terminar deja el promedio más reciente
+    double promedio = calificaciones.GetPromedio();
+    for (;;) {
+        promedios[fila].store(promedio, std::memory_order_relaxed);
+        const double actual = calificaciones.GetPromedio();
+        if (actual == promedio) {
+            return;
+        }
+        promedio = actual;
+    }
+}
+
+std::vector<std::size_t> ColumnasCatalogo::Filtrar(const CriterioFiltro& criterio) const {
+    const std::size_t total = promedios.size();
+    const double minimo = criterio.calificacionMinima;
+    const bool porGenero = criterio.generoId != kCualquierGenero;
+    const bool porTipo = criterio.tipo != kCualquierTipo;
+    // Los dos predicados de las consultas usan los núcleos vectoriales
+    if (porGenero != porTipo) {
+        MapaSeleccion mapa;
+        if (porGenero) {
+            FiltroVectorial::FiltrarGeneroYCalificacion(generoIds.data(), GetPromedios(), total, criterio.generoId, minimo, mapa);
+        } else {
+            FiltroVectorial::FiltrarTipoYCalificacion(tipos.data(), GetPromedios(), total, criterio.tipo, minimo, mapa);
+        }
+        return FiltroVectorial::FilasSeleccionadas(mapa);
+    }
+
+    std::vector<std::size_t> filas;
+    for (std::size_t i = 0; i < total; ++i) {
+        if ((!porGenero || generoIds[i] == criterio.generoId) && (!porTipo || tipos[i] == criterio.tipo) &&
+            GetPromedio(i) >= minimo) {
+            filas.push_back(i);
+        }
+    }
+    return filas;
+}
+
+void ColumnasCatalogo::Limpiar() {
+    tipos.clear();
+    generoIds.clear();
+    promedios.clear();
+}
+
+std::size_t ColumnasCatalogo::GetTamano() const {
+    return tipos.size();
+}
+
+std::uint8_t ColumnasCatalogo::GetTipo(std::size_t fila) const {
+    return tipos[fila];
+}
+
+std::uint32_t ColumnasCatalogo::GetGeneroId(std::size_t fila) const {
+    return generoIds[fila];
+}
+
+double ColumnasCatalogo::GetPromedio(std::size_t fila) const {
+    return promedios[fila].load(std::memory_order_relaxed);
+}
+
+const std::uint8_t* ColumnasCatalogo::GetTipos() const {
+    return tipos.data();
+}
+
+const std::uint32_t* ColumnasCatalogo::GetGeneroIds() const {
+    return generoIds.data();
+}
+
+const double* ColumnasCatalogo::GetPromedios() const {
+    return reinterpret_cast<const double*>(promedios.data());
+}
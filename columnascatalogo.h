@@ -0,0 +1,124 @@
+#ifndef COLUMNASCATALOGO_H
+#define COLUMNASCATALOGO_H
+
+/**
+ * @file columnascatalogo.h
+ * @brief Declaración de la clase ColumnasCatalogo.
+ * @author Tu Nombre
+ * @date 2025-06-15
+ */
+
+#include "video.h"
+#include "calificaciones.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @struct CriterioFiltro
+ * @brief Condiciones de un recorrido completo de ColumnasCatalogo::Filtrar.
+ */
+struct CriterioFiltro {
+    double calificacionMinima = 0.0; ///< Promedio mínimo (inclusive).
+    std::uint32_t generoId = UINT32_MAX; ///< Género requerido, o ColumnasCatalogo::kCualquierGenero.
+    std::uint8_t tipo = UINT8_MAX; ///< Tipo requerido, o ColumnasCatalogo::kCualquierTipo.
+};
+
+/**
+ * @class ColumnasCatalogo
+ * @brief Copia columnar (estructura de arreglos) de los datos de filtrado del catálogo.
+ *
+ * Cada video ocupa la misma fila que su posición en el catálogo. Un filtro sobre
+ * todo el catálogo recorre solo los arreglos que necesita (tipo, género, promedio),
+ * contiguos en memoria, en lugar de seguir un puntero a cada objeto Video. Solo
+ * se copian las columnas que leen los filtros; el resto de los datos se lee del
+ * video de la fila.
+ *
+ * Las columnas son una vista derivada: Catalogo::Indexar las reconstruye y
+ * Catalogo::ActualizarIndicesDeVideo las actualiza cada vez que un video recibe
+ * calificaciones.
+ *
+ * Sin cerrojos: tipo y género no cambian después de Reconstruir, y cada promedio
+ * es un atómico de 8 bytes alineado que se escribe y se lee con orden relajado. Un
+ * recorrido que coincide con calificaciones nuevas ve, fila por fila, el promedio
+ * anterior o el nuevo, nunca un valor a medias.
+ */
+class ColumnasCatalogo {
+public:
+    /** @brief Tipo de las filas que corresponden a una Pelicula (valor de TipoContenido::Pelicula). */
+    static constexpr std::uint8_t kTipoPelicula = static_cast<std::uint8_t>(TipoContenido::Pelicula);
+    /** @brief Tipo de las filas que corresponden a una Serie (valor de TipoContenido::Serie). */
+    static constexpr std::uint8_t kTipoSerie = static_cast<std::uint8_t>(TipoContenido::Serie);
+    /** @brief Valor de CriterioFiltro::tipo que acepta cualquier tipo. */
+    static constexpr std::uint8_t kCualquierTipo = UINT8_MAX;
+    /** @brief Valor de CriterioFiltro::generoId que acepta cualquier género. */
+    static constexpr std::uint32_t kCualquierGenero = UINT32_MAX;
+
+    /**
+     * @brief Reconstruye todas las columnas a partir del catálogo.
+     *
+     * Usa el identificador de género ya asignado a cada video (Video::GetGeneroId).
+     * @param videos El catálogo; la posición de cada video es su fila.
+     */
+    void Reconstruir(const std::vector<PtrVideo>& videos);
+
+    /**
+     * @brief Actualiza el promedio de una fila.
+     *
+     * Puede llamarse desde varios hilos a la vez, también para la misma fila: la fila
+     * termina con el promedio más reciente del agregado.
+     * @param fila La posición del video en el catálogo (si no existe, se ignora).
+     * @param calificaciones El agregado actual del video.
+     */
+    void ActualizarCalificaciones(std::size_t fila, const AgregadoCalificaciones& calificaciones);
+
+    /**
+     * @brief Recorre todas las filas y devuelve las que cumplen el criterio.
+     *
+     * Los criterios "género y calificación" y "tipo y calificación" se evalúan con
+     * FiltroVectorial usando la mejor implementación del procesador.
+     * @param criterio Las condiciones a cumplir.
+     * @return Las filas que cumplen, en el orden del catálogo.
+     */
+    std::vector<std::size_t> Filtrar(const CriterioFiltro& criterio) const;
+
+    /** @brief Elimina todas las filas. */
+    void Limpiar();
+
+    /** @brief Obtiene el número de filas. @return El número de videos. */
+    std::size_t GetTamano() const;
+
+    /** @brief Obtiene el tipo de una fila. @param fila La fila. @return kTipoPelicula o kTipoSerie. */
+    std::uint8_t GetTipo(std::size_t fila) const;
+    /** @brief Obtiene el identificador de género de una fila. @param fila La fila. @return El identificador. */
+    std::uint32_t GetGeneroId(std::size_t fila) const;
+    /** @brief Obtiene el promedio de una fila (igual a Video::GetCalificacionPromedio). @param fila La fila. @return El promedio. */
+    double GetPromedio(std::size_t fila) const;
+
+    // --- Acceso directo a las columnas, una entrada por fila ---
+
+    /** @brief Obtiene la columna de tipos. @return Un puntero a GetTamano() tipos. */
+    const std::uint8_t* GetTipos() const;
+    /** @brief Obtiene la columna de géneros. @return Un puntero a GetTamano() identificadores. */
+    const std::uint32_t* GetGeneroIds() const;
+    /**
+     * @brief Obtiene la columna de promedios.
+     *
+     * Se lee como double mientras otros hilos la actualizan (ver la descripción de la clase).
+     * @return Un puntero a GetTamano() promedios.
+     */
+    const double* GetPromedios() const;
+
+private:
+    // Los núcleos vectoriales leen los atómicos como una columna de double
+    static_assert(sizeof(std::atomic<double>) == sizeof(double) && alignof(std::atomic<double>) == alignof(double),
+                  "La columna de promedios requiere atómicos del tamaño de un double");
+    static_assert(std::atomic<double>::is_always_lock_free, "La columna de promedios requiere atómicos sin bloqueo");
+
+    std::vector<std::uint8_t> tipos;
+    std::vector<std::uint32_t> generoIds;
+    std::vector<std::atomic<double>> promedios;
+};
+
+#endif // COLUMNASCATALOGO_H
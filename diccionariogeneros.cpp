@@ -0,0 +1,45 @@
+/**
+ * @file diccionariogeneros.cpp
+ * @brief Implementación de la clase DiccionarioGeneros.
+ * @author Tu Nombre
+ * @date 2025-06-15
+ */
+
+#include "diccionariogeneros.h"
+#include <algorithm>
+#include <cctype>
+
+std::string DiccionarioGeneros::Normalizar(std::string_view genero) {
+    std::string normalizado(genero);
+    std::transform(normalizado.begin(), normalizado.end(), normalizado.begin(),
+                   [](unsigned char c){ return std::tolower(c); });
+    return normalizado;
+}
+
+std::uint32_t DiccionarioGeneros::Registrar(std::string_view genero) {
+    if (const std::uint32_t* id = idPorNombre.Buscar(genero)) {
+        return *id;
+    }
+    std::uint32_t id = static_cast<std::uint32_t>(nombres.size());
+    nombres.push_back(Normalizar(genero));
+    idPorNombre.Insertar(genero, id);
+    return id;
+}
+
+std::uint32_t DiccionarioGeneros::Buscar(std::string_view genero) const {
+    const std::uint32_t* id = idPorNombre.Buscar(genero);
+    return id != nullptr ? *id : kSinGenero;
+}
+
+const std::string& DiccionarioGeneros::GetNombre(std::uint32_t id) const {
+    return nombres.at(id);
+}
+
+std::size_t DiccionarioGeneros::GetTamano() const {
+    return nombres.size();
+}
+
+void DiccionarioGeneros::Limpiar() {
+    idPorNombre.Limpiar();
+    nombres.clear();
+}
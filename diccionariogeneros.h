@@ -0,0 +1,65 @@
+#ifndef DICCIONARIOGENEROS_H
+#define DICCIONARIOGENEROS_H
+
+/**
+ * @file diccionariogeneros.h
+ * @brief Declaración de la clase DiccionarioGeneros.
+ * @author Tu Nombre
+ * @date 2025-06-15
+ */
+
+#include "indicetitulos.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @class DiccionarioGeneros
+ * @brief Asigna un identificador entero a cada género distinto del catálogo.
+ *
+ * Los géneros se comparan sin distinguir mayúsculas/minúsculas: "Drama" y
+ * "DRAMA" reciben el mismo identificador. La tabla (ver IndiceTitulos) compara sin
+ * distinguir mayúsculas directamente sobre el texto recibido, así que ni registrar
+ * un género conocido ni buscarlo reserva memoria; las consultas comparan enteros.
+ */
+class DiccionarioGeneros {
+public:
+    /** @brief Identificador que indica "sin género" o "género desconocido". */
+    static constexpr std::uint32_t kSinGenero = UINT32_MAX;
+
+    /**
+     * @brief Registra un género (si no existía) y devuelve su identificador.
+     * @param genero El género tal como aparece en el catálogo.
+     * @return El identificador del género.
+     */
+    std::uint32_t Registrar(std::string_view genero);
+
+    /**
+     * @brief Busca el identificador de un género sin registrarlo.
+     * @param genero El género a buscar (no sensible a mayúsculas/minúsculas).
+     * @return El identificador, o kSinGenero si no existe.
+     */
+    std::uint32_t Buscar(std::string_view genero) const;
+
+    /**
+     * @brief Obtiene el nombre normalizado (en minúsculas) de un género.
+     * @param id El identificador del género.
+     * @return El nombre en minúsculas.
+     */
+    const std::string& GetNombre(std::uint32_t id) const;
+
+    /** @brief Obtiene el número de géneros registrados. @return El número de géneros. */
+    std::size_t GetTamano() const;
+
+    /** @brief Elimina todos los géneros registrados. */
+    void Limpiar();
+
+private:
+    IndiceTitulos<std::uint32_t> idPorNombre;
+    std::vector<std::string> nombres;
+
+    static std::string Normalizar(std::string_view genero);
+};
+
+#endif // DICCIONARIOGENEROS_H
@@ -6,14 +6,19 @@
  */
 
 #include "episodio.h"
-#include <numeric>
+#include "formateador.h"
 #include <iostream>
-#include <iomanip>
 
-Episodio::Episodio(const std::string& titulo, int temporada)
-    : titulo(titulo), temporada(temporada) {}
+Episodio::Episodio(std::string_view titulo, int temporada, const allocator_type& asignador)
+    : titulo(titulo, asignador), temporada(temporada) {}
 
-std::string Episodio::GetTitulo() const {
+Episodio::Episodio(const Episodio& otro, const allocator_type& asignador)
+    : titulo(otro.titulo, asignador), temporada(otro.temporada), calificaciones(otro.calificaciones) {}
+
+Episodio::Episodio(Episodio&& otro, const allocator_type& asignador)
+    : titulo(std::move(otro.titulo), asignador), temporada(otro.temporada), calificaciones(otro.calificaciones) {}
+
+std::string_view Episodio::GetTitulo() const {
     return titulo;
 }
 
@@ -22,21 +27,26 @@ int Episodio::GetTemporada() const {
 }
 
 double Episodio::GetCalificacionPromedio() const {
-    if (calificaciones.empty()) {
-        return 0.0;
-    }
-    double sum = std::accumulate(calificaciones.begin(), calificaciones.end(), 0.0);
-    return sum / calificaciones.size();
+    return calificaciones.GetPromedio();
+}
+
+const AgregadoCalificaciones& Episodio::GetCalificaciones() const {
+    return calificaciones;
+}
+
+bool Episodio::Calificar(int calificacion) {
+    return calificaciones.Agregar(calificacion);
+}
+
+bool Episodio::Calificar(int calificacion, std::uint64_t veces) {
+    return calificaciones.Agregar(calificacion, veces);
 }
 
-void Episodio::Calificar(int calificacion) {
-    if (calificacion >= 1 && calificacion <= 5) {
-        calificaciones.push_back(calificacion);
-    }
+bool Episodio::Calificar(const AgregadoCalificaciones::Frecuencias& frecuencias) {
+    return calificaciones.Agregar(frecuencias);
 }
 
 void Episodio::MostrarDatos() const {
-    std::cout << "    - Titulo Episodio: " << titulo << std::endl;
-    std::cout << "      Temporada: " << temporada << std::endl;
-    std::cout << "      Calificacion promedio: " << std::fixed << std::setprecision(1) << GetCalificacionPromedio() << std::endl;
+    BufferSalida salida(std::cout);
+    Formateador::EscribirEpisodio(salida, *this);
 }
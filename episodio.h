@@ -8,9 +8,11 @@
  * @date 2025-06-15
  */
 
+#include "calificaciones.h"
+#include <cstdint>
+#include <memory_resource>
 #include <string>
-#include <vector>
-#include <numeric>
+#include <string_view>
 #include <iostream>
 #include <iomanip>
 
@@ -20,35 +22,70 @@
  *
  * Almacena información sobre el título, temporada y calificaciones de un episodio.
  * No hereda de Video porque un episodio no es un video independiente en este modelo.
+ * Usa asignador: dentro de un std::pmr::deque, el título se guarda en el mismo
+ * recurso de memoria que el contenedor.
  */
 class Episodio {
+public:
+    /** @brief Asignador del título; lo usan los contenedores std::pmr para propagar su recurso. */
+    using allocator_type = std::pmr::polymorphic_allocator<char>;
+
 private:
-    std::string titulo;
+    std::pmr::string titulo;
     int temporada;
-    std::vector<int> calificaciones;
+    AgregadoCalificaciones calificaciones;
 
 public:
     /**
      * @brief Constructor de la clase Episodio.
      * @param titulo El título del episodio.
      * @param temporada El número de temporada a la que pertenece el episodio.
+     * @param asignador El asignador del título (por defecto, el heap).
      */
-    Episodio(const std::string& titulo, int temporada);
+    Episodio(std::string_view titulo, int temporada, const allocator_type& asignador = {});
+
+    /** @brief Copia un episodio usando otro asignador. @param otro El episodio. @param asignador El asignador. */
+    Episodio(const Episodio& otro, const allocator_type& asignador);
+    /** @brief Mueve un episodio usando otro asignador. @param otro El episodio. @param asignador El asignador. */
+    Episodio(Episodio&& otro, const allocator_type& asignador);
+
+    Episodio(const Episodio&) = default;
+    Episodio(Episodio&&) = default;
+    Episodio& operator=(const Episodio&) = default;
+    Episodio& operator=(Episodio&&) = default;
 
     // --- Getters ---
 
-    /** @brief Obtiene el título del episodio. @return El título. */
-    std::string GetTitulo() const;
+    /** @brief Obtiene el título del episodio. @return Una vista válida mientras exista el episodio. */
+    std::string_view GetTitulo() const;
     /** @brief Obtiene el número de temporada. @return El número de temporada. */
     int GetTemporada() const;
     /** @brief Calcula y obtiene la calificación promedio del episodio. @return La calificación promedio. */
     double GetCalificacionPromedio() const;
+    /** @brief Obtiene el resumen de calificaciones (conteo, suma e histograma). @return El resumen. */
+    const AgregadoCalificaciones& GetCalificaciones() const;
 
     /**
      * @brief Agrega una nueva calificación al episodio.
      * @param calificacion Un entero entre 1 y 5.
+     * @return false si no se agregó (ver AgregadoCalificaciones::Agregar(int)).
+     */
+    bool Calificar(int calificacion);
+
+    /**
+     * @brief Agrega varias veces la misma calificación al episodio en una sola operación.
+     * @param calificacion Un entero entre 1 y 5. Calificaciones fuera de este rango son ignoradas.
+     * @param veces Cuántas veces se agrega.
+     * @return false si no se agregó ninguna (ver AgregadoCalificaciones::Agregar(int, std::uint64_t)).
+     */
+    bool Calificar(int calificacion, std::uint64_t veces);
+
+    /**
+     * @brief Agrega al episodio un grupo de calificaciones distintas en una sola operación.
+     * @param frecuencias Cuántas veces se agrega cada calificación.
+     * @return false si no se agregó ninguna (ver AgregadoCalificaciones::Agregar(const Frecuencias&)).
      */
-    void Calificar(int calificacion);
+    bool Calificar(const AgregadoCalificaciones::Frecuencias& frecuencias);
 
     /**
      * @brief Muestra los datos del episodio en la consola.
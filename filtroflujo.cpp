@@ -0,0 +1,105 @@
+/**
+ * @file filtroflujo.cpp
+ * @brief Implementación de la clase FiltroFlujo.
+ * @author Tu Nombre
+ * @date 2025-06-15
+ */
+
+#include "filtroflujo.h"
+#include "parsercatalogo.h"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstring>
+#include <utility>
+
+namespace {
+
+// Memoria inicial de la arena de cada línea: alcanza para una serie con decenas de episodios
+constexpr std::size_t kArenaLinea = 16 * 1024;
+
+bool IgualesSinMayusculas(std::string_view a, std::string_view b) {
+    return a.size() == b.size() &&
+           std::equal(a.begin(), a.end(), b.begin(), [](unsigned char x, unsigned char y) {
+               return std::tolower(x) == std::tolower(y);
+           });
+}
+
+} // namespace
+
+bool CriterioFlujo::Cumple(const Video& video) const {
+    if (soloPeliculas && video.GetTipo() != TipoContenido::Pelicula) {
+        return false;
+    }
+    if (!genero.empty() && !IgualesSinMayusculas(video.GetGenero(), genero)) {
+        return false;
+    }
+    return video.GetCalificacionPromedio() >= calificacionMinima;
+}
+
+FiltroFlujo::FiltroFlujo(CriterioFlujo criterio, std::ostream& advertencias)
+    : criterio(std::move(criterio)), advertencias(advertencias) {}
+
+ResumenFlujo FiltroFlujo::Procesar(std::istream& entrada, const Consumidor& consumidor) {
+    ResumenFlujo resumen;
+    resumen.abierto = true;
+    std::array<std::byte, kArenaLinea> memoriaArena;
+    std::pmr::monotonic_buffer_resource arena(memoriaArena.data(), memoriaArena.size());
+    std::vector<PtrVideo> videos;
+
+    // buffer[0, pendiente) es una línea incompleta que quedó de la lectura anterior
+    std::vector<char> buffer(kBloqueLectura);
+    std::size_t pendiente = 0;
+    while (entrada) {
+        if (pendiente == buffer.size()) {
+            buffer.resize(buffer.size() * 2); // Una sola línea ocupa todo el búfer
+        }
+        entrada.read(buffer.data() + pendiente, static_cast<std::streamsize>(buffer.size() - pendiente));
+        const std::size_t disponibles = pendiente + static_cast<std::size_t>(entrada.gcount());
+        std::string_view texto(buffer.data(), disponibles);
+        const std::size_t ultimoSalto = texto.rfind('\n');
+        if (ultimoSalto == std::string_view::npos) {
+            pendiente = disponibles;
+            continue;
+        }
+        std::string_view completas = texto.substr(0, ultimoSalto + 1);
+        while (!completas.empty()) {
+            const std::size_t salto = completas.find('\n');
+            ProcesarLinea(completas.substr(0, salto), arena, videos, consumidor, resumen);
+            completas.remove_prefix(salto + 1);
+        }
+        pendiente = disponibles - (ultimoSalto + 1);
+        std::memmove(buffer.data(), buffer.data() + ultimoSalto + 1, pendiente);
+    }
+    if (pendiente > 0) {
+        ProcesarLinea(std::string_view(buffer.data(), pendiente), arena, videos, consumidor, resumen);
+    }
+    resumen.lineas = resumen.reporte.lineas;
+    resumen.bufferMaximo = buffer.size();
+    resumen.reporte.cargado = true;
+    resumen.reporte.EscribirAdvertencias(advertencias);
+    return resumen;
+}
+
+void FiltroFlujo::ProcesarLinea(std::string_view linea, std::pmr::monotonic_buffer_resource& arena,
+                                std::vector<PtrVideo>& videos, const Consumidor& consumidor, ResumenFlujo& resumen) {
+    // Con soloPeliculas, las series se descartan sin parsear sus episodios
+    TipoContenido tipo;
+    if (criterio.soloPeliculas && ParserCatalogo::ParsearTipo(linea.substr(0, linea.find(',')), tipo) &&
+        tipo == TipoContenido::Serie) {
+        ++resumen.reporte.lineas; // El parser cuenta las demás
+        return;
+    }
+    ParserCatalogo parser(resumen.reporte, &arena);
+    parser.ParsearLinea(linea, videos);
+    for (const auto& video : videos) {
+        ++resumen.videos;
+        if (criterio.Cumple(*video)) {
+            ++resumen.coincidencias;
+            consumidor(*video);
+        }
+    }
+    // Los videos se destruyen antes de devolver su memoria a la arena
+    videos.clear();
+    arena.release();
+}
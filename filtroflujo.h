@@ -0,0 +1,87 @@
+#ifndef FILTROFLUJO_H
+#define FILTROFLUJO_H
+
+/**
+ * @file filtroflujo.h
+ * @brief Declaración de la clase FiltroFlujo y de sus criterios y resultados.
+ * @author Tu Nombre
+ * @date 2025-06-15
+ */
+
+#include "video.h"
+#include "reportecarga.h"
+#include <cstddef>
+#include <functional>
+#include <istream>
+#include <memory_resource>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @struct CriterioFlujo
+ * @brief Condiciones que debe cumplir un video para FiltroFlujo.
+ */
+struct CriterioFlujo {
+    double calificacionMinima = 0.0; ///< Calificación promedio mínima (inclusive).
+    std::string genero;              ///< Género (no sensible a mayúsculas/minúsculas); vacío para todos.
+    bool soloPeliculas = false;      ///< true para descartar las series.
+
+    /** @brief Evalúa el criterio. @param video El video. @return true si el video cumple todas las condiciones. */
+    bool Cumple(const Video& video) const;
+};
+
+/**
+ * @struct ResumenFlujo
+ * @brief Resultado de recorrer un archivo con FiltroFlujo.
+ */
+struct ResumenFlujo {
+    bool abierto = false;          ///< false si el archivo no pudo abrirse (el resto queda en cero).
+    std::size_t lineas = 0;        ///< Líneas leídas, incluidas las vacías.
+    std::size_t videos = 0;        ///< Videos parseados (los descartados por tipo sin parsear no cuentan).
+    std::size_t coincidencias = 0; ///< Videos que cumplieron el criterio.
+    std::size_t bufferMaximo = 0;  ///< Bytes del búfer de lectura (crece solo ante una línea más larga que él).
+    ReporteCarga reporte;          ///< Datos inválidos encontrados (las series descartadas sin parsear no se revisan).
+};
+
+/**
+ * @class FiltroFlujo
+ * @brief Filtra un catálogo en formato de texto en una sola pasada, sin cargarlo en memoria.
+ *
+ * El archivo se lee en bloques de kBloqueLectura bytes y cada línea se parsea con
+ * ParserCatalogo en una arena que se vacía después de la línea; cada video que cumple
+ * el criterio se entrega al consumidor apenas se parsea. La memoria usada no depende
+ * del tamaño del archivo sino de su línea más larga (un bloque, como mínimo).
+ */
+class FiltroFlujo {
+public:
+    /** @brief Bytes leídos del archivo por cada lectura. */
+    static constexpr std::size_t kBloqueLectura = 1 << 20;
+
+    /** @brief Recibe cada video que cumple el criterio; la referencia solo es válida durante la llamada. */
+    using Consumidor = std::function<void(const Video&)>;
+
+    /**
+     * @brief Constructor de la clase FiltroFlujo.
+     * @param criterio El criterio de selección.
+     * @param advertencias Flujo donde se escriben, al terminar, las advertencias de datos inválidos.
+     */
+    FiltroFlujo(CriterioFlujo criterio, std::ostream& advertencias);
+
+    /**
+     * @brief Recorre un catálogo completo.
+     * @param entrada El texto del catálogo.
+     * @param consumidor Recibe los videos que cumplen el criterio, en el orden del texto.
+     * @return El resumen del recorrido (abierto es true).
+     */
+    ResumenFlujo Procesar(std::istream& entrada, const Consumidor& consumidor);
+
+private:
+    CriterioFlujo criterio;
+    std::ostream& advertencias;
+
+    void ProcesarLinea(std::string_view linea, std::pmr::monotonic_buffer_resource& arena,
+                       std::vector<PtrVideo>& videos, const Consumidor& consumidor, ResumenFlujo& resumen);
+};
+
+#endif // FILTROFLUJO_H
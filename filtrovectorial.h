@@ -0,0 +1,95 @@
+#ifndef FILTROVECTORIAL_H
+#define FILTROVECTORIAL_H
+
+/**
+ * @file filtrovectorial.h
+ * @brief Declaración de la clase FiltroVectorial.
+ * @author Tu Nombre
+ * @date 2025-06-15
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @enum ImplementacionFiltro
+ * @brief Conjunto de instrucciones usado por los núcleos de FiltroVectorial.
+ */
+enum class ImplementacionFiltro {
+    Escalar, ///< Un elemento por iteración; disponible en cualquier plataforma.
+    SSE2,    ///< 4 filas por iteración con registros de 128 bits (x86).
+    AVX2     ///< 8 filas por iteración con registros de 256 bits (x86 con soporte AVX2).
+};
+
+/**
+ * @brief Mapa de bits de selección: el bit (i % 64) de la palabra (i / 64) indica si la fila i cumple.
+ */
+using MapaSeleccion = std::vector<std::uint64_t>;
+
+/**
+ * @class FiltroVectorial
+ * @brief Núcleos de filtrado sobre columnas densas que producen un mapa de bits de selección.
+ *
+ * Cada núcleo evalúa un predicado fijo ("género == G y promedio >= X", "tipo == T
+ * y promedio >= X") sobre las columnas de ColumnasCatalogo. Las versiones SSE2 y
+ * AVX2 comparan varias filas por instrucción y las condiciones se combinan con
+ * máscaras, sin saltos por fila. La implementación se elige al ejecutar según lo
+ * que soporte el procesador; la versión escalar es la referencia y el respaldo.
+ *
+ * La columna de promedios puede estar recibiendo escrituras atómicas de otros hilos
+ * mientras se filtra (ver ColumnasCatalogo): cada fila se evalúa con su promedio
+ * anterior o con el nuevo.
+ */
+class FiltroVectorial {
+public:
+    /**
+     * @brief Obtiene la mejor implementación disponible en este procesador.
+     * @return AVX2, SSE2 o Escalar (la detección se hace una sola vez).
+     */
+    static ImplementacionFiltro GetImplementacion();
+
+    /**
+     * @brief Indica si una implementación puede ejecutarse en este procesador.
+     * @param implementacion La implementación a consultar.
+     * @return true si está compilada y el procesador la soporta.
+     */
+    static bool EstaDisponible(ImplementacionFiltro implementacion);
+
+    /**
+     * @brief Selecciona las filas con un género dado y un promedio mínimo.
+     * @param generoIds La columna de géneros.
+     * @param promedios La columna de promedios.
+     * @param filas El número de filas de ambas columnas.
+     * @param generoId El género requerido.
+     * @param calificacionMinima El promedio mínimo (inclusive).
+     * @param mapa El mapa de salida; se redimensiona a (filas + 63) / 64 palabras.
+     * @param implementacion La implementación a usar (debe estar disponible).
+     */
+    static void FiltrarGeneroYCalificacion(const std::uint32_t* generoIds, const double* promedios, std::size_t filas,
+                                           std::uint32_t generoId, double calificacionMinima, MapaSeleccion& mapa,
+                                           ImplementacionFiltro implementacion = GetImplementacion());
+
+    /**
+     * @brief Selecciona las filas de un tipo dado con un promedio mínimo.
+     * @param tipos La columna de tipos.
+     * @param promedios La columna de promedios.
+     * @param filas El número de filas de ambas columnas.
+     * @param tipo El tipo requerido.
+     * @param calificacionMinima El promedio mínimo (inclusive).
+     * @param mapa El mapa de salida; se redimensiona a (filas + 63) / 64 palabras.
+     * @param implementacion La implementación a usar (debe estar disponible).
+     */
+    static void FiltrarTipoYCalificacion(const std::uint8_t* tipos, const double* promedios, std::size_t filas,
+                                         std::uint8_t tipo, double calificacionMinima, MapaSeleccion& mapa,
+                                         ImplementacionFiltro implementacion = GetImplementacion());
+
+    /**
+     * @brief Convierte un mapa de selección en la lista de filas seleccionadas.
+     * @param mapa El mapa de bits.
+     * @return Las filas con su bit encendido, en orden creciente.
+     */
+    static std::vector<std::size_t> FilasSeleccionadas(const MapaSeleccion& mapa);
+};
+
+#endif // FILTROVECTORIAL_H
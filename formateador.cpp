@@ -0,0 +1,113 @@
+/**
+ * @file formateador.cpp
+ * @brief Implementación de la clase Formateador.
+ * @author Tu Nombre
+ * @date 2025-06-15
+ */
+
+#include "formateador.h"
+
+void Formateador::EscribirVideo(BufferSalida& salida, const Video& video) {
+    switch (video.GetTipo()) {
+        case TipoContenido::Serie:
+            EscribirSerie(salida, static_cast<const Serie&>(video));
+            break;
+        case TipoContenido::Pelicula:
+            EscribirPelicula(salida, static_cast<const Pelicula&>(video));
+            break;
+    }
+}
+
+void Formateador::EscribirInfoBase(BufferSalida& salida, const Video& video) {
+    salida.Agregar("ID: ").Agregar(video.GetId()).Agregar('\n');
+    salida.Agregar("Nombre: ").Agregar(video.GetNombre()).Agregar('\n');
+    salida.Agregar("Duracion: ").AgregarDecimal(video.GetDuracion()).Agregar(" mins\n");
+    salida.Agregar("Genero: ").Agregar(video.GetGenero()).Agregar('\n');
+    salida.Agregar("Calificacion promedio: ").AgregarDecimal(video.GetCalificacionPromedio(), 1).Agregar('\n');
+}
+
+void Formateador::EscribirPelicula(BufferSalida& salida, const Pelicula& pelicula) {
+    salida.Agregar("Tipo: Pelicula\n");
+    EscribirInfoBase(salida, pelicula);
+}
+
+void Formateador::EscribirSerie(BufferSalida& salida, const Serie& serie) {
+    salida.Agregar("Tipo: Serie\n");
+    EscribirInfoBase(salida, serie);
+    EscribirEpisodios(salida, serie);
+}
+
+void Formateador::EscribirEpisodio(BufferSalida& salida, const Episodio& episodio) {
+    salida.Agregar("    - Titulo Episodio: ").Agregar(episodio.GetTitulo()).Agregar('\n');
+    salida.Agregar("      Temporada: ").AgregarEntero(episodio.GetTemporada()).Agregar('\n');
+    salida.Agregar("      Calificacion promedio: ").AgregarDecimal(episodio.GetCalificacionPromedio(), 1).Agregar('\n');
+}
+
+void Formateador::EscribirEpisodios(BufferSalida& salida, const Serie& serie) {
+    if (serie.GetEpisodios().empty()) {
+        salida.Agregar("  Esta serie no tiene episodios cargados.\n");
+        return;
+    }
+    salida.Agregar("  Episodios:\n");
+    for (const auto& ep : serie.GetEpisodios()) {
+        EscribirEpisodio(salida, ep);
+    }
+}
+
+void Formateador::EscribirEpisodiosConCalificacion(BufferSalida& salida, const Serie& serie,
+                                                   const std::vector<const Episodio*>& episodios,
+                                                   double calificacionMinima) {
+    salida.Agregar("Episodios de la serie '").Agregar(serie.GetNombre()).Agregar("' con calificacion >= ")
+          .AgregarDecimal(calificacionMinima, 1).Agregar(":\n");
+    for (const Episodio* ep : episodios) {
+        EscribirEpisodio(salida, *ep);
+    }
+    if (episodios.empty()) {
+        salida.Agregar("  No se encontraron episodios con esa calificacion.\n");
+    }
+}
+
+void Formateador::EscribirSugerencias(BufferSalida& salida, const std::vector<const Video*>& videos) {
+    if (videos.empty()) {
+        return;
+    }
+    salida.Agregar("Quizas quiso decir: ");
+    for (std::size_t i = 0; i < videos.size(); ++i) {
+        salida.Agregar(i == 0 ? "'" : ", '").Agregar(videos[i]->GetNombre()).Agregar('\'');
+    }
+    salida.Agregar('\n');
+}
+
+void Formateador::EscribirRanking(BufferSalida& salida, const std::vector<PosicionRanking>& posiciones) {
+    long long numero = 0;
+    for (const auto& posicion : posiciones) {
+        salida.AgregarEntero(++numero).Agregar(". ");
+        EscribirDescripcion(salida, *posicion.video, posicion.episodio);
+        salida.Agregar(" - Calificacion promedio: ").AgregarDecimal(posicion.calificacion, 1).Agregar('\n');
+    }
+}
+
+void Formateador::EscribirResultadosTexto(BufferSalida& salida, const std::vector<ResultadoTexto>& resultados) {
+    for (const auto& resultado : resultados) {
+        EscribirDescripcion(salida, *resultado.video, resultado.episodio);
+        salida.Agregar('\n');
+    }
+}
+
+void Formateador::EscribirDescripcion(BufferSalida& salida, const Video& video, const Episodio* episodio) {
+    if (episodio != nullptr) {
+        salida.Agregar("Episodio '").Agregar(episodio->GetTitulo()).Agregar("' de '")
+              .Agregar(video.GetNombre()).Agregar("' (temporada ")
+              .AgregarEntero(episodio->GetTemporada()).Agregar(')');
+    } else {
+        salida.Agregar(video.GetTipo() == TipoContenido::Serie ? "Serie '" : "Pelicula '")
+              .Agregar(video.GetNombre()).Agregar("' (").Agregar(video.GetGenero()).Agregar(')');
+    }
+}
+
+void Formateador::EscribirVideos(BufferSalida& salida, const std::vector<const Video*>& videos) {
+    for (const Video* video : videos) {
+        EscribirVideo(salida, *video);
+        salida.Agregar("--------------------\n");
+    }
+}
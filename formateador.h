@@ -0,0 +1,95 @@
+#ifndef FORMATEADOR_H
+#define FORMATEADOR_H
+
+/**
+ * @file formateador.h
+ * @brief Declaración de la clase Formateador.
+ * @author Tu Nombre
+ * @date 2025-06-15
+ */
+
+#include "video.h"
+#include "pelicula.h"
+#include "serie.h"
+#include "episodio.h"
+#include "buffersalida.h"
+#include "tablaposiciones.h"
+#include "indicetextual.h"
+#include <vector>
+
+/**
+ * @class Formateador
+ * @brief Capa de presentación: convierte videos y episodios en texto.
+ *
+ * Las consultas de ServicioStreaming devuelven punteros a los resultados y esta
+ * clase decide cómo mostrarlos, de modo que el costo de la salida solo se paga
+ * cuando realmente se necesita mostrar algo. Todo se escribe en un BufferSalida,
+ * así que una consulta completa llega al destino en pocos bloques grandes.
+ */
+class Formateador {
+public:
+    /**
+     * @brief Escribe los datos completos de un video según su tipo.
+     * @param salida El búfer de salida.
+     * @param video El video a escribir.
+     */
+    static void EscribirVideo(BufferSalida& salida, const Video& video);
+
+    /** @brief Escribe los datos completos de una película. @param salida El búfer de salida. @param pelicula La película. */
+    static void EscribirPelicula(BufferSalida& salida, const Pelicula& pelicula);
+
+    /** @brief Escribe los datos completos de una serie, incluyendo sus episodios. @param salida El búfer de salida. @param serie La serie. */
+    static void EscribirSerie(BufferSalida& salida, const Serie& serie);
+
+    /** @brief Escribe los datos de un episodio. @param salida El búfer de salida. @param episodio El episodio. */
+    static void EscribirEpisodio(BufferSalida& salida, const Episodio& episodio);
+
+    /** @brief Escribe todos los episodios de una serie. @param salida El búfer de salida. @param serie La serie. */
+    static void EscribirEpisodios(BufferSalida& salida, const Serie& serie);
+
+    /**
+     * @brief Escribe los episodios de una serie que cumplieron una calificación mínima.
+     * @param salida El búfer de salida.
+     * @param serie La serie a la que pertenecen los episodios.
+     * @param episodios Los episodios a escribir (resultado de Serie::BuscarEpisodiosConCalificacion).
+     * @param calificacionMinima La calificación usada en la consulta.
+     */
+    static void EscribirEpisodiosConCalificacion(BufferSalida& salida, const Serie& serie,
+                                                 const std::vector<const Episodio*>& episodios,
+                                                 double calificacionMinima);
+
+    /**
+     * @brief Escribe una lista de videos separados por una línea de guiones.
+     * @param salida El búfer de salida.
+     * @param videos Los videos a escribir.
+     */
+    static void EscribirVideos(BufferSalida& salida, const std::vector<const Video*>& videos);
+
+    /**
+     * @brief Escribe una línea con los títulos sugeridos; no escribe nada si no hay sugerencias.
+     * @param salida El búfer de salida.
+     * @param videos Los videos sugeridos.
+     */
+    static void EscribirSugerencias(BufferSalida& salida, const std::vector<const Video*>& videos);
+
+    /**
+     * @brief Escribe un ranking, una posición numerada por línea.
+     * @param salida El búfer de salida.
+     * @param posiciones Las posiciones (resultado de ServicioStreaming::TopK).
+     */
+    static void EscribirRanking(BufferSalida& salida, const std::vector<PosicionRanking>& posiciones);
+
+    /**
+     * @brief Escribe el resultado de una búsqueda de texto, un documento por línea.
+     * @param salida El búfer de salida.
+     * @param resultados Los documentos (resultado de ServicioStreaming::BuscarTexto).
+     */
+    static void EscribirResultadosTexto(BufferSalida& salida, const std::vector<ResultadoTexto>& resultados);
+
+private:
+    static void EscribirInfoBase(BufferSalida& salida, const Video& video);
+    // "Pelicula 'X' (Drama)", "Serie 'X' (Drama)" o "Episodio 'E' de 'X' (temporada 1)"
+    static void EscribirDescripcion(BufferSalida& salida, const Video& video, const Episodio* episodio);
+};
+
+#endif // FORMATEADOR_H
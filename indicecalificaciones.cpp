@@ -0,0 +1,117 @@
+/**
+ * @file indicecalificaciones.cpp
+ * @brief Implementación de la clase IndiceCalificaciones.
+ * @author Tu Nombre
+ * @date 2025-06-15
+ */
+
+#include "indicecalificaciones.h"
+#include "diccionariogeneros.h"
+#include <algorithm>
+#include <mutex>
+
+std::size_t IndiceCalificaciones::NumeroGrupo(std::uint32_t generoId, TipoContenido tipo) {
+    const std::size_t base = generoId == DiccionarioGeneros::kSinGenero ? 0 : 2 + 2 * static_cast<std::size_t>(generoId);
+    return base + static_cast<std::size_t>(tipo);
+}
+
+void IndiceCalificaciones::Reconstruir(const std::vector<PtrVideo>& videos) {
+    promedios.resize(videos.size());
+    grupoDeVideo.resize(videos.size());
+    std::vector<std::vector<TablaPosiciones::Entrada>> entradas(2);
+    for (std::size_t i = 0; i < videos.size(); ++i) {
+        promedios[i] = videos[i]->GetCalificacionPromedio();
+        const std::size_t grupo = NumeroGrupo(videos[i]->GetGeneroId(), videos[i]->GetTipo());
+        if (grupo >= entradas.size()) {
+            entradas.resize(grupo + 1);
+        }
+        grupoDeVideo[i] = static_cast<std::uint32_t>(grupo);
+        entradas[grupo].emplace_back(promedios[i], i);
+    }
+    std::vector<Grupo> nuevos(entradas.size());
+    for (std::size_t grupo = 0; grupo < entradas.size(); ++grupo) {
+        nuevos[grupo].tabla.Reconstruir(std::move(entradas[grupo]));
+    }
+    grupos = std::move(nuevos);
+}
+
+void IndiceCalificaciones::Actualizar(std::size_t indice, double promedio) {
+    if (indice >= promedios.size()) {
+        return;
+    }
+    std::unique_lock<std::shared_mutex> bloqueo(grupos[grupoDeVideo[indice]].mutex);
+    ActualizarBloqueado(indice, promedio);
+}
+
+void IndiceCalificaciones::Actualizar(std::size_t indice, const AgregadoCalificaciones& calificaciones) {
+    if (indice >= promedios.size()) {
+        return;
+    }
+    std::unique_lock<std::shared_mutex> bloqueo(grupos[grupoDeVideo[indice]].mutex);
+    ActualizarBloqueado(indice, calificaciones.GetPromedio());
+}
+
+void IndiceCalificaciones::ActualizarBloqueado(std::size_t indice, double promedio) {
+    if (promedios[indice] == promedio) {
+        return;
+    }
+    grupos[grupoDeVideo[indice]].tabla.Actualizar(indice, promedios[indice], promedio);
+    promedios[indice] = promedio;
+}
+
+std::vector<std::size_t> IndiceCalificaciones::BuscarDesde(double calificacionMinima) const {
+    std::vector<std::size_t> resultado;
+    for (const auto& grupo : grupos) {
+        // Cada tabla va de mayor a menor promedio: se corta en el primero que no cumple
+        std::shared_lock<std::shared_mutex> bloqueo(grupo.mutex);
+        for (auto it = grupo.tabla.begin(); it != grupo.tabla.end() && it->first >= calificacionMinima; ++it) {
+            resultado.push_back(it->second);
+        }
+    }
+    // Se devuelven en el orden del catálogo para conservar el orden de salida
+    std::sort(resultado.begin(), resultado.end());
+    return resultado;
+}
+
+std::vector<TablaPosiciones::Entrada> IndiceCalificaciones::Mejores(std::size_t k, const CriterioFiltro& criterio) const {
+    // Mezcla de las tablas que cumplen el criterio: un montículo con la mejor entrada
+    // pendiente de cada tabla, cuya raíz es la mejor de todas. Las tablas mezcladas quedan
+    // bloqueadas (en orden creciente, y cada escritor bloquea una sola) hasta terminar
+    using Cursor = std::pair<TablaPosiciones::Iterador, TablaPosiciones::Iterador>;
+    std::vector<Cursor> cursores;
+    std::vector<std::shared_lock<std::shared_mutex>> bloqueos;
+    for (std::size_t grupo = 0; grupo < grupos.size(); ++grupo) {
+        const bool generoValido = criterio.generoId == ColumnasCatalogo::kCualquierGenero
+            || grupo / 2 == 1 + static_cast<std::size_t>(criterio.generoId);
+        const bool tipoValido = criterio.tipo == ColumnasCatalogo::kCualquierTipo || grupo % 2 == criterio.tipo;
+        if (!generoValido || !tipoValido) {
+            continue;
+        }
+        bloqueos.emplace_back(grupos[grupo].mutex);
+        if (grupos[grupo].tabla.GetTamano() > 0) {
+            cursores.emplace_back(grupos[grupo].tabla.begin(), grupos[grupo].tabla.end());
+        }
+    }
+    auto peor = [](const Cursor& a, const Cursor& b) { return TablaPosiciones::Mejor(*b.first, *a.first); };
+    std::make_heap(cursores.begin(), cursores.end(), peor);
+
+    std::vector<TablaPosiciones::Entrada> resultado;
+    while (resultado.size() < k && !cursores.empty()) {
+        std::pop_heap(cursores.begin(), cursores.end(), peor);
+        Cursor& cursor = cursores.back();
+        if (cursor.first->first < criterio.calificacionMinima) {
+            break; // La mejor entrada pendiente ya no cumple: ninguna otra lo hará
+        }
+        resultado.push_back(*cursor.first);
+        if (++cursor.first == cursor.second) {
+            cursores.pop_back();
+        } else {
+            std::push_heap(cursores.begin(), cursores.end(), peor);
+        }
+    }
+    return resultado;
+}
+
+std::size_t IndiceCalificaciones::GetTamano() const {
+    return promedios.size();
+}
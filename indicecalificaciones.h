@@ -0,0 +1,100 @@
+#ifndef INDICECALIFICACIONES_H
+#define INDICECALIFICACIONES_H
+
+/**
+ * @file indicecalificaciones.h
+ * @brief Declaración de la clase IndiceCalificaciones.
+ * @author Tu Nombre
+ * @date 2025-06-15
+ */
+
+#include "video.h"
+#include "tablaposiciones.h"
+#include "columnascatalogo.h"
+#include "calificaciones.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <vector>
+
+/**
+ * @class IndiceCalificaciones
+ * @brief Índice secundario de los videos ordenado por calificación promedio.
+ *
+ * Permite responder consultas "calificación >= X" y "los k mejores" recorriendo
+ * solo los videos que cumplen la condición, en lugar de recorrer todo el catálogo.
+ * Los videos se identifican por su posición en el catálogo.
+ *
+ * Los videos se reparten en una TablaPosiciones por cada combinación de género y
+ * tipo, así que una consulta restringida a un género o a un tipo solo recorre sus
+ * tablas, y calificar un video sigue actualizando una sola tabla.
+ *
+ * Cada tabla tiene su propio cerrojo (cerrojos por franja): Actualizar bloquea solo
+ * la tabla del video, y las consultas la comparten. Calificar un video no detiene las
+ * consultas ni las calificaciones de otros géneros y tipos; una consulta sobre su
+ * tabla espera como mucho una actualización O(log n).
+ */
+class IndiceCalificaciones {
+private:
+    struct Grupo {
+        TablaPosiciones tabla;
+        mutable std::shared_mutex mutex;
+    };
+    // Tablas 0 y 1: videos sin género asignado; después, dos tablas (película, serie) por género.
+    // Los cerrojos no se mueven: el vector se crea de su tamaño final en Reconstruir
+    std::vector<Grupo> grupos;
+    // Promedio con el que está cada video en su tabla; lo protege el cerrojo de esa tabla
+    std::vector<double> promedios;
+    std::vector<std::uint32_t> grupoDeVideo;
+
+    static std::size_t NumeroGrupo(std::uint32_t generoId, TipoContenido tipo);
+    void ActualizarBloqueado(std::size_t indice, double promedio);
+
+public:
+    /**
+     * @brief Reconstruye el índice a partir del catálogo completo.
+     *
+     * Usa el identificador de género ya asignado a cada video (Video::GetGeneroId).
+     * No es seguro entre hilos: se llama antes de publicar el catálogo.
+     * @param videos El catálogo; la posición de cada video es su identificador.
+     */
+    void Reconstruir(const std::vector<PtrVideo>& videos);
+
+    /**
+     * @brief Actualiza la posición de un video tras recibir nuevas calificaciones.
+     * @param indice La posición del video en el catálogo.
+     * @param promedio La nueva calificación promedio del video.
+     */
+    void Actualizar(std::size_t indice, double promedio);
+
+    /**
+     * @brief Actualiza la posición de un video con el promedio actual de su agregado.
+     *
+     * El promedio se lee con la tabla del video bloqueada: si dos hilos califican el
+     * mismo video, el último en entrar deja en la tabla el valor más reciente.
+     * @param indice La posición del video en el catálogo.
+     * @param calificaciones El agregado del video.
+     */
+    void Actualizar(std::size_t indice, const AgregadoCalificaciones& calificaciones);
+
+    /**
+     * @brief Busca los videos con calificación promedio mayor o igual a la indicada.
+     * @param calificacionMinima La calificación mínima requerida.
+     * @return Las posiciones de los videos, en el orden del catálogo.
+     */
+    std::vector<std::size_t> BuscarDesde(double calificacionMinima) const;
+
+    /**
+     * @brief Obtiene los videos mejor calificados que cumplen un criterio.
+     * @param k El número máximo de videos.
+     * @param criterio Calificación mínima, género (o ColumnasCatalogo::kCualquierGenero) y tipo (o ColumnasCatalogo::kCualquierTipo).
+     * @return Hasta k pares (promedio, posición), de mayor a menor promedio; a igual promedio, en el orden del catálogo.
+     */
+    std::vector<TablaPosiciones::Entrada> Mejores(std::size_t k, const CriterioFiltro& criterio) const;
+
+    /** @brief Obtiene el número de videos indexados. @return El tamaño del índice. */
+    std::size_t GetTamano() const;
+};
+
+#endif // INDICECALIFICACIONES_H
@@ -0,0 +1,453 @@
+/**
+ * @file indicetextual.cpp
+ * @brief Implementación de la clase IndiceTextual.
+ * @author Tu Nombre
+ * @date 2025-06-15
+ */
+
+#include "indicetextual.h"
+#include "buscadortitulos.h"
+#include "diccionariogeneros.h"
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace {
+
+bool EsEspacio(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+} // namespace
+
+// Analizador descendente recursivo de las consultas:
+//   disyuncion := conjuncion (OR conjuncion)*
+//   conjuncion := operando ([AND] operando)*
+//   operando   := NOT operando | palabra | '(' disyuncion ')'
+class IndiceTextual::Analizador {
+    struct Simbolo {
+        enum class Tipo { Palabra, Y, O, No, Abre, Cierra } tipo;
+        std::string palabra;
+    };
+
+public:
+    explicit Analizador(std::string_view consulta) {
+        std::string normalizado;
+        std::size_t i = 0;
+        while (i < consulta.size()) {
+            if (EsEspacio(consulta[i])) {
+                ++i;
+                continue;
+            }
+            if (consulta[i] == '(' || consulta[i] == ')') {
+                simbolos.push_back({consulta[i] == '(' ? Simbolo::Tipo::Abre : Simbolo::Tipo::Cierra, {}});
+                ++i;
+                continue;
+            }
+            std::size_t fin = i;
+            while (fin < consulta.size() && !EsEspacio(consulta[fin]) && consulta[fin] != '(' && consulta[fin] != ')') {
+                ++fin;
+            }
+            AgregarPalabra(consulta.substr(i, fin - i), normalizado);
+            i = fin;
+        }
+    }
+
+    bool Analizar(Nodo& raiz) {
+        std::vector<Nodo> partes;
+        while (pos < simbolos.size()) {
+            Nodo parte;
+            if (Disyuncion(parte)) {
+                partes.push_back(std::move(parte));
+            }
+            if (Hay(Simbolo::Tipo::Cierra)) {
+                ++pos; // Paréntesis de cierre sin pareja
+            }
+        }
+        return Combinar(Nodo::Tipo::Y, std::move(partes), raiz);
+    }
+
+private:
+    std::vector<Simbolo> simbolos;
+    std::size_t pos = 0;
+
+    void AgregarPalabra(std::string_view texto, std::string& normalizado) {
+        if (texto == "AND" || texto == "OR" || texto == "NOT") {
+            simbolos.push_back({texto == "AND" ? Simbolo::Tipo::Y : texto == "OR" ? Simbolo::Tipo::O : Simbolo::Tipo::No, {}});
+            return;
+        }
+        // "ciencia-ficcion" se normaliza a dos palabras: van entre paréntesis para que un
+        // NOT anterior se aplique a ambas
+        BuscadorTitulos::Normalizar(texto, normalizado);
+        std::vector<Simbolo> partes;
+        for (std::size_t inicio = 0; inicio < normalizado.size();) {
+            std::size_t fin = normalizado.find(' ', inicio);
+            if (fin == std::string::npos) {
+                fin = normalizado.size();
+            }
+            partes.push_back({Simbolo::Tipo::Palabra, normalizado.substr(inicio, fin - inicio)});
+            inicio = fin + 1;
+        }
+        if (partes.size() > 1) {
+            simbolos.push_back({Simbolo::Tipo::Abre, {}});
+        }
+        std::move(partes.begin(), partes.end(), std::back_inserter(simbolos));
+        if (partes.size() > 1) {
+            simbolos.push_back({Simbolo::Tipo::Cierra, {}});
+        }
+    }
+
+    bool Hay(Simbolo::Tipo tipo) const {
+        return pos < simbolos.size() && simbolos[pos].tipo == tipo;
+    }
+
+    bool EmpiezaOperando() const {
+        return Hay(Simbolo::Tipo::Palabra) || Hay(Simbolo::Tipo::Abre) || Hay(Simbolo::Tipo::No);
+    }
+
+    static bool Combinar(Nodo::Tipo tipo, std::vector<Nodo> hijos, Nodo& nodo) {
+        if (hijos.empty()) {
+            return false;
+        }
+        if (hijos.size() == 1) {
+            nodo = std::move(hijos.front());
+        } else {
+            nodo.tipo = tipo;
+            nodo.hijos = std::move(hijos);
+        }
+        return true;
+    }
+
+    bool Disyuncion(Nodo& nodo) {
+        std::vector<Nodo> hijos;
+        while (true) {
+            Nodo hijo;
+            if (Conjuncion(hijo)) {
+                hijos.push_back(std::move(hijo));
+            }
+            if (!Hay(Simbolo::Tipo::O)) {
+                break;
+            }
+            ++pos;
+        }
+        return Combinar(Nodo::Tipo::O, std::move(hijos), nodo);
+    }
+
+    bool Conjuncion(Nodo& nodo) {
+        std::vector<Nodo> hijos;
+        while (true) {
+            if (Hay(Simbolo::Tipo::Y)) {
+                ++pos;
+                continue;
+            }
+            if (!EmpiezaOperando()) {
+                break;
+            }
+            Nodo hijo;
+            if (Operando(hijo)) {
+                hijos.push_back(std::move(hijo));
+            }
+        }
+        return Combinar(Nodo::Tipo::Y, std::move(hijos), nodo);
+    }
+
+    bool Operando(Nodo& nodo) {
+        if (Hay(Simbolo::Tipo::No)) {
+            ++pos;
+            if (!EmpiezaOperando() || !Operando(nodo)) {
+                return false; // NOT sin operando
+            }
+            nodo.negado = !nodo.negado;
+            return true;
+        }
+        if (Hay(Simbolo::Tipo::Palabra)) {
+            nodo.palabra = std::move(simbolos[pos++].palabra);
+            return true;
+        }
+        ++pos; // '('
+        const bool valido = Disyuncion(nodo);
+        if (Hay(Simbolo::Tipo::Cierra)) {
+            ++pos;
+        }
+        return valido;
+    }
+};
+
+void IndiceTextual::Limpiar() {
+    documentos.clear();
+    palabras.Limpiar();
+    listas.clear();
+    listasPorGenero.clear();
+    generoRegistrado.clear();
+}
+
+void IndiceTextual::AgregarVideo(const Video& video) {
+    const auto documento = static_cast<std::uint32_t>(documentos.size());
+    documentos.push_back({&video, nullptr});
+    AgregarTexto(documento, video.GetNombre());
+    AgregarGenero(documento, video);
+}
+
+void IndiceTextual::AgregarEpisodio(const Video& serie, const Episodio& episodio) {
+    const auto documento = static_cast<std::uint32_t>(documentos.size());
+    documentos.push_back({&serie, &episodio});
+    AgregarTexto(documento, episodio.GetTitulo());
+    AgregarGenero(documento, serie);
+}
+
+void IndiceTextual::AgregarGenero(std::uint32_t documento, const Video& video) {
+    const std::uint32_t generoId = video.GetGeneroId();
+    if (generoId == DiccionarioGeneros::kSinGenero) {
+        AgregarTexto(documento, video.GetGenero());
+        return;
+    }
+    if (generoId >= generoRegistrado.size()) {
+        generoRegistrado.resize(generoId + 1, false);
+        listasPorGenero.resize(generoId + 1);
+    }
+    if (!generoRegistrado[generoId]) {
+        // Primer documento del género: se normaliza y se recuerdan sus listas
+        AgregarTexto(documento, video.GetGenero(), &listasPorGenero[generoId]);
+        generoRegistrado[generoId] = true;
+        return;
+    }
+    for (std::uint32_t lista : listasPorGenero[generoId]) {
+        listas[lista].Agregar(documento);
+    }
+}
+
+void IndiceTextual::AgregarTexto(std::uint32_t documento, std::string_view texto, std::vector<std::uint32_t>* usadas) {
+    BuscadorTitulos::Normalizar(texto, normalizado);
+    for (std::size_t inicio = 0; inicio < normalizado.size();) {
+        std::size_t fin = normalizado.find(' ', inicio);
+        if (fin == std::string::npos) {
+            fin = normalizado.size();
+        }
+        const std::string_view palabra = std::string_view(normalizado).substr(inicio, fin - inicio);
+        std::uint32_t lista;
+        if (const std::uint32_t* existente = palabras.Buscar(palabra)) {
+            lista = *existente;
+        } else {
+            lista = static_cast<std::uint32_t>(listas.size());
+            palabras.Insertar(palabra, lista);
+            listas.emplace_back();
+        }
+        listas[lista].Agregar(documento);
+        if (usadas != nullptr) {
+            usadas->push_back(lista);
+        }
+        inicio = fin + 1;
+    }
+}
+
+std::vector<ResultadoTexto> IndiceTextual::Buscar(std::string_view consulta) const {
+    std::vector<ResultadoTexto> resultado;
+    Nodo raiz;
+    if (!Analizador(consulta).Analizar(raiz)) {
+        return resultado;
+    }
+    Conjunto conjunto = Evaluar(raiz);
+    const std::vector<std::uint32_t> seleccion = Decodificar(conjunto);
+    if (!conjunto.negado) {
+        resultado.reserve(seleccion.size());
+        for (std::uint32_t documento : seleccion) {
+            resultado.push_back(documentos[documento]);
+        }
+        return resultado;
+    }
+    // Complemento: todos los documentos salvo los de la selección
+    resultado.reserve(documentos.size() - seleccion.size());
+    auto excluido = seleccion.begin();
+    for (std::uint32_t documento = 0; documento < documentos.size(); ++documento) {
+        if (excluido != seleccion.end() && *excluido == documento) {
+            ++excluido;
+        } else {
+            resultado.push_back(documentos[documento]);
+        }
+    }
+    return resultado;
+}
+
+IndiceTextual::Conjunto IndiceTextual::Evaluar(const Nodo& nodo) const {
+    Conjunto resultado;
+    if (nodo.tipo == Nodo::Tipo::Palabra) {
+        if (const std::uint32_t* lista = palabras.Buscar(nodo.palabra)) {
+            resultado.lista = &listas[*lista];
+        }
+    } else {
+        // a OR b equivale a NOT (NOT a AND NOT b): la intersección resuelve ambos casos
+        const bool disyuncion = nodo.tipo == Nodo::Tipo::O;
+        std::vector<Conjunto> operandos;
+        operandos.reserve(nodo.hijos.size());
+        for (const auto& hijo : nodo.hijos) {
+            operandos.push_back(Evaluar(hijo));
+            operandos.back().negado ^= disyuncion;
+        }
+        resultado = Interseccion(std::move(operandos));
+        resultado.negado ^= disyuncion;
+    }
+    resultado.negado ^= nodo.negado;
+    return resultado;
+}
+
+IndiceTextual::Conjunto IndiceTextual::Interseccion(std::vector<Conjunto> operandos) {
+    Conjunto resultado;
+    std::vector<Conjunto*> positivos, negativos;
+    for (auto& operando : operandos) {
+        (operando.negado ? negativos : positivos).push_back(&operando);
+    }
+    auto menor = [](const Conjunto* a, const Conjunto* b) { return a->Tamano() < b->Tamano(); };
+    std::sort(negativos.begin(), negativos.end(), menor);
+
+    if (positivos.empty()) {
+        // NOT a AND NOT b equivale a NOT (a OR b)
+        for (Conjunto* negativo : negativos) {
+            std::vector<std::uint32_t> documentos = Decodificar(*negativo);
+            std::vector<std::uint32_t> unidos;
+            unidos.reserve(resultado.documentos.size() + documentos.size());
+            std::set_union(resultado.documentos.begin(), resultado.documentos.end(),
+                           documentos.begin(), documentos.end(), std::back_inserter(unidos));
+            resultado.documentos = std::move(unidos);
+        }
+        resultado.negado = true;
+        return resultado;
+    }
+
+    // Se parte del conjunto positivo más chico y se descarta lo que falta en los demás:
+    // cada verificación avanza con búsqueda exponencial, sin decodificar las listas largas
+    std::sort(positivos.begin(), positivos.end(), menor);
+    resultado.documentos = Decodificar(*positivos.front());
+    for (std::size_t i = 1; i < positivos.size() && !resultado.documentos.empty(); ++i) {
+        Filtrar(resultado.documentos, *positivos[i], true);
+    }
+    for (std::size_t i = 0; i < negativos.size() && !resultado.documentos.empty(); ++i) {
+        Filtrar(resultado.documentos, *negativos[i], false);
+    }
+    return resultado;
+}
+
+std::vector<std::uint32_t> IndiceTextual::Decodificar(Conjunto& conjunto) {
+    if (conjunto.lista == nullptr) {
+        return std::move(conjunto.documentos);
+    }
+    std::vector<std::uint32_t> documentos;
+    documentos.reserve(conjunto.lista->GetTamano());
+    ListaPostings::Cursor cursor(*conjunto.lista);
+    for (std::uint32_t documento = cursor.Actual(); documento != ListaPostings::kFin; documento = cursor.Siguiente()) {
+        documentos.push_back(documento);
+    }
+    return documentos;
+}
+
+void IndiceTextual::Filtrar(std::vector<std::uint32_t>& candidatos, const Conjunto& conjunto, bool presentes) {
+    // Los candidatos están en orden, así que el cursor sobre el conjunto solo avanza
+    std::size_t conservados = 0;
+    if (conjunto.lista != nullptr) {
+        ListaPostings::Cursor cursor(*conjunto.lista);
+        for (std::uint32_t candidato : candidatos) {
+            if ((cursor.Avanzar(candidato) == candidato) == presentes) {
+                candidatos[conservados++] = candidato;
+            }
+        }
+    } else {
+        const std::vector<std::uint32_t>& documentos = conjunto.documentos;
+        std::size_t desde = 0;
+        for (std::uint32_t candidato : candidatos) {
+            std::size_t paso = 1;
+            while (desde + paso < documentos.size() && documentos[desde + paso] < candidato) {
+                desde += paso;
+                paso *= 2;
+            }
+            desde = std::lower_bound(documentos.begin() + desde,
+                                     documentos.begin() + std::min(desde + paso + 1, documentos.size()),
+                                     candidato) - documentos.begin();
+            const bool esta = desde < documentos.size() && documentos[desde] == candidato;
+            if (esta == presentes) {
+                candidatos[conservados++] = candidato;
+            }
+        }
+    }
+    candidatos.resize(conservados);
+}
+
+void IndiceTextual::Guardar(EscritorSnapshot& salida) const {
+    salida.Escribir(static_cast<std::uint64_t>(listas.size()));
+    palabras.Guardar(salida, [](std::uint32_t lista) { return lista; });
+    for (const auto& lista : listas) {
+        lista.Guardar(salida);
+    }
+    salida.Escribir(static_cast<std::uint64_t>(listasPorGenero.size()));
+    for (std::size_t i = 0; i < listasPorGenero.size(); ++i) {
+        salida.Escribir(static_cast<std::uint8_t>(generoRegistrado[i]));
+        salida.EscribirArreglo(listasPorGenero[i]);
+    }
+}
+
+bool IndiceTextual::Restaurar(LectorSnapshot& entrada, std::vector<ResultadoTexto> documentosGuardados) {
+    if (documentosGuardados.size() > UINT32_MAX) {
+        return false;
+    }
+    std::uint64_t totalListas = 0;
+    IndiceTitulos<std::uint32_t> nuevasPalabras;
+    if (!entrada.Leer(totalListas) ||
+        !nuevasPalabras.Restaurar<std::uint32_t>(entrada, [totalListas](std::uint32_t guardada, std::uint32_t& lista) {
+            lista = guardada;
+            return guardada < totalListas;
+        })) {
+        return false;
+    }
+    // Un total dañado no reserva memoria de más: cada lista consume bytes de la sección o falla
+    std::vector<ListaPostings> nuevasListas;
+    const auto limite = static_cast<std::uint32_t>(documentosGuardados.size());
+    for (std::uint64_t i = 0; i < totalListas; ++i) {
+        nuevasListas.emplace_back();
+        if (!nuevasListas.back().Restaurar(entrada, limite)) {
+            return false;
+        }
+    }
+    std::uint64_t generos = 0;
+    if (!entrada.Leer(generos)) {
+        return false;
+    }
+    std::vector<std::vector<std::uint32_t>> nuevasPorGenero;
+    std::vector<bool> nuevosRegistrados;
+    for (std::uint64_t i = 0; i < generos; ++i) {
+        std::uint8_t registrado = 0;
+        nuevasPorGenero.emplace_back();
+        if (!entrada.Leer(registrado) || !entrada.LeerArreglo(nuevasPorGenero.back())) {
+            return false;
+        }
+        for (std::uint32_t lista : nuevasPorGenero.back()) {
+            if (lista >= nuevasListas.size()) {
+                return false;
+            }
+        }
+        nuevosRegistrados.push_back(registrado != 0);
+    }
+    documentos = std::move(documentosGuardados);
+    palabras = std::move(nuevasPalabras);
+    listas = std::move(nuevasListas);
+    listasPorGenero = std::move(nuevasPorGenero);
+    generoRegistrado = std::move(nuevosRegistrados);
+    return true;
+}
+
+std::size_t IndiceTextual::GetDocumentos() const {
+    return documentos.size();
+}
+
+std::size_t IndiceTextual::GetPalabras() const {
+    return palabras.GetTamano();
+}
+
+const std::vector<ResultadoTexto>& IndiceTextual::GetListaDocumentos() const {
+    return documentos;
+}
+
+std::size_t IndiceTextual::GetBytesListas() const {
+    std::size_t bytes = 0;
+    for (const auto& lista : listas) {
+        bytes += lista.GetBytes();
+    }
+    return bytes;
+}
@@ -0,0 +1,134 @@
+#ifndef INDICETEXTUAL_H
+#define INDICETEXTUAL_H
+
+/**
+ * @file indicetextual.h
+ * @brief Declaración de la clase IndiceTextual.
+ * @author Tu Nombre
+ * @date 2025-06-15
+ */
+
+#include "video.h"
+#include "episodio.h"
+#include "listapostings.h"
+#include "indicetitulos.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @struct ResultadoTexto
+ * @brief Un documento encontrado por IndiceTextual: un video o un episodio.
+ */
+struct ResultadoTexto {
+    const Video* video = nullptr;       ///< El video o, para un episodio, su serie.
+    const Episodio* episodio = nullptr; ///< El episodio, o nullptr si el documento es un video.
+};
+
+/**
+ * @class IndiceTextual
+ * @brief Índice invertido de palabras sobre títulos de videos, de episodios y géneros.
+ *
+ * Cada video y cada episodio es un documento; sus palabras son las de su título y
+ * las de su género (un episodio tiene el género de su serie). Los documentos se
+ * numeran en el orden en que se agregan, así que cada lista de documentos de una
+ * palabra crece solo al final y se comprime a medida que se construye (ver ListaPostings).
+ *
+ * Las consultas combinan palabras con AND, OR y NOT (en mayúsculas) y paréntesis;
+ * dos palabras seguidas equivalen a AND y "a NOT b" a "a AND NOT b". Las palabras se
+ * normalizan como los títulos (ver BuscadorTitulos::Normalizar). Una consulta mal
+ * formada no es un error: los operadores sin operando y los paréntesis sin pareja se ignoran.
+ *
+ * Las palabras de cada género se buscan una sola vez, por su identificador (ver
+ * DiccionarioGeneros): los videos agregados deben tener identificadores del mismo
+ * diccionario, o ninguno.
+ *
+ * No es seguro entre hilos: quien lo use debe impedir que se agreguen documentos
+ * durante una búsqueda.
+ */
+class IndiceTextual {
+public:
+    /** @brief Elimina todos los documentos. */
+    void Limpiar();
+
+    /** @brief Agrega un video como documento (título y género). @param video El video; debe vivir tanto como el índice. */
+    void AgregarVideo(const Video& video);
+
+    /**
+     * @brief Agrega un episodio como documento (su título y el género de su serie).
+     * @param serie La serie del episodio.
+     * @param episodio El episodio; debe vivir tanto como el índice.
+     */
+    void AgregarEpisodio(const Video& serie, const Episodio& episodio);
+
+    /**
+     * @brief Evalúa una consulta booleana.
+     * @param consulta La consulta, por ejemplo "drama AND piloto NOT comedia".
+     * @return Los documentos que la cumplen, en el orden en que se agregaron.
+     */
+    std::vector<ResultadoTexto> Buscar(std::string_view consulta) const;
+
+    /** @brief Obtiene el número de documentos. @return El tamaño del índice. */
+    std::size_t GetDocumentos() const;
+    /** @brief Obtiene el número de palabras distintas. @return El tamaño del vocabulario. */
+    std::size_t GetPalabras() const;
+    /** @brief Obtiene los bytes de todas las listas comprimidas. @return El tamaño de las listas. */
+    std::size_t GetBytesListas() const;
+    /** @brief Obtiene los documentos agregados. @return Los documentos, en el orden en que se agregaron. */
+    const std::vector<ResultadoTexto>& GetListaDocumentos() const;
+
+    /**
+     * @brief Escribe el vocabulario y las listas comprimidas tal como están en memoria.
+     *
+     * Los documentos no se escriben, porque son punteros: quien guarda el índice los
+     * identifica a su manera (ver GetListaDocumentos) y los entrega a Restaurar.
+     * @param salida El escritor de la sección.
+     */
+    void Guardar(EscritorSnapshot& salida) const;
+
+    /**
+     * @brief Reemplaza el contenido con un índice escrito por Guardar.
+     *
+     * Verifica cada lista (ver ListaPostings::Restaurar) y que toda referencia a una
+     * lista o a un documento exista; si algo no cuadra, el índice no cambia.
+     * @param entrada El lector de la sección.
+     * @param documentosGuardados Los documentos del índice guardado, en el mismo orden.
+     * @return true si el índice se restauró.
+     */
+    bool Restaurar(LectorSnapshot& entrada, std::vector<ResultadoTexto> documentosGuardados);
+
+private:
+    // Resultado intermedio: una lista del índice o un conjunto ya decodificado, posiblemente complementado
+    struct Conjunto {
+        const ListaPostings* lista = nullptr;
+        std::vector<std::uint32_t> documentos;
+        bool negado = false;
+        std::size_t Tamano() const { return lista != nullptr ? lista->GetTamano() : documentos.size(); }
+    };
+
+    struct Nodo {
+        enum class Tipo { Palabra, Y, O } tipo = Tipo::Palabra;
+        bool negado = false;
+        std::string palabra;
+        std::vector<Nodo> hijos;
+    };
+    class Analizador;
+
+    std::vector<ResultadoTexto> documentos;
+    IndiceTitulos<std::uint32_t> palabras; // Palabra normalizada -> posición en listas
+    std::vector<ListaPostings> listas;
+    std::vector<std::vector<std::uint32_t>> listasPorGenero; // Por identificador de género, sus listas
+    std::vector<bool> generoRegistrado;
+    std::string normalizado; // Se reutiliza al agregar documentos
+
+    void AgregarTexto(std::uint32_t documento, std::string_view texto, std::vector<std::uint32_t>* usadas = nullptr);
+    void AgregarGenero(std::uint32_t documento, const Video& video);
+    Conjunto Evaluar(const Nodo& nodo) const;
+    static Conjunto Interseccion(std::vector<Conjunto> operandos);
+    static std::vector<std::uint32_t> Decodificar(Conjunto& conjunto);
+    static void Filtrar(std::vector<std::uint32_t>& candidatos, const Conjunto& conjunto, bool presentes);
+};
+
+#endif // INDICETEXTUAL_H
@@ -0,0 +1,271 @@
+#ifndef INDICETITULOS_H
+#define INDICETITULOS_H
+
+/**
+ * @file indicetitulos.h
+ * @brief Declaración e implementación de la plantilla IndiceTitulos.
+ * @author Tu Nombre
+ * @date 2025-06-15
+ */
+
+#include "seccionsnapshot.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/**
+ * @class IndiceTitulos
+ * @brief Tabla hash plana (direccionamiento abierto) de títulos a valores.
+ *
+ * Las claves se comparan sin distinguir mayúsculas/minúsculas (ASCII), por lo
+ * que una búsqueda acepta el título tal como lo escribió el usuario, como
+ * std::string_view, sin crear una copia en minúsculas. Las entradas se guardan
+ * contiguas y la tabla de ranuras solo contiene el hash y la posición de la
+ * entrada, de modo que una búsqueda suele tocar una o dos líneas de caché. Los
+ * títulos normalizados de todas las entradas comparten un único búfer, así que
+ * insertar no reserva memoria por título.
+ *
+ * @tparam Valor El tipo asociado a cada título.
+ */
+template <typename Valor>
+class IndiceTitulos {
+public:
+    /**
+     * @brief Inserta un título o reemplaza el valor si ya existía.
+     *
+     * Igual que std::map::operator[], si el título se repite gana la última inserción.
+     * @param titulo El título (no sensible a mayúsculas/minúsculas).
+     * @param valor El valor a asociar.
+     */
+    void Insertar(std::string_view titulo, Valor valor) {
+        if ((entradas.size() + 1) * 4 > ranuras.size() * 3) { // Factor de carga máximo: 0.75
+            Redimensionar(ranuras.empty() ? 16 : ranuras.size() * 2);
+        }
+        std::uint64_t hash = Hash(titulo);
+        std::size_t pos = Localizar(titulo, hash);
+        if (ranuras[pos].entrada != kVacia) {
+            entradas[ranuras[pos].entrada].valor = std::move(valor);
+            return;
+        }
+        ranuras[pos] = {hash, static_cast<std::uint32_t>(entradas.size())};
+        entradas.push_back({claves.size(), static_cast<std::uint32_t>(titulo.size()), std::move(valor)});
+        for (char c : titulo) {
+            claves.push_back(Minuscula(c));
+        }
+    }
+
+    /**
+     * @brief Busca un título.
+     * @param titulo El título (no sensible a mayúsculas/minúsculas).
+     * @return Un puntero al valor, o nullptr si el título no existe.
+     */
+    const Valor* Buscar(std::string_view titulo) const {
+        if (ranuras.empty()) {
+            return nullptr;
+        }
+        std::size_t pos = Localizar(titulo, Hash(titulo));
+        return ranuras[pos].entrada == kVacia ? nullptr : &entradas[ranuras[pos].entrada].valor;
+    }
+
+    /** @copydoc Buscar(std::string_view) const */
+    Valor* Buscar(std::string_view titulo) {
+        return const_cast<Valor*>(static_cast<const IndiceTitulos&>(*this).Buscar(titulo));
+    }
+
+    /**
+     * @brief Reserva espacio para el número de títulos indicado.
+     * @param titulos El número de títulos esperado.
+     */
+    void Reservar(std::size_t titulos) {
+        entradas.reserve(titulos);
+        std::size_t capacidad = 16;
+        while (capacidad * 3 < titulos * 4) {
+            capacidad *= 2;
+        }
+        if (capacidad > ranuras.size()) {
+            Redimensionar(capacidad);
+        }
+    }
+
+    /** @brief Obtiene el número de títulos distintos. @return El tamaño del índice. */
+    std::size_t GetTamano() const {
+        return entradas.size();
+    }
+
+    /** @brief Elimina todos los títulos. */
+    void Limpiar() {
+        entradas.clear();
+        ranuras.clear();
+        claves.clear();
+    }
+
+    /**
+     * @brief Escribe la tabla tal como está en memoria, para restaurarla sin volver a insertar.
+     * @param salida El escritor de la sección.
+     * @param convertir Convierte cada valor a un tipo que se copia byte a byte (por ejemplo,
+     *        un puntero a su posición en el catálogo).
+     */
+    template <typename Convertir>
+    void Guardar(EscritorSnapshot& salida, Convertir convertir) const {
+        using Guardado = decltype(convertir(std::declval<const Valor&>()));
+        // Cada campo en su propio arreglo: las estructuras tienen relleno sin inicializar
+        std::vector<std::uint64_t> inicios(entradas.size());
+        std::vector<std::uint32_t> longitudes(entradas.size());
+        std::vector<Guardado> valores(entradas.size());
+        for (std::size_t i = 0; i < entradas.size(); ++i) {
+            inicios[i] = entradas[i].inicio;
+            longitudes[i] = entradas[i].longitud;
+            valores[i] = convertir(entradas[i].valor);
+        }
+        std::vector<std::uint64_t> hashes(ranuras.size());
+        std::vector<std::uint32_t> posiciones(ranuras.size());
+        for (std::size_t i = 0; i < ranuras.size(); ++i) {
+            hashes[i] = ranuras[i].hash;
+            posiciones[i] = ranuras[i].entrada;
+        }
+        salida.EscribirArreglo(claves);
+        salida.EscribirArreglo(inicios);
+        salida.EscribirArreglo(longitudes);
+        salida.EscribirArreglo(valores);
+        salida.EscribirArreglo(hashes);
+        salida.EscribirArreglo(posiciones);
+    }
+
+    /**
+     * @brief Reemplaza el contenido con una tabla escrita por Guardar.
+     *
+     * Verifica que cada ranura y cada clave queden dentro de la tabla leída, así que
+     * una sección dañada no puede provocar accesos fuera de rango; si algo no cuadra,
+     * la tabla no cambia.
+     * @tparam Guardado El tipo al que Guardar convirtió los valores.
+     * @param entrada El lector de la sección.
+     * @param convertir Recibe un valor guardado y el valor a llenar; devuelve false si no es válido.
+     * @return true si la tabla se restauró.
+     */
+    template <typename Guardado, typename Convertir>
+    bool Restaurar(LectorSnapshot& entrada, Convertir convertir) {
+        std::string nuevasClaves;
+        std::vector<std::uint64_t> inicios;
+        std::vector<std::uint32_t> longitudes;
+        std::vector<Guardado> valores;
+        std::vector<std::uint64_t> hashes;
+        std::vector<std::uint32_t> posiciones;
+        if (!entrada.LeerArreglo(nuevasClaves) || !entrada.LeerArreglo(inicios) || !entrada.LeerArreglo(longitudes) ||
+            !entrada.LeerArreglo(valores) || !entrada.LeerArreglo(hashes) || !entrada.LeerArreglo(posiciones)) {
+            return false;
+        }
+        const std::size_t total = inicios.size();
+        // Localizar necesita que el número de ranuras sea potencia de dos
+        const bool potenciaDeDos = (hashes.size() & (hashes.size() - 1)) == 0;
+        if (longitudes.size() != total || valores.size() != total || posiciones.size() != hashes.size() ||
+            !potenciaDeDos || total * 4 > hashes.size() * 3 || (total > 0 && hashes.empty())) {
+            return false;
+        }
+        std::vector<Entrada> nuevasEntradas(total);
+        for (std::size_t i = 0; i < total; ++i) {
+            if (inicios[i] > nuevasClaves.size() || longitudes[i] > nuevasClaves.size() - inicios[i] ||
+                !convertir(valores[i], nuevasEntradas[i].valor)) {
+                return false;
+            }
+            nuevasEntradas[i].inicio = inicios[i];
+            nuevasEntradas[i].longitud = longitudes[i];
+        }
+        std::vector<Ranura> nuevasRanuras(hashes.size());
+        std::size_t ocupadas = 0;
+        for (std::size_t i = 0; i < hashes.size(); ++i) {
+            if (posiciones[i] != kVacia) {
+                if (posiciones[i] >= total) {
+                    return false;
+                }
+                ++ocupadas;
+            }
+            nuevasRanuras[i] = {hashes[i], posiciones[i]};
+        }
+        if (ocupadas != total) { // Una entrada por ranura: así siempre quedan ranuras vacías
+            return false;
+        }
+        claves = std::move(nuevasClaves);
+        entradas = std::move(nuevasEntradas);
+        ranuras = std::move(nuevasRanuras);
+        return true;
+    }
+
+private:
+    static constexpr std::uint32_t kVacia = UINT32_MAX;
+
+    struct Entrada {
+        std::uint64_t inicio;    // Título en minúsculas: claves[inicio, inicio + longitud)
+        std::uint32_t longitud;
+        Valor valor;
+    };
+
+    struct Ranura {
+        std::uint64_t hash;
+        std::uint32_t entrada;
+    };
+
+    std::vector<Entrada> entradas;
+    std::vector<Ranura> ranuras; // Tamaño siempre potencia de dos
+    std::string claves;
+
+    static char Minuscula(char c) {
+        return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+
+    std::string_view Clave(const Entrada& entrada) const {
+        return std::string_view(claves).substr(entrada.inicio, entrada.longitud);
+    }
+
+    // FNV-1a sobre los caracteres en minúsculas
+    static std::uint64_t Hash(std::string_view titulo) {
+        std::uint64_t hash = 14695981039346656037ull;
+        for (char c : titulo) {
+            hash ^= static_cast<unsigned char>(Minuscula(c));
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    static bool Iguales(std::string_view normalizado, std::string_view titulo) {
+        if (normalizado.size() != titulo.size()) {
+            return false;
+        }
+        for (std::size_t i = 0; i < titulo.size(); ++i) {
+            if (normalizado[i] != Minuscula(titulo[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Devuelve la ranura que contiene el título, o la primera ranura vacía de su secuencia
+    std::size_t Localizar(std::string_view titulo, std::uint64_t hash) const {
+        const std::size_t mascara = ranuras.size() - 1;
+        std::size_t pos = static_cast<std::size_t>(hash) & mascara;
+        while (ranuras[pos].entrada != kVacia) {
+            if (ranuras[pos].hash == hash && Iguales(Clave(entradas[ranuras[pos].entrada]), titulo)) {
+                return pos;
+            }
+            pos = (pos + 1) & mascara; // Sondeo lineal
+        }
+        return pos;
+    }
+
+    void Redimensionar(std::size_t capacidad) {
+        ranuras.assign(capacidad, Ranura{0, kVacia});
+        const std::size_t mascara = capacidad - 1;
+        for (std::size_t i = 0; i < entradas.size(); ++i) {
+            std::uint64_t hash = Hash(Clave(entradas[i]));
+            std::size_t pos = static_cast<std::size_t>(hash) & mascara;
+            while (ranuras[pos].entrada != kVacia) {
+                pos = (pos + 1) & mascara;
+            }
+            ranuras[pos] = {hash, static_cast<std::uint32_t>(i)};
+        }
+    }
+};
+
+#endif // INDICETITULOS_H
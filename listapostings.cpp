@@ -0,0 +1,158 @@
+/**
+ * @file listapostings.cpp
+ * @brief Implementación de la clase ListaPostings.
+ * @author Tu Nombre
+ * @date 2025-06-15
+ */
+
+#include "listapostings.h"
+#include <algorithm>
+
+void ListaPostings::Agregar(std::uint32_t documento) {
+    if (tamano > 0 && documento == ultimo) {
+        return; // El término aparece más de una vez en el mismo documento
+    }
+    if (tamano % kBloque == 0) {
+        saltos.push_back({documento, static_cast<std::uint32_t>(datos.size())});
+    } else {
+        std::uint32_t diferencia = documento - ultimo;
+        while (diferencia >= 0x80) {
+            datos.push_back(static_cast<std::uint8_t>(diferencia | 0x80));
+            diferencia >>= 7;
+        }
+        datos.push_back(static_cast<std::uint8_t>(diferencia));
+    }
+    ultimo = documento;
+    ++tamano;
+}
+
+std::size_t ListaPostings::GetTamano() const {
+    return tamano;
+}
+
+std::size_t ListaPostings::GetBytes() const {
+    return datos.size() + saltos.size() * sizeof(Salto);
+}
+
+void ListaPostings::Guardar(EscritorSnapshot& salida) const {
+    salida.Escribir(tamano);
+    salida.EscribirArreglo(datos);
+    salida.EscribirArreglo(saltos);
+}
+
+bool ListaPostings::Restaurar(LectorSnapshot& entrada, std::uint32_t limite) {
+    std::uint32_t nuevoTamano = 0;
+    std::vector<std::uint8_t> nuevosDatos;
+    std::vector<Salto> nuevosSaltos;
+    if (!entrada.Leer(nuevoTamano) || !entrada.LeerArreglo(nuevosDatos) || !entrada.LeerArreglo(nuevosSaltos) ||
+        nuevosSaltos.size() != (nuevoTamano + kBloque - 1) / kBloque) {
+        return false;
+    }
+    // Cada bloque debe decodificarse justo dentro de sus bytes, como lo haría un Cursor
+    std::uint32_t anterior = 0;
+    std::size_t byte = 0;
+    for (std::size_t indice = 0; indice < nuevoTamano; ++indice) {
+        std::uint32_t documento;
+        if (indice % kBloque == 0) {
+            const Salto& salto = nuevosSaltos[indice / kBloque];
+            if (salto.desplazamiento != byte) {
+                return false;
+            }
+            documento = salto.primero;
+        } else {
+            std::uint64_t diferencia = 0;
+            for (unsigned desplazamiento = 0;; desplazamiento += 7) {
+                if (byte == nuevosDatos.size() || desplazamiento > 28) {
+                    return false;
+                }
+                const std::uint8_t b = nuevosDatos[byte++];
+                diferencia |= static_cast<std::uint64_t>(b & 0x7f) << desplazamiento;
+                if ((b & 0x80) == 0) {
+                    break;
+                }
+            }
+            documento = static_cast<std::uint32_t>(anterior + diferencia);
+            if (diferencia == 0 || anterior + diferencia > UINT32_MAX) {
+                return false;
+            }
+        }
+        if (documento >= limite || (indice > 0 && documento <= anterior)) {
+            return false;
+        }
+        anterior = documento;
+    }
+    if (byte != nuevosDatos.size()) {
+        return false;
+    }
+    datos = std::move(nuevosDatos);
+    saltos = std::move(nuevosSaltos);
+    tamano = nuevoTamano;
+    ultimo = anterior;
+    return true;
+}
+
+ListaPostings::Cursor::Cursor(const ListaPostings& lista) : lista(&lista) {
+    if (lista.tamano > 0) {
+        IrABloque(0);
+    }
+}
+
+void ListaPostings::Cursor::IrABloque(std::size_t numero) {
+    bloque = numero;
+    indice = numero * kBloque;
+    byte = lista->saltos[numero].desplazamiento;
+    actual = lista->saltos[numero].primero;
+}
+
+std::uint32_t ListaPostings::Cursor::Siguiente() {
+    if (actual == kFin) {
+        return kFin;
+    }
+    if (++indice == lista->tamano) {
+        actual = kFin;
+    } else if (indice % kBloque == 0) {
+        IrABloque(bloque + 1);
+    } else {
+        std::uint32_t diferencia = 0;
+        for (unsigned desplazamiento = 0;; desplazamiento += 7) {
+            const std::uint8_t b = lista->datos[byte++];
+            diferencia |= static_cast<std::uint32_t>(b & 0x7f) << desplazamiento;
+            if ((b & 0x80) == 0) {
+                break;
+            }
+        }
+        actual += diferencia;
+    }
+    return actual;
+}
+
+std::uint32_t ListaPostings::Cursor::Avanzar(std::uint32_t objetivo) {
+    if (actual >= objetivo) {
+        return actual;
+    }
+    // Último bloque cuyo primer identificador es <= objetivo: búsqueda exponencial desde
+    // el bloque actual y después binaria dentro del último salto
+    const auto& saltos = lista->saltos;
+    std::size_t desde = bloque;
+    std::size_t paso = 1;
+    while (desde + paso < saltos.size() && saltos[desde + paso].primero <= objetivo) {
+        desde += paso;
+        paso *= 2;
+    }
+    std::size_t hasta = std::min(desde + paso, saltos.size()); // saltos[hasta].primero > objetivo (o no existe)
+    while (hasta - desde > 1) {
+        const std::size_t medio = desde + (hasta - desde) / 2;
+        if (saltos[medio].primero <= objetivo) {
+            desde = medio;
+        } else {
+            hasta = medio;
+        }
+    }
+    if (desde > bloque) {
+        IrABloque(desde);
+    }
+    while (actual < objetivo) {
+        Siguiente();
+    }
+    return actual;
+}
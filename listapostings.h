@@ -0,0 +1,109 @@
+#ifndef LISTAPOSTINGS_H
+#define LISTAPOSTINGS_H
+
+/**
+ * @file listapostings.h
+ * @brief Declaración de la clase ListaPostings.
+ * @author Tu Nombre
+ * @date 2025-06-15
+ */
+
+#include "seccionsnapshot.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class ListaPostings
+ * @brief Lista creciente de identificadores de documento, comprimida.
+ *
+ * Los identificadores se agregan en orden y se guardan como diferencias con el
+ * anterior en varint (un byte para diferencias menores que 128). Cada kBloque
+ * identificadores empieza un bloque nuevo cuyo primer identificador se guarda
+ * completo en una entrada de salto, junto con la posición de sus bytes: un cursor
+ * puede saltar bloques enteros sin decodificarlos.
+ */
+class ListaPostings {
+public:
+    /** @brief Identificadores por bloque (y por entrada de salto). */
+    static constexpr std::size_t kBloque = 128;
+    /** @brief Valor del cursor cuando ya no quedan identificadores. */
+    static constexpr std::uint32_t kFin = UINT32_MAX;
+
+    /**
+     * @brief Agrega un identificador al final.
+     * @param documento El identificador; debe ser mayor o igual que el último (si es igual, no se agrega).
+     */
+    void Agregar(std::uint32_t documento);
+
+    /** @brief Obtiene el número de identificadores. @return El tamaño de la lista. */
+    std::size_t GetTamano() const;
+
+    /** @brief Obtiene los bytes usados por las diferencias y los saltos. @return El tamaño comprimido. */
+    std::size_t GetBytes() const;
+
+    /** @brief Escribe la lista comprimida tal como está en memoria. @param salida El escritor de la sección. */
+    void Guardar(EscritorSnapshot& salida) const;
+
+    /**
+     * @brief Reemplaza el contenido con una lista escrita por Guardar.
+     *
+     * Decodifica la lista completa para verificarla: cada bloque debe tener sus
+     * identificadores en orden creciente y menores que limite. Si algo no cuadra,
+     * la lista no cambia.
+     * @param entrada El lector de la sección.
+     * @param limite Cota (exclusiva) de los identificadores.
+     * @return true si la lista se restauró.
+     */
+    bool Restaurar(LectorSnapshot& entrada, std::uint32_t limite);
+
+    /**
+     * @class Cursor
+     * @brief Recorre una lista de menor a mayor.
+     *
+     * La lista no debe modificarse mientras exista el cursor.
+     */
+    class Cursor {
+    public:
+        /** @brief Crea un cursor sobre el primer identificador. @param lista La lista. */
+        explicit Cursor(const ListaPostings& lista);
+
+        /** @brief Obtiene el identificador actual. @return El identificador, o kFin. */
+        std::uint32_t Actual() const { return actual; }
+
+        /** @brief Pasa al identificador siguiente. @return El identificador nuevo, o kFin. */
+        std::uint32_t Siguiente();
+
+        /**
+         * @brief Avanza hasta el primer identificador mayor o igual que otro.
+         *
+         * Busca el bloque con búsqueda exponencial sobre las entradas de salto (desde
+         * el bloque actual) y decodifica solo ese bloque.
+         * @param objetivo El identificador buscado.
+         * @return El identificador nuevo, o kFin.
+         */
+        std::uint32_t Avanzar(std::uint32_t objetivo);
+
+    private:
+        const ListaPostings* lista;
+        std::size_t indice = 0;      // Posición del identificador actual en la lista
+        std::size_t bloque = 0;
+        std::size_t byte = 0;        // Próximo byte a decodificar en lista->datos
+        std::uint32_t actual = kFin;
+
+        void IrABloque(std::size_t numero);
+    };
+
+private:
+    struct Salto {
+        std::uint32_t primero;       // Primer identificador del bloque
+        std::uint32_t desplazamiento; // Comienzo de las diferencias del bloque en datos
+    };
+
+    std::vector<std::uint8_t> datos;
+    std::vector<Salto> saltos;
+    std::uint32_t ultimo = 0;
+    std::uint32_t tamano = 0;
+};
+
+#endif // LISTAPOSTINGS_H
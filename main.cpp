@@ -62,6 +62,50 @@ int main() {
                 servicio.CalificarVideo(titleToRate, ratingValue);
                 break;
             }
+            case 6: {
+                std::string exportFile = GetStringInput("Ingrese el nombre del archivo de exportacion (ej. catalogo.txt): ");
+                if (servicio.ExportarCatalogo(exportFile)) {
+                    std::cout << "Catalogo exportado a " << exportFile << ".\n";
+                }
+                break;
+            }
+            case 7: {
+                std::string snapshotFile = GetStringInput("Ingrese el nombre del snapshot a guardar (ej. catalogo.snap): ");
+                if (servicio.GuardarSnapshot(snapshotFile)) {
+                    std::cout << "Snapshot guardado en " << snapshotFile << ".\n";
+                }
+                break;
+            }
+            case 8: {
+                std::string snapshotFile = GetStringInput("Ingrese el nombre del snapshot a cargar (ej. catalogo.snap): ");
+                servicio.CargarArchivo(snapshotFile, ModoCarga::Snapshot);
+                break;
+            }
+            case 9: {
+                int topCount = GetIntInput("Ingrese cuantos contenidos mostrar: ");
+                std::string genreFilter = GetStringInput("Ingrese el genero a filtrar (deje vacio para todos): ");
+                int rankingType = GetIntInput("Tipo (0 = videos, 1 = peliculas, 2 = series, 3 = episodios): ");
+                if (topCount <= 0 || rankingType < 0 || rankingType > 3) {
+                    std::cout << "Valores invalidos para el ranking.\n";
+                    break;
+                }
+                servicio.MostrarTopK(static_cast<std::size_t>(topCount), genreFilter, static_cast<TipoRanking>(rankingType));
+                break;
+            }
+            case 10: {
+                std::string query = GetStringInput("Ingrese la consulta (ej. drama AND piloto NOT comedia): ");
+                servicio.MostrarBusquedaTexto(query);
+                break;
+            }
+            case 11: {
+                std::string filename = GetStringInput("Ingrese el nombre del archivo a filtrar sin cargarlo: ");
+                CriterioFlujo criterio;
+                criterio.calificacionMinima = GetDoubleInput("Ingrese la calificacion minima (0-5, 0 para no filtrar): ");
+                criterio.genero = GetStringInput("Ingrese el genero a filtrar (deje vacio para todos): ");
+                criterio.soloPeliculas = GetIntInput("Solo peliculas (1 = si, 0 = no): ") == 1;
+                servicio.MostrarFiltroArchivo(filename, criterio);
+                break;
+            }
             case 0: {
                 std::cout << "Saliendo del programa. ¡Hasta luego!\n";
                 break;
@@ -128,6 +172,12 @@ void DisplayMenu() {
     std::cout << "3. Mostrar episodios de una serie con calificacion especifica\n";
     std::cout << "4. Mostrar peliculas con calificacion especifica\n";
     std::cout << "5. Calificar un video o episodio\n";
+    std::cout << "6. Exportar el catalogo completo a un archivo\n";
+    std::cout << "7. Guardar snapshot binario del catalogo\n";
+    std::cout << "8. Cargar snapshot binario\n";
+    std::cout << "9. Mostrar el ranking de mejor calificados\n";
+    std::cout << "10. Buscar por palabras (AND, OR, NOT)\n";
+    std::cout << "11. Filtrar un archivo sin cargarlo (catalogos muy grandes)\n";
     std::cout << "0. Salir\n";
     std::cout << "-------------------------------------\n";
 }
\ No newline at end of file
@@ -0,0 +1,266 @@
+/**
+ * @file parsercatalogo.cpp
+ * @brief Implementación de la clase ParserCatalogo.
+ * @author Tu Nombre
+ * @date 2025-06-15
+ */
+
+#include "parsercatalogo.h"
+#include "pelicula.h"
+#include <cctype>
+#include <charconv>
+#include <string>
+
+namespace {
+
+/**
+ * @brief Extrae el siguiente campo hasta el delimitador, como std::getline.
+ *
+ * Igual que std::getline, falla solo cuando ya no queda texto por leer; un
+ * delimitador al final no produce un campo vacío adicional.
+ */
+bool SiguienteCampo(std::string_view& resto, char delimitador, std::string_view& campo) {
+    if (resto.empty()) {
+        return false;
+    }
+    std::size_t pos = resto.find(delimitador);
+    if (pos == std::string_view::npos) {
+        campo = resto;
+        resto = std::string_view();
+    } else {
+        campo = resto.substr(0, pos);
+        resto.remove_prefix(pos + 1);
+    }
+    return true;
+}
+
+std::string_view SaltarEspacios(std::string_view texto) {
+    std::size_t i = 0;
+    while (i < texto.size() && std::isspace(static_cast<unsigned char>(texto[i]))) {
+        ++i;
+    }
+    return texto.substr(i);
+}
+
+} // namespace
+
+ParserCatalogo::ParserCatalogo(ReporteCarga& reporte, std::pmr::memory_resource* arena)
+    : reporte(reporte), arena(arena) {}
+
+bool ParserCatalogo::ParsearTipo(std::string_view texto, TipoContenido& tipo) {
+    if (texto == "Pelicula") {
+        tipo = TipoContenido::Pelicula;
+    } else if (texto == "Serie") {
+        tipo = TipoContenido::Serie;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool ParserCatalogo::ParsearEntero(std::string_view texto, int& valor) {
+    texto = SaltarEspacios(texto);
+    if (!texto.empty() && texto.front() == '+') {
+        texto.remove_prefix(1);
+        if (texto.empty() || !std::isdigit(static_cast<unsigned char>(texto.front()))) {
+            return false;
+        }
+    }
+    auto resultado = std::from_chars(texto.data(), texto.data() + texto.size(), valor);
+    return resultado.ec == std::errc();
+}
+
+bool ParserCatalogo::ParsearDecimal(std::string_view texto, double& valor) {
+    texto = SaltarEspacios(texto);
+    if (!texto.empty() && texto.front() == '+') {
+        texto.remove_prefix(1);
+        if (texto.empty() || texto.front() == '-') {
+            return false;
+        }
+    }
+    auto resultado = std::from_chars(texto.data(), texto.data() + texto.size(), valor);
+    return resultado.ec == std::errc();
+}
+
+bool ParserCatalogo::ParsearCalificacion(std::string_view texto, int& valor) {
+    if (texto.size() == 1 && texto.front() >= '0' && texto.front() <= '9') {
+        valor = texto.front() - '0';
+        return true;
+    }
+    return ParsearEntero(texto, valor);
+}
+
+bool ParserCatalogo::SiguienteCalificacion(std::string_view& resto, std::string_view& calificacion) {
+    if (resto.empty()) {
+        return false;
+    }
+    std::size_t pos = resto.find_first_of(kSeparadoresCalificacion);
+    if (pos == std::string_view::npos) {
+        calificacion = resto;
+        resto = std::string_view();
+    } else {
+        calificacion = resto.substr(0, pos);
+        resto.remove_prefix(pos + 1);
+    }
+    return true;
+}
+
+std::vector<std::string_view> ParserCatalogo::DividirEnBloques(std::string_view texto, std::size_t partes) {
+    std::vector<std::string_view> bloques;
+    if (partes == 0) {
+        partes = 1;
+    }
+    const std::size_t objetivo = texto.size() / partes + 1;
+    while (!texto.empty()) {
+        std::size_t corte = texto.size();
+        if (objetivo < texto.size()) {
+            std::size_t salto = texto.find('\n', objetivo - 1);
+            if (salto != std::string_view::npos) {
+                corte = salto + 1;
+            }
+        }
+        bloques.push_back(texto.substr(0, corte));
+        texto.remove_prefix(corte);
+    }
+    return bloques;
+}
+
+void ParserCatalogo::ParsearTexto(std::string_view texto, std::vector<PtrVideo>& destino) {
+    std::string_view linea;
+    while (SiguienteCampo(texto, '\n', linea)) {
+        ParsearLinea(linea, destino);
+    }
+}
+
+void ParserCatalogo::ParsearLinea(std::string_view linea, std::vector<PtrVideo>& destino) {
+    ++reporte.lineas;
+    if (linea.empty() || linea == "\r") { // Ignorar líneas vacías
+        return;
+    }
+
+    std::string_view tipo;
+    SiguienteCampo(linea, ',', tipo);
+
+    TipoContenido tipoContenido;
+    if (!ParsearTipo(tipo, tipoContenido)) {
+        reporte.Registrar(ErrorCarga::TipoDesconocido, {"Advertencia: Tipo de video desconocido '", tipo, "'"});
+    } else if (tipoContenido == TipoContenido::Pelicula) {
+        ParsearPelicula(linea, destino);
+    } else {
+        const ReporteCarga::Reloj::time_point inicio = ReporteCarga::Reloj::now();
+        ParsearSerie(linea, destino);
+        reporte.tiempos.parseoSeries += ReporteCarga::Milisegundos(ReporteCarga::Reloj::now() - inicio);
+    }
+}
+
+void ParserCatalogo::ParsearCalificaciones(Video& video, std::string_view texto, const char* tipo) {
+    std::string_view rating;
+    while (SiguienteCalificacion(texto, rating)) {
+        if (rating.empty()) { // Ignorar segmentos vacíos (ej. 5--4)
+            continue;
+        }
+        int calificacion = 0;
+        if (!ParsearCalificacion(rating, calificacion)) {
+            reporte.Registrar(ErrorCarga::CalificacionInvalida, {"Advertencia: Calificacion invalida para ", tipo,
+                                                                 " '", video.GetNombre(), "': '", rating, "'"});
+        } else if (calificacion < AgregadoCalificaciones::kMinima || calificacion > AgregadoCalificaciones::kMaxima) {
+            reporte.Registrar(ErrorCarga::CalificacionFueraDeRango, {"Advertencia: Calificacion fuera de rango para ", tipo,
+                                                                     " '", video.GetNombre(), "': '", rating, "'"});
+        } else {
+            video.Calificar(calificacion);
+            ++reporte.calificaciones;
+        }
+    }
+}
+
+void ParserCatalogo::ParsearEpisodios(Serie& serie, std::string_view texto) {
+    std::string_view episodeData;
+    while (SiguienteCampo(texto, '|', episodeData)) {
+        std::string_view titulo, temporadaStr;
+        // Solo se requiere título y temporada; las calificaciones son opcionales.
+        if (!SiguienteCampo(episodeData, ':', titulo) || !SiguienteCampo(episodeData, ':', temporadaStr)) {
+            reporte.Registrar(ErrorCarga::EpisodioIncompleto, {"Advertencia: Episodio sin temporada en '",
+                                                               serie.GetNombre(), "': '", titulo, "'"});
+            continue;
+        }
+
+        int temporada = 0;
+        if (!ParsearEntero(temporadaStr, temporada)) {
+            reporte.Registrar(ErrorCarga::TemporadaInvalida, {"Advertencia: Temporada invalida para episodio '", titulo,
+                                                              "' en '", serie.GetNombre(), "': '", temporadaStr, "'"});
+            continue;
+        }
+
+        Episodio& ep = serie.AgregarEpisodio(titulo, temporada);
+        ++reporte.episodios;
+        std::string_view rating;
+        while (SiguienteCalificacion(episodeData, rating)) {
+            int calificacion = 0;
+            if (rating.empty()) {
+                continue;
+            }
+            if (!ParsearCalificacion(rating, calificacion)) {
+                reporte.Registrar(ErrorCarga::CalificacionEpisodioInvalida, {"Advertencia: Calificacion invalida para episodio '",
+                                                                             titulo, "' en '", serie.GetNombre(), "': '", rating, "'"});
+            } else if (calificacion < AgregadoCalificaciones::kMinima || calificacion > AgregadoCalificaciones::kMaxima) {
+                reporte.Registrar(ErrorCarga::CalificacionFueraDeRango, {"Advertencia: Calificacion fuera de rango para episodio '",
+                                                                         titulo, "' en '", serie.GetNombre(), "': '", rating, "'"});
+            } else {
+                ep.Calificar(calificacion);
+                ++reporte.calificaciones;
+            }
+        }
+    }
+}
+
+void ParserCatalogo::ParsearPelicula(std::string_view resto, std::vector<PtrVideo>& destino) {
+    const std::string_view line = resto;
+    std::string_view id, nombre, duracionStr, genero;
+
+    SiguienteCampo(resto, ',', id);
+    SiguienteCampo(resto, ',', nombre);
+    SiguienteCampo(resto, ',', duracionStr);
+    SiguienteCampo(resto, ',', genero);
+
+    double duracion = 0.0;
+    if (!ParsearDecimal(duracionStr, duracion)) {
+        reporte.Registrar(ErrorCarga::DuracionInvalida, {"Advertencia: Duracion invalida en la linea: Pelicula,", line});
+        return;
+    }
+
+    PtrVideo pelicula = CrearVideo<Pelicula>(arena, id, nombre, duracion, genero);
+    ++reporte.peliculas;
+    ParsearCalificaciones(*pelicula, resto, "Pelicula");
+    destino.push_back(std::move(pelicula));
+}
+
+void ParserCatalogo::ParsearSerie(std::string_view resto, std::vector<PtrVideo>& destino) {
+    std::string_view id, nombre, duracionStr, genero;
+
+    SiguienteCampo(resto, ',', id);
+    SiguienteCampo(resto, ',', nombre);
+    SiguienteCampo(resto, ',', duracionStr);
+    SiguienteCampo(resto, ',', genero);
+
+    std::string_view ratingsStr = resto;
+    std::string_view episodesStr;
+    std::size_t semicolonPos = resto.find(';');
+    if (semicolonPos != std::string_view::npos) {
+        ratingsStr = resto.substr(0, semicolonPos);
+        episodesStr = resto.substr(semicolonPos + 1);
+    }
+
+    double duracion = 0.0;
+    if (!ParsearDecimal(duracionStr, duracion)) {
+        duracion = 0.0;
+        reporte.Registrar(ErrorCarga::DuracionSerieInvalida, {"Advertencia: Duracion invalida para Serie '", nombre,
+                                                              "': '", duracionStr, "'"});
+    }
+
+    PtrVideo video = CrearVideo<Serie>(arena, id, nombre, duracion, genero);
+    ++reporte.series;
+    Serie& serie = static_cast<Serie&>(*video);
+    ParsearCalificaciones(serie, ratingsStr, "Serie");
+    ParsearEpisodios(serie, episodesStr);
+    destino.push_back(std::move(video));
+}
@@ -0,0 +1,125 @@
+#ifndef PARSERCATALOGO_H
+#define PARSERCATALOGO_H
+
+/**
+ * @file parsercatalogo.h
+ * @brief Declaración de la clase ParserCatalogo.
+ * @author Tu Nombre
+ * @date 2025-06-15
+ */
+
+#include "video.h"
+#include "serie.h"
+#include "reportecarga.h"
+#include <memory>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
+/**
+ * @class ParserCatalogo
+ * @brief Tokenizador sin copias del formato de texto del catálogo.
+ *
+ * Recorre el texto con std::string_view y convierte los números con
+ * std::from_chars, sin crear std::stringstream ni lanzar excepciones. Produce
+ * exactamente los mismos videos (y el mismo ReporteCarga) que el cargador
+ * basado en std::getline de ServicioStreaming. Los datos inválidos no se
+ * escriben: se registran en el reporte, con su número de línea.
+ */
+class ParserCatalogo {
+private:
+    ReporteCarga& reporte;
+    std::pmr::memory_resource* arena;
+
+    void ParsearPelicula(std::string_view resto, std::vector<PtrVideo>& destino);
+    void ParsearSerie(std::string_view resto, std::vector<PtrVideo>& destino);
+    void ParsearCalificaciones(Video& video, std::string_view texto, const char* tipo);
+    void ParsearEpisodios(Serie& serie, std::string_view texto);
+
+public:
+    /** @brief Caracteres que separan las calificaciones de un video o episodio ("5-4-5" o "5;4;5"). */
+    static constexpr std::string_view kSeparadoresCalificacion = "-;";
+
+    /**
+     * @brief Constructor de la clase ParserCatalogo.
+     * @param reporte Reporte donde se cuentan las líneas, los videos y los datos inválidos.
+     * @param arena Recurso de memoria del que se crean los videos (por defecto, el heap);
+     *        debe sobrevivir a los videos producidos.
+     */
+    explicit ParserCatalogo(ReporteCarga& reporte,
+                            std::pmr::memory_resource* arena = std::pmr::get_default_resource());
+
+    /**
+     * @brief Parsea un bloque de texto con una o más líneas del catálogo.
+     * @param texto El texto a parsear; las líneas vacías se ignoran.
+     * @param destino Vector al que se agregan los videos, en el orden del texto.
+     */
+    void ParsearTexto(std::string_view texto, std::vector<PtrVideo>& destino);
+
+    /**
+     * @brief Parsea una única línea del catálogo (sin el salto de línea final).
+     * @param linea La línea a parsear.
+     * @param destino Vector al que se agrega el video, si la línea es válida.
+     */
+    void ParsearLinea(std::string_view linea, std::vector<PtrVideo>& destino);
+
+    /**
+     * @brief Divide el texto en bloques contiguos que terminan en un salto de línea.
+     *
+     * Ningún bloque corta una línea, por lo que cada uno puede parsearse de forma
+     * independiente y la concatenación de los resultados conserva el orden original.
+     * @param texto El texto completo del catálogo.
+     * @param partes El número de bloques deseado (se devuelven menos si el texto es corto).
+     * @return Los bloques, en el orden del texto.
+     */
+    static std::vector<std::string_view> DividirEnBloques(std::string_view texto, std::size_t partes);
+
+    /**
+     * @brief Reconoce el primer campo de una línea del catálogo.
+     *
+     * La comparación es exacta: " Serie" o "serie" no son tipos válidos. Todas las
+     * estrategias de carga y FiltroFlujo deciden el tipo con esta función.
+     * @param texto El primer campo, hasta la primera coma.
+     * @param tipo Recibe el tipo reconocido.
+     * @return false si el campo no es "Pelicula" ni "Serie".
+     */
+    static bool ParsearTipo(std::string_view texto, TipoContenido& tipo);
+
+    /**
+     * @brief Convierte texto a entero con la misma tolerancia que std::stoi.
+     *
+     * Ignora espacios iniciales y caracteres sobrantes al final, pero nunca lanza.
+     * @param texto El texto a convertir.
+     * @param valor Recibe el valor convertido.
+     * @return true si se encontró un número válido.
+     */
+    static bool ParsearEntero(std::string_view texto, int& valor);
+
+    /**
+     * @brief Convierte texto a double con la misma tolerancia que std::stod.
+     * @param texto El texto a convertir.
+     * @param valor Recibe el valor convertido.
+     * @return true si se encontró un número válido.
+     */
+    static bool ParsearDecimal(std::string_view texto, double& valor);
+
+    /**
+     * @brief Convierte una calificación, con un camino rápido para el caso común de un solo dígito.
+     *
+     * Equivale a ParsearEntero: no verifica el rango 1-5.
+     * @param texto El texto a convertir.
+     * @param valor Recibe el valor convertido.
+     * @return true si se encontró un número válido.
+     */
+    static bool ParsearCalificacion(std::string_view texto, int& valor);
+
+    /**
+     * @brief Extrae la siguiente calificación de una lista separada por kSeparadoresCalificacion.
+     * @param resto El texto pendiente; se consume hasta después del separador.
+     * @param calificacion Recibe el texto de la calificación (puede estar vacío, ej. en "5--4").
+     * @return false si ya no queda texto.
+     */
+    static bool SiguienteCalificacion(std::string_view& resto, std::string_view& calificacion);
+};
+
+#endif // PARSERCATALOGO_H
@@ -6,12 +6,14 @@
  */
 
 #include "pelicula.h"
+#include "formateador.h"
 #include <iostream>
 
-Pelicula::Pelicula(const std::string& id, const std::string& nombre, double duracion, const std::string& genero)
-    : Video(id, nombre, duracion, genero) {}
+Pelicula::Pelicula(std::string_view id, std::string_view nombre, double duracion, std::string_view genero,
+                   std::pmr::memory_resource* recurso)
+    : Video(id, nombre, duracion, genero, TipoContenido::Pelicula, recurso) {}
 
 void Pelicula::MostrarDatos() const {
-    std::cout << "Tipo: Pelicula" << std::endl;
-    ImprimirInfoBase();
+    BufferSalida salida(std::cout);
+    Formateador::EscribirPelicula(salida, *this);
 }
\ No newline at end of file
@@ -26,8 +26,10 @@ public:
      * @param nombre El título de la película.
      * @param duracion La duración de la película en minutos.
      * @param genero El género de la película.
+     * @param recurso El recurso de memoria de los textos (por defecto, el heap).
      */
-    Pelicula(const std::string& id, const std::string& nombre, double duracion, const std::string& genero);
+    Pelicula(std::string_view id, std::string_view nombre, double duracion, std::string_view genero,
+             std::pmr::memory_resource* recurso = std::pmr::get_default_resource());
 
     /**
      * @brief Destructor por defecto.
@@ -42,4 +44,13 @@ public:
     void MostrarDatos() const override;
 };
 
+/**
+ * @brief Convierte un video en película usando su TipoContenido, sin RTTI.
+ * @param video El video.
+ * @return Un puntero a la película, o nullptr si el video no es una película.
+ */
+inline const Pelicula* ComoPelicula(const Video& video) {
+    return video.GetTipo() == TipoContenido::Pelicula ? static_cast<const Pelicula*>(&video) : nullptr;
+}
+
 #endif // PELICULA_H
\ No newline at end of file
@@ -0,0 +1,213 @@
+/**
+ * @file reportecarga.cpp
+ * @brief Implementación de la estructura ReporteCarga.
+ * @author Tu Nombre
+ * @date 2025-06-15
+ */
+
+#include "reportecarga.h"
+#include <cstdio>
+#include <fstream>
+#include <numeric>
+#include <utility>
+
+namespace {
+
+// Escribe un texto como cadena JSON, con comillas y caracteres de control escapados
+void EscribirCadenaJson(std::ostream& salida, std::string_view texto) {
+    salida << '"';
+    for (char c : texto) {
+        switch (c) {
+            case '"': salida << "\\\""; break;
+            case '\\': salida << "\\\\"; break;
+            case '\n': salida << "\\n"; break;
+            case '\r': salida << "\\r"; break;
+            case '\t': salida << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escape[8];
+                    std::snprintf(escape, sizeof(escape), "\\u%04x", static_cast<unsigned>(c));
+                    salida << escape;
+                } else {
+                    salida << c;
+                }
+        }
+    }
+    salida << '"';
+}
+
+// Milisegundos con tres decimales, sin depender del formato configurado en el flujo
+void EscribirMilisegundos(std::ostream& salida, const char* nombre, double milisegundos) {
+    char numero[32];
+    std::snprintf(numero, sizeof(numero), "%.3f", milisegundos);
+    salida << '"' << nombre << "\":" << numero;
+}
+
+} // namespace
+
+void ReporteCarga::Registrar(ErrorCarga tipo, std::initializer_list<std::string_view> mensaje) {
+    const std::size_t i = static_cast<std::size_t>(tipo);
+    ++errores[i];
+    if (muestrasPorTipo[i] == kMuestrasPorTipo) {
+        return;
+    }
+    ++muestrasPorTipo[i];
+    std::string texto;
+    for (std::string_view parte : mensaje) {
+        texto.append(parte);
+    }
+    muestras.push_back({tipo, lineas, std::move(texto)});
+}
+
+void ReporteCarga::Combinar(const ReporteCarga& otro) {
+    for (const Muestra& muestra : otro.muestras) {
+        std::size_t& guardadas = muestrasPorTipo[static_cast<std::size_t>(muestra.tipo)];
+        if (guardadas < kMuestrasPorTipo) {
+            ++guardadas;
+            muestras.push_back({muestra.tipo, lineas + muestra.linea, muestra.mensaje});
+        }
+    }
+    for (std::size_t i = 0; i < kTiposError; ++i) {
+        errores[i] += otro.errores[i];
+    }
+    lineas += otro.lineas;
+    bytes += otro.bytes;
+    tiempos.parseoSeries += otro.tiempos.parseoSeries;
+    peliculas += otro.peliculas;
+    series += otro.series;
+    episodios += otro.episodios;
+    calificaciones += otro.calificaciones;
+}
+
+std::size_t ReporteCarga::GetErrores(ErrorCarga tipo) const {
+    return errores[static_cast<std::size_t>(tipo)];
+}
+
+std::size_t ReporteCarga::GetTotalErrores() const {
+    return std::accumulate(errores.begin(), errores.end(), std::size_t{0});
+}
+
+const std::vector<ReporteCarga::Muestra>& ReporteCarga::GetMuestras() const {
+    return muestras;
+}
+
+double ReporteCarga::GetLineasPorSegundo() const {
+    const double milisegundos = tiempos.lectura + tiempos.parseo;
+    return milisegundos > 0.0 ? lineas * 1000.0 / milisegundos : 0.0;
+}
+
+void ReporteCarga::EscribirAdvertencias(std::ostream& salida) const {
+    std::size_t omitidas = 0;
+    for (std::size_t i = 0; i < kTiposError; ++i) {
+        if (EsAdvertencia(static_cast<ErrorCarga>(i))) {
+            omitidas += errores[i] - muestrasPorTipo[i];
+        }
+    }
+    for (const Muestra& muestra : muestras) {
+        if (EsAdvertencia(muestra.tipo)) {
+            salida << muestra.mensaje << '\n';
+        }
+    }
+    if (omitidas > 0) {
+        salida << "Advertencia: Se omitieron otras " << omitidas << " advertencias\n";
+    }
+    salida.flush();
+}
+
+bool ReporteCarga::EsAdvertencia(ErrorCarga tipo) {
+    switch (tipo) {
+        case ErrorCarga::TipoDesconocido:
+        case ErrorCarga::DuracionInvalida:
+        case ErrorCarga::CalificacionInvalida:
+        case ErrorCarga::TemporadaInvalida:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void ReporteCarga::EscribirJson(std::ostream& salida) const {
+    char ritmo[32];
+    std::snprintf(ritmo, sizeof(ritmo), "%.0f", GetLineasPorSegundo());
+    salida << "{\"archivo\":";
+    EscribirCadenaJson(salida, archivo);
+    salida << ",\"modo\":";
+    EscribirCadenaJson(salida, modo);
+    salida << ",\"hilos\":" << hilos
+           << ",\"cargado\":" << (cargado ? "true" : "false")
+           << ",\"bytes\":" << bytes
+           << ",\"lineas\":" << lineas
+           << ",\"lineasPorSegundo\":" << ritmo
+           << ",\"peliculas\":" << peliculas
+           << ",\"series\":" << series
+           << ",\"episodios\":" << episodios
+           << ",\"calificaciones\":" << calificaciones
+           << ",\"indicesRestaurados\":" << (indicesRestaurados ? "true" : "false")
+           << ",\"memoriaPicoKb\":" << memoriaPicoKb;
+
+    salida << ",\"tiempos\":{";
+    EscribirMilisegundos(salida, "lectura", tiempos.lectura);
+    salida << ',';
+    EscribirMilisegundos(salida, "parseo", tiempos.parseo);
+    salida << ',';
+    EscribirMilisegundos(salida, "parseoSeries", tiempos.parseoSeries);
+    salida << ",\"indices\":{";
+    EscribirMilisegundos(salida, "tablas", tiempos.indices.tablas);
+    salida << ',';
+    EscribirMilisegundos(salida, "buscador", tiempos.indices.buscador);
+    salida << ',';
+    EscribirMilisegundos(salida, "columnas", tiempos.indices.columnas);
+    salida << ',';
+    EscribirMilisegundos(salida, "calificaciones", tiempos.indices.calificaciones);
+    salida << ',';
+    EscribirMilisegundos(salida, "total", tiempos.indices.Total());
+    salida << "},";
+    EscribirMilisegundos(salida, "publicacion", tiempos.publicacion);
+    salida << ',';
+    EscribirMilisegundos(salida, "total", tiempos.total);
+    salida << '}';
+
+    salida << ",\"errores\":{";
+    for (std::size_t i = 0; i < kTiposError; ++i) {
+        salida << (i > 0 ? "," : "") << '"' << NombreError(static_cast<ErrorCarga>(i)) << "\":" << errores[i];
+    }
+    salida << "},\"muestras\":[";
+    for (std::size_t i = 0; i < muestras.size(); ++i) {
+        salida << (i > 0 ? "," : "") << "{\"tipo\":\"" << NombreError(muestras[i].tipo)
+               << "\",\"linea\":" << muestras[i].linea << ",\"mensaje\":";
+        EscribirCadenaJson(salida, muestras[i].mensaje);
+        salida << '}';
+    }
+    salida << "]}";
+}
+
+const char* ReporteCarga::NombreError(ErrorCarga tipo) {
+    switch (tipo) {
+        case ErrorCarga::TipoDesconocido: return "TipoDesconocido";
+        case ErrorCarga::DuracionInvalida: return "DuracionInvalida";
+        case ErrorCarga::DuracionSerieInvalida: return "DuracionSerieInvalida";
+        case ErrorCarga::CalificacionInvalida: return "CalificacionInvalida";
+        case ErrorCarga::CalificacionFueraDeRango: return "CalificacionFueraDeRango";
+        case ErrorCarga::EpisodioIncompleto: return "EpisodioIncompleto";
+        case ErrorCarga::TemporadaInvalida: return "TemporadaInvalida";
+        case ErrorCarga::CalificacionEpisodioInvalida: return "CalificacionEpisodioInvalida";
+    }
+    return "Desconocido";
+}
+
+double ReporteCarga::Milisegundos(Reloj::duration duracion) {
+    return std::chrono::duration<double, std::milli>(duracion).count();
+}
+
+std::size_t ReporteCarga::LeerMemoriaPicoKb() {
+    std::ifstream estado("/proc/self/status");
+    std::string linea;
+    while (std::getline(estado, linea)) {
+        if (linea.rfind("VmHWM:", 0) == 0) {
+            std::size_t kb = 0;
+            std::sscanf(linea.c_str() + 6, "%zu", &kb);
+            return kb;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,187 @@
+#ifndef REPORTECARGA_H
+#define REPORTECARGA_H
+
+/**
+ * @file reportecarga.h
+ * @brief Declaración de la estructura ReporteCarga y de los tipos de error de carga.
+ * @author Tu Nombre
+ * @date 2025-06-15
+ */
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <initializer_list>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @enum ErrorCarga
+ * @brief Tipos de dato inválido que puede encontrar la carga de un catálogo de texto.
+ *
+ * Ninguno detiene la carga: la línea, el episodio o la calificación afectados se
+ * descartan (o, para la duración de una serie, se usa 0) y la carga continúa.
+ */
+enum class ErrorCarga {
+    TipoDesconocido,              ///< Primer campo distinto de "Pelicula" y "Serie" (ver ParserCatalogo::ParsearTipo); se descarta la línea.
+    DuracionInvalida,             ///< Duración no numérica de una película; se descarta la línea.
+    DuracionSerieInvalida,        ///< Duración no numérica de una serie; se usa 0.
+    CalificacionInvalida,         ///< Calificación no numérica de un video; se ignora.
+    CalificacionFueraDeRango,     ///< Calificación numérica fuera de 1-5 (de un video o un episodio); se ignora.
+    EpisodioIncompleto,           ///< Episodio sin título o sin temporada; se ignora.
+    TemporadaInvalida,            ///< Temporada no numérica de un episodio; se ignora el episodio.
+    CalificacionEpisodioInvalida  ///< Calificación no numérica de un episodio; se ignora.
+};
+
+/**
+ * @struct TiemposIndexado
+ * @brief Milisegundos de cada etapa de Catalogo::Indexar.
+ */
+struct TiemposIndexado {
+    double tablas = 0.0;         ///< Pasada por videos y episodios: tablas por título, diccionario de géneros e índice textual.
+    double buscador = 0.0;       ///< Índice de búsqueda de títulos (ver BuscadorTitulos).
+    double columnas = 0.0;       ///< Copia columnar (ver ColumnasCatalogo).
+    double calificaciones = 0.0; ///< Índice y tablas de posiciones por calificación.
+
+    /** @brief Suma las etapas. @return Los milisegundos de todo el indexado. */
+    double Total() const { return tablas + buscador + columnas + calificaciones; }
+};
+
+/**
+ * @struct TiemposCarga
+ * @brief Milisegundos de cada fase de ServicioStreaming::CargarArchivo.
+ *
+ * En las cargas proyectadas (mmap), lectura solo incluye proyectar el archivo: sus
+ * páginas se leen a medida que el parseo las recorre y ese tiempo cuenta en parseo.
+ */
+struct TiemposCarga {
+    double lectura = 0.0;      ///< Abrir el archivo y leerlo (o proyectarlo).
+    double parseo = 0.0;       ///< Tokenizar las líneas y crear videos, episodios y calificaciones.
+    double parseoSeries = 0.0; ///< Parte de parseo en líneas de series, con sus episodios (en la carga paralela, sumada entre hilos).
+    TiemposIndexado indices;   ///< Construir (o restaurar de un snapshot) los índices del catálogo nuevo.
+    double publicacion = 0.0;  ///< Publicar el catálogo nuevo, incluida la liberación del anterior si nadie lo usa.
+    double total = 0.0;        ///< Toda la carga, desde abrir el archivo hasta publicar.
+};
+
+/**
+ * @struct ReporteCarga
+ * @brief Resultado de cargar un catálogo: qué se leyó y qué datos inválidos se descartaron.
+ *
+ * Cada error se cuenta por tipo, y de cada tipo se guardan solo los primeros
+ * kMuestrasPorTipo (número de línea y mensaje), así que el reporte ocupa memoria
+ * acotada aunque el archivo tenga millones de datos inválidos. Los mensajes de los
+ * tipos que se informan como advertencias (ver EsAdvertencia) se escriben con
+ * EscribirAdvertencias.
+ *
+ * También registra cuánto tardó cada fase de la carga, los bytes leídos y el pico
+ * de memoria del proceso, para seguir el rendimiento entre versiones del catálogo
+ * (ver EscribirJson).
+ */
+struct ReporteCarga {
+    /** @brief Reloj de las mediciones de tiempo. */
+    using Reloj = std::chrono::steady_clock;
+
+    /** @brief Número de tipos de ErrorCarga. */
+    static constexpr std::size_t kTiposError = static_cast<std::size_t>(ErrorCarga::CalificacionEpisodioInvalida) + 1;
+    /** @brief Errores de cada tipo que se guardan como muestra. */
+    static constexpr std::size_t kMuestrasPorTipo = 10;
+
+    /**
+     * @struct Muestra
+     * @brief Un error guardado como ejemplo.
+     */
+    struct Muestra {
+        ErrorCarga tipo;     ///< El tipo de error.
+        std::size_t linea;   ///< Número de línea en el archivo (desde 1).
+        std::string mensaje; ///< Descripción del error, con el dato inválido.
+    };
+
+    std::string archivo;             ///< Ruta del archivo cargado.
+    std::string modo;                ///< Estrategia de lectura ("flujo", "mapeado", "paralelo" o "snapshot").
+    unsigned hilos = 1;              ///< Hilos usados para parsear.
+    bool cargado = false;            ///< false si el archivo no pudo abrirse o no es válido (el catálogo no cambia).
+    std::size_t bytes = 0;           ///< Bytes leídos del archivo.
+    std::size_t lineas = 0;          ///< Líneas leídas, incluidas las vacías.
+    std::size_t peliculas = 0;       ///< Películas cargadas.
+    std::size_t series = 0;          ///< Series cargadas.
+    std::size_t episodios = 0;       ///< Episodios cargados.
+    std::size_t calificaciones = 0;  ///< Calificaciones válidas de videos y episodios.
+    bool indicesRestaurados = false; ///< true si los índices se copiaron del snapshot en lugar de construirse.
+    std::size_t memoriaPicoKb = 0;   ///< Pico de memoria residente del proceso al terminar (0 si el sistema no lo informa).
+    TiemposCarga tiempos;            ///< Duración de cada fase.
+
+    /**
+     * @brief Cuenta un error en la línea actual (la número lineas).
+     *
+     * El mensaje se recibe en partes y solo se arma si el error entra en la muestra,
+     * así que los errores que la exceden no cuestan más que un incremento.
+     * @param tipo El tipo de error.
+     * @param mensaje Las partes de la descripción del error, que se concatenan.
+     */
+    void Registrar(ErrorCarga tipo, std::initializer_list<std::string_view> mensaje);
+
+    /**
+     * @brief Agrega al final el reporte de la porción siguiente del mismo archivo.
+     *
+     * Los números de línea de otro se desplazan en las líneas de este reporte, y las
+     * muestras conservan las primeras de cada tipo en el orden del archivo.
+     * @param otro El reporte de las líneas que siguen a las de este.
+     */
+    void Combinar(const ReporteCarga& otro);
+
+    /** @brief Obtiene los errores de un tipo. @param tipo El tipo. @return El número de errores. */
+    std::size_t GetErrores(ErrorCarga tipo) const;
+    /** @brief Obtiene los errores de todos los tipos. @return El número de errores. */
+    std::size_t GetTotalErrores() const;
+    /** @brief Obtiene las muestras guardadas. @return Las muestras, en el orden del archivo. */
+    const std::vector<Muestra>& GetMuestras() const;
+    /** @brief Obtiene las líneas leídas y parseadas por segundo. @return El ritmo, o 0 si no hubo tiempo medido. */
+    double GetLineasPorSegundo() const;
+
+    /**
+     * @brief Escribe los mensajes de las muestras que son advertencias, una por línea.
+     *
+     * Si hubo más advertencias que muestras, termina con una línea que indica cuántas se omitieron.
+     * @param salida El flujo de destino.
+     */
+    void EscribirAdvertencias(std::ostream& salida) const;
+
+    /**
+     * @brief Indica si un tipo de error se informa como advertencia al cargar.
+     *
+     * Los demás tipos solo se cuentan: son datos opcionales que la carga siempre
+     * descartó sin avisar.
+     * @param tipo El tipo.
+     * @return true para TipoDesconocido, DuracionInvalida, CalificacionInvalida y TemporadaInvalida.
+     */
+    static bool EsAdvertencia(ErrorCarga tipo);
+
+    /**
+     * @brief Escribe el reporte completo como un objeto JSON en una sola línea (sin salto final).
+     *
+     * Los tiempos van en milisegundos y los errores por tipo, con el nombre de NombreError.
+     * @param salida El flujo de destino.
+     */
+    void EscribirJson(std::ostream& salida) const;
+
+    /** @brief Obtiene el nombre de un tipo de error, igual al de su enumerador. @param tipo El tipo. @return El nombre. */
+    static const char* NombreError(ErrorCarga tipo);
+
+    /** @brief Convierte una duración a milisegundos. @param duracion La duración. @return Los milisegundos. */
+    static double Milisegundos(Reloj::duration duracion);
+
+    /**
+     * @brief Lee el pico de memoria residente del proceso (VmHWM en /proc/self/status).
+     * @return Los kilobytes, o 0 si el sistema no lo informa.
+     */
+    static std::size_t LeerMemoriaPicoKb();
+
+private:
+    std::array<std::size_t, kTiposError> errores{};
+    std::array<std::size_t, kTiposError> muestrasPorTipo{};
+    std::vector<Muestra> muestras;
+};
+
+#endif // REPORTECARGA_H
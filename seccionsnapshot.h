@@ -0,0 +1,144 @@
+#ifndef SECCIONSNAPSHOT_H
+#define SECCIONSNAPSHOT_H
+
+/**
+ * @file seccionsnapshot.h
+ * @brief Declaración e implementación de las clases EscritorSnapshot y LectorSnapshot.
+ * @author Tu Nombre
+ * @date 2025-06-15
+ */
+
+#include "buffersalida.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @class EscritorSnapshot
+ * @brief Escribe valores y arreglos binarios en la sección de índices de un snapshot.
+ *
+ * Cada arreglo se escribe como su número de elementos (64 bits) seguido de sus
+ * bytes, así que un índice se guarda copiando sus vectores tal como están en
+ * memoria y se recupera con LectorSnapshot sin recalcular nada. Solo admite tipos
+ * que se copian byte a byte y sin relleno interno (el relleno no está inicializado).
+ */
+class EscritorSnapshot {
+public:
+    /** @brief Constructor. @param salida El búfer donde se escriben los bytes. */
+    explicit EscritorSnapshot(BufferSalida& salida) : salida(salida) {}
+
+    /** @brief Escribe un valor. @param valor El valor. */
+    template <typename T>
+    void Escribir(const T& valor) {
+        static_assert(std::is_trivially_copyable<T>::value, "Solo se escriben tipos que se copian byte a byte");
+        Agregar(&valor, sizeof(T));
+    }
+
+    /** @brief Escribe un arreglo. @param datos Los elementos. @param cantidad El número de elementos. */
+    template <typename T>
+    void EscribirArreglo(const T* datos, std::size_t cantidad) {
+        static_assert(std::is_trivially_copyable<T>::value, "Solo se escriben tipos que se copian byte a byte");
+        Escribir(static_cast<std::uint64_t>(cantidad));
+        Agregar(datos, cantidad * sizeof(T));
+    }
+
+    /** @brief Escribe un vector. @param datos El vector. */
+    template <typename T>
+    void EscribirArreglo(const std::vector<T>& datos) {
+        EscribirArreglo(datos.data(), datos.size());
+    }
+
+    /** @brief Escribe un texto. @param texto El texto. */
+    void EscribirArreglo(std::string_view texto) {
+        EscribirArreglo(texto.data(), texto.size());
+    }
+
+    /** @brief Obtiene los bytes escritos. @return El tamaño de la sección hasta ahora. */
+    std::uint64_t GetBytes() const {
+        return bytes;
+    }
+
+private:
+    BufferSalida& salida;
+    std::uint64_t bytes = 0;
+
+    void Agregar(const void* datos, std::size_t cantidad) {
+        salida.Agregar(std::string_view(static_cast<const char*>(datos), cantidad));
+        bytes += cantidad;
+    }
+};
+
+/**
+ * @class LectorSnapshot
+ * @brief Lee lo que escribió EscritorSnapshot, verificando que cada lectura quede dentro de la sección.
+ *
+ * Una lectura que no cabe devuelve false y no consume nada; quien restaura un
+ * índice debe además validar que los valores leídos sean coherentes entre sí.
+ */
+class LectorSnapshot {
+public:
+    /** @brief Constructor. @param contenido Los bytes de la sección (deben vivir mientras se lee). */
+    explicit LectorSnapshot(std::string_view contenido) : resto(contenido) {}
+
+    /** @brief Lee un valor. @param valor Recibe el valor. @return false si la sección terminó. */
+    template <typename T>
+    bool Leer(T& valor) {
+        static_assert(std::is_trivially_copyable<T>::value, "Solo se leen tipos que se copian byte a byte");
+        if (resto.size() < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&valor, resto.data(), sizeof(T)); // La sección no garantiza alineación
+        resto.remove_prefix(sizeof(T));
+        return true;
+    }
+
+    /** @brief Lee un arreglo en un vector, reemplazando su contenido. @param destino El vector. @return false si el arreglo no cabe en la sección. */
+    template <typename T>
+    bool LeerArreglo(std::vector<T>& destino) {
+        std::string_view bytes;
+        if (!LeerBytes(sizeof(T), bytes)) {
+            return false;
+        }
+        destino.resize(bytes.size() / sizeof(T));
+        if (!bytes.empty()) {
+            std::memcpy(destino.data(), bytes.data(), bytes.size());
+        }
+        return true;
+    }
+
+    /** @brief Lee un texto, reemplazando el contenido de destino. @param destino El texto. @return false si el texto no cabe en la sección. */
+    bool LeerArreglo(std::string& destino) {
+        std::string_view bytes;
+        if (!LeerBytes(1, bytes)) {
+            return false;
+        }
+        destino.assign(bytes);
+        return true;
+    }
+
+    /** @brief Indica si se leyó toda la sección. @return true si no quedan bytes. */
+    bool Terminado() const {
+        return resto.empty();
+    }
+
+private:
+    std::string_view resto;
+
+    bool LeerBytes(std::size_t tamanoElemento, std::string_view& bytes) {
+        std::string_view copia = resto;
+        std::uint64_t cantidad = 0;
+        if (!Leer(cantidad) || cantidad > resto.size() / tamanoElemento) {
+            resto = copia;
+            return false;
+        }
+        bytes = resto.substr(0, cantidad * tamanoElemento);
+        resto.remove_prefix(bytes.size());
+        return true;
+    }
+};
+
+#endif // SECCIONSNAPSHOT_H
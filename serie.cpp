@@ -6,53 +6,51 @@
  */
 
 #include "serie.h"
+#include "formateador.h"
 #include <iostream>
-#include <iomanip>
 
-Serie::Serie(const std::string& id, const std::string& nombre, double duracion, const std::string& genero)
-    : Video(id, nombre, duracion, genero) {}
+Serie::Serie(std::string_view id, std::string_view nombre, double duracion, std::string_view genero,
+             std::pmr::memory_resource* recurso)
+    : Video(id, nombre, duracion, genero, TipoContenido::Serie, recurso), episodios(recurso) {}
 
-void Serie::AgregarEpisodio(const Episodio& episodio) {
+Episodio& Serie::AgregarEpisodio(const Episodio& episodio) {
     episodios.push_back(episodio);
+    return episodios.back();
 }
 
-const std::vector<Episodio>& Serie::GetEpisodios() const {
+Episodio& Serie::AgregarEpisodio(std::string_view titulo, int temporada) {
+    return episodios.emplace_back(titulo, temporada);
+}
+
+const Serie::ListaEpisodios& Serie::GetEpisodios() const {
     return episodios;
 }
 
-std::vector<Episodio>& Serie::GetEpisodiosMutables() {
+Serie::ListaEpisodios& Serie::GetEpisodiosMutables() {
     return episodios;
 }
 
+std::vector<const Episodio*> Serie::BuscarEpisodiosConCalificacion(double calificacionMinima) const {
+    std::vector<const Episodio*> resultado;
+    for (const auto& ep : episodios) {
+        if (ep.GetCalificacionPromedio() >= calificacionMinima) {
+            resultado.push_back(&ep);
+        }
+    }
+    return resultado;
+}
+
 void Serie::MostrarDatos() const {
-    std::cout << "Tipo: Serie" << std::endl;
-    ImprimirInfoBase();
-    MostrarEpisodios();
+    BufferSalida salida(std::cout);
+    Formateador::EscribirSerie(salida, *this);
 }
 
 void Serie::MostrarEpisodios() const {
-    if (episodios.empty()) {
-        std::cout << "  Esta serie no tiene episodios cargados." << std::endl;
-        return;
-    }
-    std::cout << "  Episodios:" << std::endl;
-    for (const auto& ep : episodios) {
-        ep.MostrarDatos();
-    }
+    BufferSalida salida(std::cout);
+    Formateador::EscribirEpisodios(salida, *this);
 }
 
 void Serie::MostrarEpisodiosConCalificacion(double calificacionMinima) const {
-    std::cout << "Episodios de la serie '" << GetNombre() << "' con calificacion >= "
-              << std::fixed << std::setprecision(1) << calificacionMinima << ":" << std::endl;
-    
-    bool found_episode = false;
-    for (const auto& ep : episodios) {
-        if (ep.GetCalificacionPromedio() >= calificacionMinima) {
-            ep.MostrarDatos();
-            found_episode = true;
-        }
-    }
-    if (!found_episode) {
-        std::cout << "  No se encontraron episodios con esa calificacion." << std::endl;
-    }
-}
\ No newline at end of file
+    BufferSalida salida(std::cout);
+    Formateador::EscribirEpisodiosConCalificacion(salida, *this, BuscarEpisodiosConCalificacion(calificacionMinima), calificacionMinima);
+}
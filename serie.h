@@ -10,8 +10,11 @@
 
 #include "video.h"
 #include "episodio.h"
-#include <vector>
+#include <deque>
+#include <memory_resource>
 #include <string>
+#include <string_view>
+#include <vector>
 
 /**
  * @class Serie
@@ -20,8 +23,19 @@
  * Hereda de Video y gestiona una colección de objetos Episodio.
  */
 class Serie : public Video {
+public:
+    /**
+     * @brief Contenedor de episodios con direcciones estables.
+     *
+     * std::deque reserva por bloques y nunca reubica los elementos existentes al
+     * agregar al final, así que los punteros a episodios guardados en los índices
+     * del servicio siguen siendo válidos después de cada AgregarEpisodio. Los
+     * bloques y los títulos se toman del recurso de memoria de la serie.
+     */
+    using ListaEpisodios = std::pmr::deque<Episodio>;
+
 private:
-    std::vector<Episodio> episodios;
+    ListaEpisodios episodios;
 
 public:
     /**
@@ -30,8 +44,10 @@ public:
      * @param nombre El título de la serie.
      * @param duracion Duración promedio por episodio (o no utilizado).
      * @param genero El género de la serie.
+     * @param recurso El recurso de memoria de los textos y episodios (por defecto, el heap).
      */
-    Serie(const std::string& id, const std::string& nombre, double duracion, const std::string& genero);
+    Serie(std::string_view id, std::string_view nombre, double duracion, std::string_view genero,
+          std::pmr::memory_resource* recurso = std::pmr::get_default_resource());
     
     /**
      * @brief Destructor por defecto.
@@ -41,20 +57,36 @@ public:
     /**
      * @brief Agrega un episodio a la serie.
      * @param episodio El objeto Episodio a agregar.
+     * @return Una referencia al episodio almacenado; su dirección no cambia al agregar más episodios.
+     */
+    Episodio& AgregarEpisodio(const Episodio& episodio);
+
+    /**
+     * @brief Construye un episodio directamente dentro de la serie, sin copias intermedias.
+     * @param titulo El título del episodio.
+     * @param temporada El número de temporada.
+     * @return Una referencia al episodio almacenado; su dirección no cambia al agregar más episodios.
      */
-    void AgregarEpisodio(const Episodio& episodio);
+    Episodio& AgregarEpisodio(std::string_view titulo, int temporada);
 
     /**
-     * @brief Obtiene una referencia constante al vector de episodios.
-     * @return Una referencia al vector de episodios.
+     * @brief Obtiene una referencia constante a los episodios.
+     * @return Una referencia a los episodios.
      */
-    const std::vector<Episodio>& GetEpisodios() const;
+    const ListaEpisodios& GetEpisodios() const;
     
     /**
-     * @brief Obtiene una referencia mutable al vector de episodios.
-     * @return Una referencia mutable al vector de episodios.
+     * @brief Obtiene una referencia mutable a los episodios.
+     * @return Una referencia mutable a los episodios.
+     */
+    ListaEpisodios& GetEpisodiosMutables();
+
+    /**
+     * @brief Busca los episodios que cumplen con una calificación mínima.
+     * @param calificacionMinima La calificación mínima requerida.
+     * @return Punteros a los episodios, en el orden de la serie.
      */
-    std::vector<Episodio>& GetEpisodiosMutables();
+    std::vector<const Episodio*> BuscarEpisodiosConCalificacion(double calificacionMinima) const;
 
     /**
      * @brief Muestra los datos completos de la serie, incluyendo sus episodios.
@@ -75,4 +107,18 @@ public:
     void MostrarEpisodiosConCalificacion(double calificacionMinima) const;
 };
 
+/**
+ * @brief Convierte un video en serie usando su TipoContenido, sin RTTI.
+ * @param video El video.
+ * @return Un puntero a la serie, o nullptr si el video no es una serie.
+ */
+inline const Serie* ComoSerie(const Video& video) {
+    return video.GetTipo() == TipoContenido::Serie ? static_cast<const Serie*>(&video) : nullptr;
+}
+
+/** @copydoc ComoSerie(const Video&) */
+inline Serie* ComoSerie(Video& video) {
+    return video.GetTipo() == TipoContenido::Serie ? static_cast<Serie*>(&video) : nullptr;
+}
+
 #endif // SERIE_H
\ No newline at end of file
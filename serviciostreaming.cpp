@@ -8,42 +8,51 @@
 #include "serviciostreaming.h"
 #include "pelicula.h"
 #include "serie.h"
+#include "archivomapeado.h"
+#include "parsercatalogo.h"
+#include "snapshotcatalogo.h"
+#include "formateador.h"
+#include "buffersalida.h"
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <iomanip>
 #include <algorithm>
 #include <cctype>
+#include <iterator>
+#include <numeric>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 // --- Métodos de Ayuda (Implementación) ---
 
-std::string ServicioStreaming::ToLower(const std::string& str) const {
-    std::string lower_str = str;
-    std::transform(lower_str.begin(), lower_str.end(), lower_str.begin(),
-                   [](unsigned char c){ return std::tolower(c); });
-    return lower_str;
-}
-
-void ServicioStreaming::ParseRatings(Video& video, const std::string& ratingsStr) {
+void ServicioStreaming::ParseRatings(Video& video, const std::string& ratingsStr, ReporteCarga& reporte) {
     if (ratingsStr.empty()) return;
 
-    std::stringstream ss(ratingsStr);
-    std::string rating;
-    while (std::getline(ss, rating, '-')) {
-        try {
-            if (!rating.empty()) { // Ignorar segmentos vacíos (ej. 5--4)
-                int calificacion = std::stoi(rating);
-                video.Calificar(calificacion);
-            }
-        } catch (const std::invalid_argument&) {
-            std::cerr << "Advertencia: Calificacion invalida para "
-                      << (dynamic_cast<Pelicula*>(&video) ? "Pelicula" : "Serie")
-                      << " '" << video.GetNombre() << "': '" << rating << "'" << std::endl;
+    const char* tipo = video.GetTipo() == TipoContenido::Pelicula ? "Pelicula" : "Serie";
+    std::string_view resto = ratingsStr;
+    std::string_view rating;
+    while (ParserCatalogo::SiguienteCalificacion(resto, rating)) {
+        if (rating.empty()) { // Ignorar segmentos vacíos (ej. 5--4)
+            continue;
+        }
+        int calificacion = 0;
+        if (!ParserCatalogo::ParsearCalificacion(rating, calificacion)) {
+            reporte.Registrar(ErrorCarga::CalificacionInvalida, {"Advertencia: Calificacion invalida para ", tipo,
+                                                                 " '", video.GetNombre(), "': '", rating, "'"});
+        } else if (calificacion < AgregadoCalificaciones::kMinima || calificacion > AgregadoCalificaciones::kMaxima) {
+            reporte.Registrar(ErrorCarga::CalificacionFueraDeRango, {"Advertencia: Calificacion fuera de rango para ", tipo,
+                                                                     " '", video.GetNombre(), "': '", rating, "'"});
+        } else {
+            video.Calificar(calificacion);
+            ++reporte.calificaciones;
         }
     }
 }
 
-void ServicioStreaming::ParseEpisodios(Serie& serie, const std::string& episodesStr) {
+void ServicioStreaming::ParseEpisodios(Serie& serie, const std::string& episodesStr, ReporteCarga& reporte) {
     if (episodesStr.empty()) return;
 
     std::stringstream ss(episodesStr);
@@ -52,41 +61,48 @@ void ServicioStreaming::ParseEpisodios(Serie& serie, const std::string& episodes
         std::stringstream ep_ss(episodeData);
         std::string titulo, temporada_str, ratings_str;
 
-        // *** INICIO DE LA CORRECCIÓN ***
-        // Se relaja la condición: solo se requiere título y temporada.
-        // Las calificaciones son opcionales.
-        if (std::getline(ep_ss, titulo, ':') && std::getline(ep_ss, temporada_str, ':'))
-        {
-            // Se lee el resto de la línea para las calificaciones, sin verificar el éxito.
-            std::getline(ep_ss, ratings_str);
-            
-            try {
-                int temporada = std::stoi(temporada_str);
-                Episodio ep(titulo, temporada);
-                
-                std::stringstream rating_ss(ratings_str);
-                std::string rating_val;
-                while(std::getline(rating_ss, rating_val, '-')) {
-                    try {
-                        if (!rating_val.empty()) {
-                           ep.Calificar(std::stoi(rating_val));
-                        }
-                    } catch (const std::invalid_argument&) {
-                        // Ignora la calificación inválida y continúa
-                    }
-                }
-                serie.AgregarEpisodio(ep);
-            } catch (const std::invalid_argument&) {
-                std::cerr << "Advertencia: Temporada invalida para episodio '" << titulo
-                          << "' en '" << serie.GetNombre() << "': '" << temporada_str << "'" << std::endl;
+        // Solo se requiere título y temporada; las calificaciones son opcionales.
+        if (!std::getline(ep_ss, titulo, ':') || !std::getline(ep_ss, temporada_str, ':')) {
+            reporte.Registrar(ErrorCarga::EpisodioIncompleto, {"Advertencia: Episodio sin temporada en '",
+                                                               serie.GetNombre(), "': '", titulo, "'"});
+            continue;
+        }
+        // Se lee el resto de la línea para las calificaciones, sin verificar el éxito.
+        std::getline(ep_ss, ratings_str);
+
+        int temporada = 0;
+        if (!ParserCatalogo::ParsearEntero(temporada_str, temporada)) {
+            reporte.Registrar(ErrorCarga::TemporadaInvalida, {"Advertencia: Temporada invalida para episodio '", titulo,
+                                                              "' en '", serie.GetNombre(), "': '", temporada_str, "'"});
+            continue;
+        }
+
+        Episodio ep(titulo, temporada);
+        std::string_view resto = ratings_str;
+        std::string_view rating;
+        while (ParserCatalogo::SiguienteCalificacion(resto, rating)) {
+            int calificacion = 0;
+            if (rating.empty()) {
+                continue;
+            }
+            if (!ParserCatalogo::ParsearCalificacion(rating, calificacion)) {
+                reporte.Registrar(ErrorCarga::CalificacionEpisodioInvalida, {"Advertencia: Calificacion invalida para episodio '",
+                                                                             titulo, "' en '", serie.GetNombre(), "': '", rating, "'"});
+            } else if (calificacion < AgregadoCalificaciones::kMinima || calificacion > AgregadoCalificaciones::kMaxima) {
+                reporte.Registrar(ErrorCarga::CalificacionFueraDeRango, {"Advertencia: Calificacion fuera de rango para episodio '",
+                                                                         titulo, "' en '", serie.GetNombre(), "': '", rating, "'"});
+            } else {
+                ep.Calificar(calificacion);
+                ++reporte.calificaciones;
             }
         }
-        // *** FIN DE LA CORRECCIÓN ***
+        serie.AgregarEpisodio(ep);
+        ++reporte.episodios;
     }
 }
 
 
-void ServicioStreaming::ParsePeliculaLine(const std::string& line) {
+void ServicioStreaming::ParsePeliculaLine(Catalogo& destino, const std::string& line, ReporteCarga& reporte) {
     std::stringstream ss(line);
     std::string id, nombre, genero, ratingsStr;
     std::string duracionStr;
@@ -98,19 +114,18 @@ void ServicioStreaming::ParsePeliculaLine(const std::string& line) {
     std::getline(ss, genero, ',');
     std::getline(ss, ratingsStr);
 
-    try {
-        duracion = std::stod(duracionStr);
-    } catch (const std::invalid_argument&) {
-        std::cerr << "Advertencia: Duracion invalida en la linea: Pelicula," << line << std::endl;
+    if (!ParserCatalogo::ParsearDecimal(duracionStr, duracion)) {
+        reporte.Registrar(ErrorCarga::DuracionInvalida, {"Advertencia: Duracion invalida en la linea: Pelicula,", line});
         return;
     }
 
-    auto pelicula = std::make_unique<Pelicula>(id, nombre, duracion, genero);
-    ParseRatings(*pelicula, ratingsStr);
-    videos.push_back(std::move(pelicula));
+    PtrVideo pelicula = CrearVideo<Pelicula>(destino.GetArena(), id, nombre, duracion, genero);
+    ++reporte.peliculas;
+    ParseRatings(*pelicula, ratingsStr, reporte);
+    destino.GetVideosMutables().push_back(std::move(pelicula));
 }
 
-void ServicioStreaming::ParseSerieLine(const std::string& line) {
+void ServicioStreaming::ParseSerieLine(Catalogo& destino, const std::string& line, ReporteCarga& reporte) {
     std::stringstream ss(line);
     std::string id, nombre, genero, seriesData, episodesStr;
     std::string duracionStr, ratingsStr;
@@ -132,129 +147,510 @@ void ServicioStreaming::ParseSerieLine(const std::string& line) {
         ratingsStr = restOfLine;
     }
     
-    try {
-        duracion = std::stod(duracionStr);
-    } catch (const std::invalid_argument&) {
+    if (!ParserCatalogo::ParsearDecimal(duracionStr, duracion)) {
         duracion = 0.0;
+        reporte.Registrar(ErrorCarga::DuracionSerieInvalida, {"Advertencia: Duracion invalida para Serie '", nombre,
+                                                              "': '", duracionStr, "'"});
     }
 
-    auto serie = std::make_unique<Serie>(id, nombre, duracion, genero);
-    ParseRatings(*serie, ratingsStr);
-    ParseEpisodios(*serie, episodesStr);
-    videos.push_back(std::move(serie));
+    PtrVideo serie = CrearVideo<Serie>(destino.GetArena(), id, nombre, duracion, genero);
+    ++reporte.series;
+    ParseRatings(*serie, ratingsStr, reporte);
+    ParseEpisodios(static_cast<Serie&>(*serie), episodesStr, reporte);
+    destino.GetVideosMutables().push_back(std::move(serie));
 }
 
-void ServicioStreaming::IndexarContenido() {
-    videosPorTituloLower.clear();
-    episodiosPorTituloLower.clear();
-
-    for (const auto& video : videos) {
-        videosPorTituloLower[ToLower(video->GetNombre())] = video.get();
-        if (Serie* serie = dynamic_cast<Serie*>(video.get())) {
-            for (auto& episodio : serie->GetEpisodiosMutables()) {
-                episodiosPorTituloLower[ToLower(episodio.GetTitulo())] = &episodio;
-            }
-        }
-    }
+std::shared_ptr<Catalogo> ServicioStreaming::GetActual() const {
+    return std::atomic_load(&catalogo);
 }
 
-// --- Métodos Públicos (Implementación) ---
-
-void ServicioStreaming::CargarArchivo(const std::string& nombreArchivo) {
+bool ServicioStreaming::CargarFlujo(const std::string& nombreArchivo, Catalogo& destino, ReporteCarga& reporte) {
+    using Reloj = ReporteCarga::Reloj;
+    Reloj::time_point antes = Reloj::now();
     std::ifstream archivo(nombreArchivo);
     if (!archivo.is_open()) {
         std::cerr << "Error: No se pudo abrir el archivo " << nombreArchivo << std::endl;
-        return;
+        return false;
     }
 
-    videos.clear();
+    // Lectura y parseo se alternan línea por línea: cada marca de tiempo cierra una fase y abre la otra
     std::string linea;
     while (std::getline(archivo, linea)) {
-        if (linea.empty() || linea == "\r") { // Ignorar líneas vacías
-            continue;
+        const Reloj::time_point leida = Reloj::now();
+        reporte.tiempos.lectura += ReporteCarga::Milisegundos(leida - antes);
+        reporte.bytes += linea.size() + (archivo.eof() ? 0 : 1); // La última línea puede no tener salto
+        ++reporte.lineas;
+        bool esSerie = false;
+        if (!linea.empty() && linea != "\r") { // Ignorar líneas vacías
+            std::stringstream ss(linea);
+            std::string tipo;
+            std::getline(ss, tipo, ',');
+
+            std::string restoDeLinea;
+            std::getline(ss, restoDeLinea);
+
+            TipoContenido tipoContenido;
+            if (!ParserCatalogo::ParsearTipo(tipo, tipoContenido)) {
+                reporte.Registrar(ErrorCarga::TipoDesconocido, {"Advertencia: Tipo de video desconocido '", tipo, "'"});
+            } else if (tipoContenido == TipoContenido::Pelicula) {
+                ParsePeliculaLine(destino, restoDeLinea, reporte);
+            } else {
+                ParseSerieLine(destino, restoDeLinea, reporte);
+                esSerie = true;
+            }
         }
+        antes = Reloj::now();
+        const double milisegundos = ReporteCarga::Milisegundos(antes - leida);
+        reporte.tiempos.parseo += milisegundos;
+        if (esSerie) {
+            reporte.tiempos.parseoSeries += milisegundos;
+        }
+    }
+    return true;
+}
 
-        std::stringstream ss(linea);
-        std::string tipo;
-        std::getline(ss, tipo, ',');
+bool ServicioStreaming::CargarMapeado(const std::string& nombreArchivo, Catalogo& destino, ReporteCarga& reporte) {
+    using Reloj = ReporteCarga::Reloj;
+    const Reloj::time_point inicio = Reloj::now();
+    ArchivoMapeado archivo(nombreArchivo);
+    if (!archivo.EstaAbierto()) {
+        std::cerr << "Error: No se pudo abrir el archivo " << nombreArchivo << std::endl;
+        return false;
+    }
+    reporte.bytes = archivo.GetContenido().size();
+    const Reloj::time_point leido = Reloj::now();
+    reporte.tiempos.lectura = ReporteCarga::Milisegundos(leido - inicio);
+
+    ParserCatalogo parser(reporte, destino.GetArena());
+    parser.ParsearTexto(archivo.GetContenido(), destino.GetVideosMutables());
+    reporte.tiempos.parseo = ReporteCarga::Milisegundos(Reloj::now() - leido);
+    return true;
+}
 
-        std::string restoDeLinea;
-        std::getline(ss, restoDeLinea);
+bool ServicioStreaming::CargarParalelo(const std::string& nombreArchivo, unsigned hilos, Catalogo& destino,
+                                       ReporteCarga& reporte) {
+    using Reloj = ReporteCarga::Reloj;
+    const Reloj::time_point inicio = Reloj::now();
+    ArchivoMapeado archivo(nombreArchivo);
+    if (!archivo.EstaAbierto()) {
+        std::cerr << "Error: No se pudo abrir el archivo " << nombreArchivo << std::endl;
+        return false;
+    }
+    const Reloj::time_point leido = Reloj::now();
+    reporte.tiempos.lectura = ReporteCarga::Milisegundos(leido - inicio);
+
+    // Evita lanzar hilos para bloques tan pequeños que no compensan su costo
+    const std::size_t kTamanoMinimoBloque = 256 * 1024;
+    std::string_view contenido = archivo.GetContenido();
+    if (hilos == 0) {
+        hilos = std::max(1u, std::thread::hardware_concurrency());
+    }
+    std::size_t partes = std::min<std::size_t>(hilos, contenido.size() / kTamanoMinimoBloque + 1);
+    std::vector<std::string_view> bloques = ParserCatalogo::DividirEnBloques(contenido, partes);
+    reporte.bytes = contenido.size();
+    reporte.hilos = static_cast<unsigned>(bloques.size());
+
+    // Cada hilo parsea su bloque en un vector y un reporte propios.
+    // Las arenas se crean antes de lanzar los hilos: monotonic_buffer_resource no es seguro entre hilos
+    std::vector<std::pmr::memory_resource*> arenasBloques;
+    for (std::size_t i = 0; i < bloques.size(); ++i) {
+        arenasBloques.push_back(destino.NuevaArena());
+    }
+    std::vector<std::vector<PtrVideo>> parciales(bloques.size());
+    std::vector<ReporteCarga> reportes(bloques.size());
+    std::vector<std::thread> trabajadores;
+    trabajadores.reserve(bloques.size());
+    for (std::size_t i = 0; i < bloques.size(); ++i) {
+        trabajadores.emplace_back([&, i]() {
+            ParserCatalogo parser(reportes[i], arenasBloques[i]);
+            parser.ParsearTexto(bloques[i], parciales[i]);
+        });
+    }
+    for (auto& trabajador : trabajadores) {
+        trabajador.join();
+    }
+
+    // Se unen los resultados (y los números de línea de los reportes) en el orden original del archivo
+    std::vector<PtrVideo>& videos = destino.GetVideosMutables();
+    std::size_t total = 0;
+    for (const auto& parcial : parciales) {
+        total += parcial.size();
+    }
+    videos.reserve(total);
+    for (std::size_t i = 0; i < parciales.size(); ++i) {
+        reporte.Combinar(reportes[i]);
+        std::move(parciales[i].begin(), parciales[i].end(), std::back_inserter(videos));
+    }
+    reporte.tiempos.parseo = ReporteCarga::Milisegundos(Reloj::now() - leido);
+    return true;
+}
 
-        if (tipo == "Pelicula") {
-            ParsePeliculaLine(restoDeLinea);
-        } else if (tipo == "Serie") {
-            ParseSerieLine(restoDeLinea);
+bool ServicioStreaming::CargarSnapshot(const std::string& nombreArchivo, Catalogo& destino, ReporteCarga& reporte) {
+    using Reloj = ReporteCarga::Reloj;
+    const Reloj::time_point inicio = Reloj::now();
+    ArchivoMapeado archivo(nombreArchivo);
+    if (!archivo.EstaAbierto()) {
+        std::cerr << "Error: No se pudo abrir el archivo " << nombreArchivo << std::endl;
+        return false;
+    }
+    reporte.bytes = archivo.GetContenido().size();
+    const Reloj::time_point leido = Reloj::now();
+    reporte.tiempos.lectura = ReporteCarga::Milisegundos(leido - inicio);
+
+    // El catálogo actual solo se reemplaza si el snapshot es válido
+    if (!SnapshotCatalogo::Leer(archivo.GetContenido(), destino.GetVideosMutables(), destino.GetArena())) {
+        std::cerr << "Error: El archivo " << nombreArchivo << " no es un snapshot valido (version esperada "
+                  << SnapshotCatalogo::kVersion << ")" << std::endl;
+        return false;
+    }
+    // El snapshot no tiene líneas ni datos inválidos; los totales se cuentan sobre los videos leídos
+    for (const auto& video : destino.GetVideos()) {
+        if (const Serie* serie = ComoSerie(*video)) {
+            ++reporte.series;
+            reporte.episodios += serie->GetEpisodios().size();
+            for (const Episodio& episodio : serie->GetEpisodios()) {
+                reporte.calificaciones += episodio.GetCalificaciones().GetConteo();
+            }
         } else {
-             std::cerr << "Advertencia: Tipo de video desconocido '" << tipo << "'" << std::endl;
+            ++reporte.peliculas;
         }
+        reporte.calificaciones += video->GetCalificaciones().GetConteo();
+    }
+    reporte.tiempos.parseo = ReporteCarga::Milisegundos(Reloj::now() - leido);
+
+    // Mientras el archivo sigue proyectado: sus índices se copian en lugar de construirse
+    reporte.indicesRestaurados = destino.RestaurarIndices(SnapshotCatalogo::SeccionIndices(archivo.GetContenido()),
+                                                          reporte.tiempos.indices);
+    if (!reporte.indicesRestaurados) {
+        reporte.tiempos.indices = destino.Indexar();
     }
-    IndexarContenido();
-    std::cout << "Datos cargados exitosamente. Total de videos: " << videos.size() << std::endl;
+    return true;
 }
 
-void ServicioStreaming::CalificarVideo(const std::string& titulo, int calificacion) {
-    std::string tituloLower = ToLower(titulo);
+// --- Métodos Públicos (Implementación) ---
 
-    auto it_ep = episodiosPorTituloLower.find(tituloLower);
-    if (it_ep != episodiosPorTituloLower.end()) {
-        it_ep->second->Calificar(calificacion);
-        std::cout << "Episodio '" << it_ep->second->GetTitulo() << "' calificado. Nueva calificacion promedio: " << std::fixed << std::setprecision(1) << it_ep->second->GetCalificacionPromedio() << std::endl;
+ReporteCarga ServicioStreaming::CargarArchivo(const std::string& nombreArchivo, ModoCarga modo, unsigned hilos) {
+    using Reloj = ReporteCarga::Reloj;
+    std::lock_guard<std::mutex> bloqueo(mutexCarga);
+    const Reloj::time_point inicio = Reloj::now();
+    // El catálogo nuevo se construye aparte; las consultas siguen usando el actual
+    auto nuevo = std::make_shared<Catalogo>(indiceGlobalEpisodios.load());
+    ReporteCarga reporte;
+    reporte.archivo = nombreArchivo;
+    switch (modo) {
+        case ModoCarga::Mapeado:
+            reporte.modo = "mapeado";
+            reporte.cargado = CargarMapeado(nombreArchivo, *nuevo, reporte);
+            break;
+        case ModoCarga::Paralelo:
+            reporte.modo = "paralelo";
+            reporte.cargado = CargarParalelo(nombreArchivo, hilos, *nuevo, reporte);
+            break;
+        case ModoCarga::Snapshot:
+            reporte.modo = "snapshot";
+            reporte.cargado = CargarSnapshot(nombreArchivo, *nuevo, reporte);
+            break;
+        default:
+            reporte.modo = "flujo";
+            reporte.cargado = CargarFlujo(nombreArchivo, *nuevo, reporte);
+            break;
+    }
+    if (reporte.cargado) {
+        reporte.EscribirAdvertencias(std::cerr);
+        if (modo != ModoCarga::Snapshot) { // El snapshot ya trae (o construyó) sus índices
+            reporte.tiempos.indices = nuevo->Indexar();
+        }
+        const std::size_t total = nuevo->GetTamano();
+        // Publicación: un único intercambio atómico. La versión anterior se libera aquí o,
+        // si alguna consulta la sigue usando, cuando esta termine
+        const Reloj::time_point publicacion = Reloj::now();
+        std::atomic_store(&catalogo, std::move(nuevo));
+        reporte.tiempos.publicacion = ReporteCarga::Milisegundos(Reloj::now() - publicacion);
+        std::cout << "Datos cargados exitosamente. Total de videos: " << total << std::endl;
+    }
+    reporte.memoriaPicoKb = ReporteCarga::LeerMemoriaPicoKb();
+    reporte.tiempos.total = ReporteCarga::Milisegundos(Reloj::now() - inicio);
+    if (!registroCarga.empty()) {
+        // Una línea JSON por carga, agregada al final: el archivo acumula el historial
+        std::ofstream registro(registroCarga, std::ios::app);
+        reporte.EscribirJson(registro);
+        registro << '\n';
+        if (!registro) {
+            std::cerr << "Error: No se pudo escribir el registro de carga " << registroCarga << std::endl;
+        }
+    }
+    return reporte;
+}
+
+void ServicioStreaming::SetRegistroCarga(const std::string& nombreArchivo) {
+    std::lock_guard<std::mutex> bloqueo(mutexCarga);
+    registroCarga = nombreArchivo;
+}
+
+void ServicioStreaming::CalificarVideo(const std::string& titulo, int calificacion) {
+    std::shared_ptr<Catalogo> actual = GetActual();
+    if (Episodio* episodio = actual->BuscarEpisodio(titulo)) {
+        if (!episodio->Calificar(calificacion)) {
+            std::cout << "Episodio '" << episodio->GetTitulo() << "': calificacion " << calificacion << " rechazada." << std::endl;
+            return;
+        }
+        std::cout << "Episodio '" << episodio->GetTitulo() << "' calificado. Nueva calificacion promedio: " << std::fixed << std::setprecision(1) << episodio->GetCalificacionPromedio() << std::endl;
         return;
     }
 
-    auto it_vid = videosPorTituloLower.find(tituloLower);
-    if (it_vid != videosPorTituloLower.end()) {
-        it_vid->second->Calificar(calificacion);
-        std::cout << "Video '" << it_vid->second->GetNombre() << "' calificado. Nueva calificacion promedio: " << std::fixed << std::setprecision(1) << it_vid->second->GetCalificacionPromedio() << std::endl;
+    const std::size_t indice = actual->BuscarPosicion(titulo);
+    if (indice != Catalogo::kNoEncontrado) {
+        Video& video = actual->GetVideo(indice);
+        if (!video.Calificar(calificacion)) {
+            std::cout << "Video '" << video.GetNombre() << "': calificacion " << calificacion << " rechazada." << std::endl;
+            return;
+        }
+        actual->ActualizarIndicesDeVideo(indice);
+        std::cout << "Video '" << video.GetNombre() << "' calificado. Nueva calificacion promedio: " << std::fixed << std::setprecision(1) << video.GetCalificacionPromedio() << std::endl;
         return;
     }
 
     std::cout << "Video o episodio '" << titulo << "' no encontrado." << std::endl;
+    BufferSalida salida(std::cout);
+    Formateador::EscribirSugerencias(salida, actual->BuscarTitulos(titulo, kSugerencias));
 }
 
+bool ServicioStreaming::AgregarEpisodio(const std::string& tituloSerie, const Episodio& episodio) {
+    return GetActual()->AgregarEpisodio(tituloSerie, episodio);
+}
 
-void ServicioStreaming::MostrarVideosPorCalificacionOGenero(double calificacionMinima, const std::string& genero) {
-    bool found = false;
-    std::string generoLower = ToLower(genero);
+ResultadoLote ServicioStreaming::CalificarLote(const std::vector<EventoCalificacion>& eventos) {
+    // Calificaciones pendientes por destino: episodio, o video (por posición en el catálogo)
+    struct Pendiente {
+        Episodio* episodio;
+        std::size_t indiceVideo;
+        AgregadoCalificaciones::Frecuencias conteos;
+    };
+    std::shared_ptr<Catalogo> actual = GetActual();
+    std::vector<Pendiente> pendientes;
+    std::unordered_map<const void*, std::size_t> posicionPorDestino;
+    posicionPorDestino.reserve(std::min<std::size_t>(eventos.size(), actual->GetTamano()));
+    ResultadoLote resultado;
+
+    for (const auto& evento : eventos) {
+        if (evento.calificacion < AgregadoCalificaciones::kMinima || evento.calificacion > AgregadoCalificaciones::kMaxima) {
+            ++resultado.invalidas;
+            continue;
+        }
+        Episodio* episodio = nullptr;
+        std::size_t indiceVideo = 0;
+        const void* destino = nullptr;
+        if (Episodio* encontrado = actual->BuscarEpisodio(evento.titulo)) {
+            episodio = encontrado;
+            destino = episodio;
+        } else if ((indiceVideo = actual->BuscarPosicion(evento.titulo)) != Catalogo::kNoEncontrado) {
+            destino = &actual->GetVideo(indiceVideo);
+        } else {
+            ++resultado.noEncontradas;
+            continue;
+        }
 
-    for (const auto& video : videos) {
-        bool calificacionOk = video->GetCalificacionPromedio() >= calificacionMinima;
-        bool generoOk = genero.empty() || ToLower(video->GetGenero()) == generoLower;
+        auto it = posicionPorDestino.find(destino);
+        if (it == posicionPorDestino.end()) {
+            it = posicionPorDestino.emplace(destino, pendientes.size()).first;
+            pendientes.push_back({episodio, indiceVideo, {}});
+        }
+        ++pendientes[it->second].conteos[evento.calificacion - AgregadoCalificaciones::kMinima];
+    }
 
-        if (calificacionOk && generoOk) {
-            video->MostrarDatos();
-            std::cout << "--------------------" << std::endl;
-            found = true;
+    // Cada grupo se aplica en una sola operación; si desbordaría el agregado, se rechaza entero
+    for (const auto& pendiente : pendientes) {
+        const std::uint64_t veces = std::accumulate(pendiente.conteos.begin(), pendiente.conteos.end(), std::uint64_t{0});
+        const bool aplicado = pendiente.episodio != nullptr
+            ? pendiente.episodio->Calificar(pendiente.conteos)
+            : actual->GetVideo(pendiente.indiceVideo).Calificar(pendiente.conteos);
+        if (!aplicado) {
+            resultado.rechazadas += veces;
+            continue;
+        }
+        resultado.aplicadas += veces;
+        ++resultado.titulosAfectados;
+        if (pendiente.episodio == nullptr) {
+            actual->ActualizarIndicesDeVideo(pendiente.indiceVideo);
         }
     }
-    if (!found) {
-        std::cout << "No se encontraron videos con los criterios especificados." << std::endl;
+    return resultado;
+}
+
+bool ServicioStreaming::CalificarEpisodio(const std::string& serieId, int temporada, const std::string& titulo, int calificacion) {
+    Episodio* episodio = GetActual()->BuscarEpisodio(serieId, temporada, titulo);
+    if (episodio == nullptr) {
+        std::cout << "Episodio '" << titulo << "' (temporada " << temporada << ") de la serie '" << serieId << "' no encontrado." << std::endl;
+        return false;
+    }
+    if (!episodio->Calificar(calificacion)) {
+        std::cout << "Episodio '" << episodio->GetTitulo() << "': calificacion " << calificacion << " rechazada." << std::endl;
+        return false;
+    }
+    std::cout << "Episodio '" << episodio->GetTitulo() << "' calificado. Nueva calificacion promedio: " << std::fixed << std::setprecision(1) << episodio->GetCalificacionPromedio() << std::endl;
+    return true;
+}
+
+void ServicioStreaming::SetIndiceGlobalEpisodios(bool activo) {
+    indiceGlobalEpisodios = activo;
+    if (!activo) {
+        GetActual()->DesactivarIndiceGlobalEpisodios();
+    }
+}
+
+std::vector<const Video*> ServicioStreaming::BuscarVideos(double calificacionMinima, const std::string& genero) const {
+    return GetActual()->BuscarVideos(calificacionMinima, genero);
+}
+
+std::vector<const Video*> ServicioStreaming::BuscarPeliculas(double calificacionMinima) const {
+    return GetActual()->BuscarPeliculas(calificacionMinima);
+}
+
+const Serie* ServicioStreaming::BuscarSerie(const std::string& tituloSerie) const {
+    return GetActual()->BuscarSerie(tituloSerie);
+}
+
+std::vector<const Episodio*> ServicioStreaming::BuscarEpisodiosDeSerie(const std::string& tituloSerie, double calificacionMinima) const {
+    return GetActual()->BuscarEpisodiosDeSerie(tituloSerie, calificacionMinima);
+}
+
+std::vector<const Video*> ServicioStreaming::BuscarTitulos(const std::string& texto, std::size_t limite) const {
+    return GetActual()->BuscarTitulos(texto, limite);
+}
+
+std::vector<ResultadoTexto> ServicioStreaming::BuscarTexto(const std::string& consulta) const {
+    return GetActual()->BuscarTexto(consulta);
+}
+
+ResumenFlujo ServicioStreaming::FiltrarArchivo(const std::string& nombreArchivo, const CriterioFlujo& criterio,
+                                               const FiltroFlujo::Consumidor& consumidor) const {
+    std::ifstream archivo(nombreArchivo, std::ios::binary);
+    if (!archivo.is_open()) {
+        std::cerr << "Error: No se pudo abrir el archivo " << nombreArchivo << std::endl;
+        return ResumenFlujo();
+    }
+    FiltroFlujo filtro(criterio, std::cerr);
+    return filtro.Procesar(archivo, consumidor);
+}
+
+std::vector<PosicionRanking> ServicioStreaming::TopK(std::size_t k, const std::string& genero, TipoRanking tipo) const {
+    return GetActual()->TopK(k, genero, tipo);
+}
+
+void ServicioStreaming::MostrarVideosPorCalificacionOGenero(double calificacionMinima, const std::string& genero) {
+    // La referencia mantiene vivos los resultados aunque otro hilo recargue el catálogo
+    std::shared_ptr<Catalogo> actual = GetActual();
+    std::vector<const Video*> resultados = actual->BuscarVideos(calificacionMinima, genero);
+    auto bloqueo = actual->BloquearEstructura();
+    BufferSalida salida(std::cout);
+    Formateador::EscribirVideos(salida, resultados);
+    if (resultados.empty()) {
+        salida.Agregar("No se encontraron videos con los criterios especificados.\n");
     }
 }
 
 void ServicioStreaming::MostrarEpisodiosDeSerieConCalificacion(const std::string& tituloSerie, double calificacionMinima) {
-    auto it = videosPorTituloLower.find(ToLower(tituloSerie));
-    if (it != videosPorTituloLower.end()) {
-        if (Serie* serie = dynamic_cast<Serie*>(it->second)) {
-            std::cout << "Episodios de la serie '" << serie->GetNombre() << "' con calificacion >= " << calificacionMinima << ":" << std::endl;
-            serie->MostrarEpisodiosConCalificacion(calificacionMinima);
-            return;
+    std::shared_ptr<Catalogo> actual = GetActual();
+    BufferSalida salida(std::cout);
+    const Serie* serie = actual->BuscarSerie(tituloSerie);
+    if (serie == nullptr) {
+        salida.Agregar("Serie '").Agregar(tituloSerie).Agregar("' no encontrada.\n");
+        // Solo se sugieren series: se buscan más candidatos para descartar las películas
+        std::vector<const Video*> series;
+        for (const Video* video : actual->BuscarTitulos(tituloSerie, 4 * kSugerencias)) {
+            if (video->GetTipo() == TipoContenido::Serie && series.size() < kSugerencias) {
+                series.push_back(video);
+            }
         }
+        Formateador::EscribirSugerencias(salida, series);
+        return;
     }
-    std::cout << "Serie '" << tituloSerie << "' no encontrada." << std::endl;
+    auto bloqueo = actual->BloquearEstructura();
+    salida.Agregar("Episodios de la serie '").Agregar(serie->GetNombre()).Agregar("' con calificacion >= ")
+          .AgregarDecimal(calificacionMinima).Agregar(":\n");
+    Formateador::EscribirEpisodiosConCalificacion(salida, *serie, serie->BuscarEpisodiosConCalificacion(calificacionMinima), calificacionMinima);
 }
 
 void ServicioStreaming::MostrarPeliculasConCalificacion(double calificacionMinima) {
-    bool found = false;
-    for (const auto& video : videos) {
-        if (dynamic_cast<Pelicula*>(video.get()) && video->GetCalificacionPromedio() >= calificacionMinima) {
-            video->MostrarDatos();
-            std::cout << "--------------------" << std::endl;
-            found = true;
-        }
+    std::shared_ptr<Catalogo> actual = GetActual();
+    std::vector<const Video*> resultados = actual->BuscarPeliculas(calificacionMinima);
+    auto bloqueo = actual->BloquearEstructura();
+    BufferSalida salida(std::cout);
+    Formateador::EscribirVideos(salida, resultados);
+    if (resultados.empty()) {
+        salida.Agregar("No se encontraron peliculas con calificacion >= ").AgregarDecimal(calificacionMinima, 1).Agregar(".\n");
+    }
+}
+
+void ServicioStreaming::MostrarTopK(std::size_t k, const std::string& genero, TipoRanking tipo) {
+    std::shared_ptr<Catalogo> actual = GetActual();
+    std::vector<PosicionRanking> posiciones = actual->TopK(k, genero, tipo);
+    BufferSalida salida(std::cout);
+    Formateador::EscribirRanking(salida, posiciones);
+    if (posiciones.empty()) {
+        salida.Agregar("No se encontraron contenidos para el ranking.\n");
     }
-    if (!found) {
-        std::cout << "No se encontraron peliculas con calificacion >= " << std::fixed << std::setprecision(1) << calificacionMinima << "." << std::endl;
+}
+
+void ServicioStreaming::MostrarBusquedaTexto(const std::string& consulta) {
+    std::shared_ptr<Catalogo> actual = GetActual();
+    std::vector<ResultadoTexto> resultados = actual->BuscarTexto(consulta);
+    BufferSalida salida(std::cout);
+    Formateador::EscribirResultadosTexto(salida, resultados);
+    if (resultados.empty()) {
+        salida.Agregar("No se encontraron contenidos para la consulta.\n");
     }
-}
\ No newline at end of file
+}
+
+void ServicioStreaming::MostrarFiltroArchivo(const std::string& nombreArchivo, const CriterioFlujo& criterio) {
+    // Cada video se escribe al encontrarlo; el búfer solo agrupa las escrituras en bloques
+    BufferSalida salida(std::cout);
+    ResumenFlujo resumen = FiltrarArchivo(nombreArchivo, criterio, [&](const Video& video) {
+        Formateador::EscribirVideo(salida, video);
+        salida.Agregar("--------------------\n");
+    });
+    if (resumen.abierto && resumen.coincidencias == 0) {
+        salida.Agregar("No se encontraron videos con los criterios especificados.\n");
+    }
+}
+
+bool ServicioStreaming::GuardarSnapshot(const std::string& nombreArchivo) const {
+    std::shared_ptr<Catalogo> actual = GetActual();
+    auto bloqueo = actual->BloquearEstructura();
+    const bool guardado = SnapshotCatalogo::Guardar(nombreArchivo, actual->GetVideos(), [&actual](EscritorSnapshot& salida) {
+        actual->GuardarIndices(salida);
+    });
+    if (!guardado) {
+        std::cerr << "Error: No se pudo escribir el snapshot " << nombreArchivo << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool ServicioStreaming::ExportarCatalogo(const std::string& nombreArchivo) const {
+    std::ofstream archivo(nombreArchivo, std::ios::binary);
+    if (!archivo.is_open()) {
+        std::cerr << "Error: No se pudo crear el archivo " << nombreArchivo << std::endl;
+        return false;
+    }
+    std::shared_ptr<Catalogo> actual = GetActual();
+    auto bloqueo = actual->BloquearEstructura();
+    std::vector<const Video*> todos;
+    todos.reserve(actual->GetTamano());
+    for (const auto& video : actual->GetVideos()) {
+        todos.push_back(video.get());
+    }
+    {
+        BufferSalida salida(archivo, kBloqueExportacion);
+        Formateador::EscribirVideos(salida, todos);
+    }
+    return static_cast<bool>(archivo);
+}
+
+std::shared_ptr<const Catalogo> ServicioStreaming::GetCatalogo() const {
+    return GetActual();
+}
+
+std::size_t ServicioStreaming::GetNumeroArenas() const {
+    return GetActual()->GetNumeroArenas();
+}
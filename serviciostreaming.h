@@ -10,31 +10,89 @@
 
 #include "video.h"
 #include "serie.h"
+#include "catalogo.h"
+#include "filtroflujo.h"
+#include "reportecarga.h"
+#include <atomic>
+#include <cstddef>
 #include <vector>
 #include <memory>
+#include <mutex>
 #include <string>
-#include <map>
+#include <string_view>
+
+/**
+ * @enum ModoCarga
+ * @brief Estrategia de lectura usada por ServicioStreaming::CargarArchivo.
+ */
+enum class ModoCarga {
+    Flujo,   ///< Lectura línea por línea con std::getline y std::stringstream.
+    Mapeado, ///< Proyección del archivo con mmap y tokenizado sin copias (std::string_view).
+    Paralelo, ///< Como Mapeado, pero parseando bloques del archivo en varios hilos.
+    Snapshot  ///< Snapshot binario escrito por ServicioStreaming::GuardarSnapshot (ver SnapshotCatalogo).
+};
+
+/**
+ * @struct EventoCalificacion
+ * @brief Una calificación recibida del flujo de eventos, para CalificarLote.
+ *
+ * El título es una vista: el texto debe seguir vivo mientras dure la llamada.
+ */
+struct EventoCalificacion {
+    std::string_view titulo; ///< Título del video o episodio (no sensible a mayúsculas/minúsculas).
+    int calificacion;        ///< Calificación de 1 a 5.
+};
+
+/**
+ * @struct ResultadoLote
+ * @brief Resumen de la aplicación de un lote de calificaciones.
+ */
+struct ResultadoLote {
+    std::size_t aplicadas = 0;       ///< Eventos aplicados a un video o episodio.
+    std::size_t invalidas = 0;       ///< Eventos con calificación fuera de 1-5.
+    std::size_t noEncontradas = 0;   ///< Eventos cuyo título no existe en el catálogo.
+    std::size_t rechazadas = 0;      ///< Eventos válidos descartados porque el título alcanzó AgregadoCalificaciones::kConteoMaximo.
+    std::size_t titulosAfectados = 0; ///< Videos y episodios distintos que recibieron calificaciones.
+};
 
 /**
  * @class ServicioStreaming
  * @brief Gestiona el catálogo de videos y las interacciones del usuario.
+ *
+ * Concurrencia: todos los métodos pueden llamarse desde varios hilos a la vez.
+ * Las calificaciones se acumulan en atómicos sin bloqueos, y los promedios de las
+ * columnas de filtrado también son atómicos. Solo el orden por calificación toma
+ * brevemente el cerrojo de la tabla del género y tipo del video calificado, así que
+ * una calificación no detiene las consultas de otras tablas ni los filtros.
+ *
+ * Recarga sin interrupciones: CargarArchivo construye un Catalogo nuevo aparte,
+ * mientras las consultas siguen respondiendo con el anterior, y lo publica con
+ * un único intercambio atómico. Si la carga falla, el catálogo actual se
+ * conserva. La versión anterior se libera en cuanto termina la última consulta
+ * que la estaba usando. Las calificaciones que lleguen durante la carga se
+ * aplican a la versión anterior y no pasan a la nueva.
  */
 class ServicioStreaming {
 private:
-    std::vector<std::unique_ptr<Video>> videos;
-    // Mapas para búsqueda rápida y sensible a mayúsculas/minúsculas
-    std::map<std::string, Video*> videosPorTituloLower;
-    std::map<std::string, Episodio*> episodiosPorTituloLower;
+    // Catálogo publicado. Se lee y se reemplaza solo con std::atomic_load y std::atomic_store:
+    // cada consulta toma una referencia y la versión anterior se libera al soltar la última
+    std::shared_ptr<Catalogo> catalogo = std::make_shared<Catalogo>();
+    std::mutex mutexCarga; // Serializa las cargas (solo una construye un catálogo nuevo a la vez)
+    std::string registroCarga; // Archivo donde se agrega el reporte JSON de cada carga (vacío = no se registra); protegido por mutexCarga
+    std::atomic<bool> indiceGlobalEpisodios{true};
 
     // --- Métodos de Ayuda para Parseo ---
-    void ParsePeliculaLine(const std::string& line);
-    void ParseSerieLine(const std::string& line);
-    void ParseRatings(Video& video, const std::string& ratingsStr);
-    void ParseEpisodios(Serie& serie, const std::string& episodesStr);
+    void ParsePeliculaLine(Catalogo& destino, const std::string& line, ReporteCarga& reporte);
+    void ParseSerieLine(Catalogo& destino, const std::string& line, ReporteCarga& reporte);
+    void ParseRatings(Video& video, const std::string& ratingsStr, ReporteCarga& reporte);
+    void ParseEpisodios(Serie& serie, const std::string& episodesStr, ReporteCarga& reporte);
 
-    // Método de utilidad
-    std::string ToLower(const std::string& str) const;
-    void IndexarContenido();
+    // Métodos de utilidad
+    std::shared_ptr<Catalogo> GetActual() const;
+    bool CargarFlujo(const std::string& nombreArchivo, Catalogo& destino, ReporteCarga& reporte);
+    bool CargarMapeado(const std::string& nombreArchivo, Catalogo& destino, ReporteCarga& reporte);
+    bool CargarParalelo(const std::string& nombreArchivo, unsigned hilos, Catalogo& destino, ReporteCarga& reporte);
+    bool CargarSnapshot(const std::string& nombreArchivo, Catalogo& destino, ReporteCarga& reporte);
 
 public:
     ServicioStreaming() = default;
@@ -42,17 +100,181 @@ public:
 
     /**
      * @brief Carga y procesa un archivo de datos para poblar el catálogo.
+     *
+     * Los datos inválidos no detienen la carga: se descartan y se cuentan en el reporte.
+     * Las advertencias de la muestra del reporte se escriben en std::cerr (ver
+     * ReporteCarga::EscribirAdvertencias). El reporte también mide cada fase (lectura,
+     * parseo, índices y publicación), los bytes leídos y el pico de memoria, y se
+     * agrega al registro de SetRegistroCarga si hay uno.
      * @param nombreArchivo La ruta del archivo a cargar.
+     * @param modo La estrategia de lectura; todas producen el mismo catálogo y el mismo reporte.
+     * @param hilos Hilos a usar en ModoCarga::Paralelo (0 = todos los núcleos disponibles).
+     * @return El reporte de la carga; cargado es false si el catálogo publicado no cambió.
+     */
+    ReporteCarga CargarArchivo(const std::string& nombreArchivo, ModoCarga modo = ModoCarga::Flujo, unsigned hilos = 0);
+
+    /**
+     * @brief Registra el reporte de cada carga siguiente como una línea JSON (ver ReporteCarga::EscribirJson).
+     *
+     * Las líneas se agregan al final del archivo, que así acumula el historial de cargas
+     * para comparar el rendimiento entre versiones del catálogo.
+     * @param nombreArchivo La ruta del registro; vacía para dejar de registrar.
      */
-    void CargarArchivo(const std::string& nombreArchivo);
+    void SetRegistroCarga(const std::string& nombreArchivo);
+
+    /**
+     * @brief Guarda el catálogo actual, con sus calificaciones, en un snapshot binario.
+     *
+     * El archivo se vuelve a cargar con CargarArchivo(nombreArchivo, ModoCarga::Snapshot)
+     * y produce exactamente el mismo catálogo, sin volver a parsear el texto original.
+     * También guarda los índices del catálogo, así que la carga los copia en lugar de
+     * construirlos (ver Catalogo::RestaurarIndices).
+     * @param nombreArchivo La ruta del archivo a crear (se sobrescribe si existe).
+     * @return true si el snapshot se escribió completo.
+     */
+    bool GuardarSnapshot(const std::string& nombreArchivo) const;
 
     /**
      * @brief Permite al usuario calificar un video o un episodio por su título.
+     *
+     * Si el destino rechaza la calificación (fuera de 1-5, o su agregado está lleno),
+     * lo informa en lugar del nuevo promedio y no toca los índices.
      * @param titulo El título (no sensible a mayúsculas/minúsculas) a calificar.
      * @param calificacion La calificación a asignar (1-5).
      */
     void CalificarVideo(const std::string& titulo, int calificacion);
 
+    /**
+     * @brief Aplica un lote de calificaciones de una sola vez, sin escribir en consola.
+     *
+     * Cada título se resuelve con la misma prioridad que CalificarVideo (primero
+     * episodios, luego videos). Los eventos se agrupan por destino y cada destino
+     * recibe todas sus calificaciones en una sola actualización, por lo que el
+     * índice de calificaciones se actualiza una vez por video y no una por evento.
+     * Si un grupo desbordaría el agregado del destino, sus eventos se cuentan como
+     * rechazados y no se aplica ninguno.
+     * @param eventos Los eventos a aplicar.
+     * @return El resumen del lote.
+     */
+    ResultadoLote CalificarLote(const std::vector<EventoCalificacion>& eventos);
+
+    /**
+     * @brief Califica un episodio identificado sin ambigüedad por su serie, temporada y título.
+     * @param serieId El identificador de la serie (ej. "S001").
+     * @param temporada El número de temporada del episodio.
+     * @param titulo El título del episodio (no sensible a mayúsculas/minúsculas).
+     * @param calificacion La calificación a asignar (1-5).
+     * @return true si la calificación se registró (false si el episodio no existe o la rechazó).
+     */
+    bool CalificarEpisodio(const std::string& serieId, int temporada, const std::string& titulo, int calificacion);
+
+    /**
+     * @brief Activa o desactiva el índice global de episodios por título.
+     *
+     * El índice global es ambiguo (dos series con un episodio "Pilot" colisionan)
+     * y solo lo usa CalificarVideo. Desactivarlo ahorra memoria y tiempo de
+     * indexado cuando las calificaciones llegan por CalificarEpisodio. Al
+     * desactivarlo se libera de inmediato; al activarlo se construye en la
+     * siguiente carga.
+     * @param activo true para construir el índice global (valor por defecto).
+     */
+    void SetIndiceGlobalEpisodios(bool activo);
+
+    /**
+     * @brief Agrega un episodio a una serie ya cargada y lo indexa en O(1).
+     *
+     * Los episodios tienen direcciones estables, así que no hace falta reindexar
+     * el catálogo completo.
+     * @param tituloSerie El título de la serie (no sensible a mayúsculas/minúsculas).
+     * @param episodio El episodio a agregar.
+     * @return true si la serie existe y el episodio fue agregado.
+     */
+    bool AgregarEpisodio(const std::string& tituloSerie, const Episodio& episodio);
+
+    // --- Consultas (devuelven los resultados sin escribir en consola) ---
+
+    /**
+     * @brief Busca videos filtrados por calificación y/o género.
+     * @param calificacionMinima La calificación mínima requerida.
+     * @param genero El género para filtrar (no sensible a mayúsculas/minúsculas); vacío para todos.
+     * @return Los videos encontrados, en el orden del catálogo. Son válidos hasta la siguiente
+     *         carga; para usarlos mientras otro hilo recarga, consulte sobre GetCatalogo().
+     */
+    std::vector<const Video*> BuscarVideos(double calificacionMinima, const std::string& genero) const;
+
+    /**
+     * @brief Busca las películas que cumplen con una calificación mínima.
+     * @param calificacionMinima La calificación mínima requerida.
+     * @return Las películas encontradas, en el orden del catálogo.
+     */
+    std::vector<const Video*> BuscarPeliculas(double calificacionMinima) const;
+
+    /**
+     * @brief Busca una serie por su título.
+     * @param tituloSerie El título de la serie (no sensible a mayúsculas/minúsculas).
+     * @return La serie, o nullptr si no existe o el título corresponde a una película.
+     */
+    const Serie* BuscarSerie(const std::string& tituloSerie) const;
+
+    /**
+     * @brief Busca los episodios de una serie que cumplen con una calificación mínima.
+     * @param tituloSerie El título de la serie (no sensible a mayúsculas/minúsculas).
+     * @param calificacionMinima La calificación mínima para los episodios.
+     * @return Los episodios encontrados (vacío si la serie no existe).
+     */
+    std::vector<const Episodio*> BuscarEpisodiosDeSerie(const std::string& tituloSerie, double calificacionMinima) const;
+
+    /**
+     * @brief Busca títulos de videos a partir de lo que escribió el usuario.
+     *
+     * Primero van los títulos que empiezan con el texto (o que tienen una palabra que
+     * empieza con él) y después, si faltan, los parecidos aunque tengan errores de tipeo.
+     * @param texto El texto (no sensible a mayúsculas/minúsculas ni a signos de puntuación).
+     * @param limite El número máximo de resultados.
+     * @return Los videos encontrados, del más al menos relevante.
+     */
+    std::vector<const Video*> BuscarTitulos(const std::string& texto, std::size_t limite = 10) const;
+
+    /**
+     * @brief Busca videos y episodios con una consulta booleana de palabras.
+     *
+     * Se buscan las palabras de los títulos de videos y episodios y de los géneros (un
+     * episodio tiene el género de su serie), combinadas con AND, OR, NOT y paréntesis;
+     * por ejemplo "drama AND piloto NOT comedia". Ver IndiceTextual.
+     * @param consulta La consulta (las palabras no distinguen mayúsculas/minúsculas; los operadores van en mayúsculas).
+     * @return Los documentos que cumplen la consulta: cada video seguido de sus episodios, en el orden del catálogo.
+     */
+    std::vector<ResultadoTexto> BuscarTexto(const std::string& consulta) const;
+
+    /**
+     * @brief Obtiene los contenidos mejor calificados.
+     *
+     * Los videos salen de tablas de posiciones por tipo y por género que se mantienen
+     * al calificar, así que el costo depende de k y no del tamaño del catálogo. Los
+     * episodios se recorren una vez conservando solo los k mejores.
+     * @param k El número máximo de posiciones.
+     * @param genero El género (no sensible a mayúsculas/minúsculas); vacío para todos. Un episodio tiene el género de su serie.
+     * @param tipo El contenido que participa.
+     * @return Hasta k posiciones, de mayor a menor calificación promedio; a igual promedio, en el orden del catálogo.
+     */
+    std::vector<PosicionRanking> TopK(std::size_t k, const std::string& genero = "", TipoRanking tipo = TipoRanking::Videos) const;
+
+    /**
+     * @brief Filtra un archivo de catálogo sin cargarlo, para catálogos más grandes que la memoria.
+     *
+     * El archivo se recorre una sola vez con memoria acotada (ver FiltroFlujo) y cada
+     * video que cumple el criterio se entrega apenas se parsea. No modifica el catálogo
+     * cargado ni sus calificaciones.
+     * @param nombreArchivo La ruta del archivo, con el formato de texto de CargarArchivo.
+     * @param criterio El criterio de selección.
+     * @param consumidor Recibe los videos que cumplen el criterio; la referencia solo es válida durante la llamada.
+     * @return El resumen del recorrido; abierto es false si el archivo no pudo abrirse.
+     */
+    ResumenFlujo FiltrarArchivo(const std::string& nombreArchivo, const CriterioFlujo& criterio,
+                                const FiltroFlujo::Consumidor& consumidor) const;
+
+    // --- Presentación en consola (usan las consultas y la clase Formateador) ---
+
     /**
      * @brief Muestra videos filtrados por calificación y/o género.
      * @param calificacionMinima La calificación mínima requerida.
@@ -72,6 +294,55 @@ public:
      * @param calificacionMinima La calificación mínima requerida.
      */
     void MostrarPeliculasConCalificacion(double calificacionMinima);
+
+    /**
+     * @brief Muestra los contenidos mejor calificados (ver TopK).
+     * @param k El número máximo de posiciones.
+     * @param genero El género (no sensible a mayúsculas/minúsculas); vacío para todos.
+     * @param tipo El contenido que participa.
+     */
+    void MostrarTopK(std::size_t k, const std::string& genero, TipoRanking tipo);
+
+    /**
+     * @brief Muestra el resultado de una consulta booleana de palabras (ver BuscarTexto).
+     * @param consulta La consulta.
+     */
+    void MostrarBusquedaTexto(const std::string& consulta);
+
+    /**
+     * @brief Muestra los videos de un archivo que cumplen un criterio, sin cargarlo (ver FiltrarArchivo).
+     * @param nombreArchivo La ruta del archivo.
+     * @param criterio El criterio de selección.
+     */
+    void MostrarFiltroArchivo(const std::string& nombreArchivo, const CriterioFlujo& criterio);
+
+    /**
+     * @brief Exporta el catálogo completo, con el mismo formato de la consola, a un archivo.
+     *
+     * El texto se escribe en bloques de kBloqueExportacion bytes en lugar de línea por línea.
+     * @param nombreArchivo La ruta del archivo a crear (se sobrescribe si existe).
+     * @return true si el archivo se escribió completo, false si no se pudo crear o escribir.
+     */
+    bool ExportarCatalogo(const std::string& nombreArchivo) const;
+
+    /**
+     * @brief Obtiene el catálogo publicado actualmente.
+     *
+     * El catálogo devuelto (y todo puntero obtenido de él) sigue siendo válido
+     * aunque otro hilo cargue un archivo nuevo mientras tanto.
+     * @return Una referencia compartida al catálogo; nunca es nula.
+     */
+    std::shared_ptr<const Catalogo> GetCatalogo() const;
+
+    /** @brief Tamaño de bloque usado por ExportarCatalogo (1 MiB). */
+    static constexpr std::size_t kBloqueExportacion = 1024 * 1024;
+    /** @brief Número máximo de títulos sugeridos cuando un título no se encuentra. */
+    static constexpr std::size_t kSugerencias = 3;
+    /** @brief Tamaño del primer bloque de cada arena del catálogo (ver Catalogo::kBloqueInicialArena). */
+    static constexpr std::size_t kBloqueInicialArena = Catalogo::kBloqueInicialArena;
+
+    /** @brief Obtiene el número de arenas del catálogo actual (una por bloque en la carga paralela). @return El número de arenas. */
+    std::size_t GetNumeroArenas() const;
 };
 
 #endif // SERVICIOSTREAMING_H
\ No newline at end of file
@@ -0,0 +1,316 @@
+/**
+ * @file snapshotcatalogo.cpp
+ * @brief Implementación de la clase SnapshotCatalogo.
+ * @author Tu Nombre
+ * @date 2025-06-15
+ */
+
+#include "snapshotcatalogo.h"
+#include "pelicula.h"
+#include "serie.h"
+#include "buffersalida.h"
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+#include <unordered_map>
+
+namespace {
+
+constexpr char kFirma[8] = {'S', 'T', 'R', 'M', 'C', 'A', 'T', '\0'};
+constexpr std::uint32_t kMarcaOrden = 0x01020304;
+constexpr std::size_t kBloqueEscritura = 1024 * 1024;
+
+enum : std::uint8_t { kTipoPelicula = 0, kTipoSerie = 1 };
+
+struct Cabecera {
+    char firma[8];
+    std::uint32_t version;
+    std::uint32_t marcaOrden;
+    std::uint64_t videos;
+    std::uint64_t episodios;
+    std::uint64_t bytesCadenas;
+    std::uint64_t bytesIndices;
+};
+
+// Posición de un texto dentro de la tabla de cadenas
+struct RefCadena {
+    std::uint64_t desplazamiento;
+    std::uint32_t longitud;
+    std::uint32_t relleno;
+};
+
+struct RegistroVideo {
+    RefCadena id;
+    RefCadena nombre;
+    RefCadena genero;
+    double duracion;
+    std::uint64_t histograma[AgregadoCalificaciones::kMaxima];
+    std::uint64_t primerEpisodio;
+    std::uint32_t numEpisodios;
+    std::uint8_t tipo;
+    std::uint8_t relleno[3];
+};
+
+struct RegistroEpisodio {
+    RefCadena titulo;
+    std::int32_t temporada;
+    std::uint32_t relleno;
+    std::uint64_t histograma[AgregadoCalificaciones::kMaxima];
+};
+
+static_assert(std::is_trivially_copyable<Cabecera>::value, "Cabecera debe poder copiarse byte a byte");
+static_assert(sizeof(Cabecera) == 48, "El tamaño de Cabecera es parte del formato");
+static_assert(sizeof(RegistroVideo) == 112, "El tamaño de RegistroVideo es parte del formato");
+static_assert(sizeof(RegistroEpisodio) == 64, "El tamaño de RegistroEpisodio es parte del formato");
+
+template <typename Registro>
+void Escribir(BufferSalida& salida, const Registro& registro) {
+    salida.Agregar(std::string_view(reinterpret_cast<const char*>(&registro), sizeof(Registro)));
+}
+
+template <typename Registro>
+Registro LeerRegistro(const char* origen) {
+    Registro registro;
+    std::memcpy(&registro, origen, sizeof(Registro)); // El mapeo no garantiza alineación
+    return registro;
+}
+
+void CopiarHistograma(const AgregadoCalificaciones& calificaciones, std::uint64_t (&histograma)[AgregadoCalificaciones::kMaxima]) {
+    for (int c = AgregadoCalificaciones::kMinima; c <= AgregadoCalificaciones::kMaxima; ++c) {
+        histograma[c - 1] = calificaciones.GetFrecuencia(c);
+    }
+}
+
+// Asigna posiciones en la tabla de cadenas en el mismo orden en que luego se escriben.
+// Los géneros se repiten mucho, así que se guardan una sola vez.
+class TablaCadenas {
+public:
+    RefCadena Agregar(std::string_view texto) {
+        RefCadena ref{bytes, static_cast<std::uint32_t>(texto.size()), 0};
+        textos.push_back(texto);
+        bytes += texto.size();
+        return ref;
+    }
+
+    RefCadena AgregarCompartida(std::string_view texto) {
+        auto it = compartidas.find(texto);
+        if (it != compartidas.end()) {
+            return it->second;
+        }
+        RefCadena ref = Agregar(texto);
+        compartidas.emplace(texto, ref);
+        return ref;
+    }
+
+    void Escribir(BufferSalida& salida) const {
+        for (std::string_view texto : textos) {
+            salida.Agregar(texto);
+        }
+    }
+
+    std::uint64_t GetBytes() const {
+        return bytes;
+    }
+
+private:
+    std::vector<std::string_view> textos; // Vistas sobre los textos de los videos, que siguen vivos al escribir
+    std::unordered_map<std::string_view, RefCadena> compartidas;
+    std::uint64_t bytes = 0;
+};
+
+bool RefValida(const RefCadena& ref, std::uint64_t bytesCadenas) {
+    return ref.desplazamiento <= bytesCadenas && ref.longitud <= bytesCadenas - ref.desplazamiento;
+}
+
+// Un agregado admite como mucho kConteoMaximo calificaciones; con más, Calificar las rechazaría
+bool HistogramaValido(const std::uint64_t (&histograma)[AgregadoCalificaciones::kMaxima]) {
+    std::uint64_t total = 0;
+    for (std::uint64_t conteo : histograma) {
+        if (conteo > AgregadoCalificaciones::kConteoMaximo - total) {
+            return false;
+        }
+        total += conteo;
+    }
+    return true;
+}
+
+void RestaurarCalificaciones(const std::uint64_t (&histograma)[AgregadoCalificaciones::kMaxima], Video& video) {
+    for (int c = AgregadoCalificaciones::kMinima; c <= AgregadoCalificaciones::kMaxima; ++c) {
+        video.Calificar(c, histograma[c - 1]);
+    }
+}
+
+} // namespace
+
+bool SnapshotCatalogo::Guardar(const std::string& nombreArchivo, const std::vector<PtrVideo>& videos,
+                               const EscritorIndices& escribirIndices) {
+    std::ofstream archivo(nombreArchivo, std::ios::binary);
+    if (!archivo.is_open()) {
+        return false;
+    }
+
+    TablaCadenas cadenas;
+    std::vector<RegistroVideo> registrosVideo(videos.size());
+    std::vector<RegistroEpisodio> registrosEpisodio;
+
+    std::size_t totalEpisodios = 0;
+    for (const auto& video : videos) {
+        if (const Serie* serie = ComoSerie(*video)) {
+            totalEpisodios += serie->GetEpisodios().size();
+        }
+    }
+    registrosEpisodio.reserve(totalEpisodios);
+
+    for (std::size_t i = 0; i < videos.size(); ++i) {
+        const Video& video = *videos[i];
+        RegistroVideo& registro = registrosVideo[i];
+        registro = RegistroVideo{};
+        registro.id = cadenas.Agregar(video.GetId());
+        registro.nombre = cadenas.Agregar(video.GetNombre());
+        registro.genero = cadenas.AgregarCompartida(video.GetGenero());
+        registro.duracion = video.GetDuracion();
+        CopiarHistograma(video.GetCalificaciones(), registro.histograma);
+        registro.primerEpisodio = registrosEpisodio.size();
+        registro.tipo = kTipoPelicula;
+
+        if (const Serie* serie = ComoSerie(video)) {
+            registro.tipo = kTipoSerie;
+            registro.numEpisodios = static_cast<std::uint32_t>(serie->GetEpisodios().size());
+            for (const auto& ep : serie->GetEpisodios()) {
+                RegistroEpisodio registroEp{};
+                registroEp.titulo = cadenas.Agregar(ep.GetTitulo());
+                registroEp.temporada = ep.GetTemporada();
+                CopiarHistograma(ep.GetCalificaciones(), registroEp.histograma);
+                registrosEpisodio.push_back(registroEp);
+            }
+        }
+    }
+
+    Cabecera cabecera{};
+    std::memcpy(cabecera.firma, kFirma, sizeof(kFirma));
+    cabecera.version = kVersion;
+    cabecera.marcaOrden = kMarcaOrden;
+    cabecera.videos = registrosVideo.size();
+    cabecera.episodios = registrosEpisodio.size();
+    cabecera.bytesCadenas = cadenas.GetBytes();
+
+    {
+        BufferSalida salida(archivo, kBloqueEscritura);
+        Escribir(salida, cabecera);
+        for (const auto& registro : registrosVideo) {
+            Escribir(salida, registro);
+        }
+        for (const auto& registro : registrosEpisodio) {
+            Escribir(salida, registro);
+        }
+        cadenas.Escribir(salida);
+        if (escribirIndices) {
+            EscritorSnapshot indices(salida);
+            escribirIndices(indices);
+            cabecera.bytesIndices = indices.GetBytes();
+        }
+    }
+    // El tamaño de los índices solo se conoce al final: se completa la cabecera
+    if (cabecera.bytesIndices > 0) {
+        archivo.seekp(0);
+        archivo.write(reinterpret_cast<const char*>(&cabecera), sizeof(cabecera));
+    }
+    archivo.close();
+    return !archivo.fail();
+}
+
+std::string_view SnapshotCatalogo::SeccionIndices(std::string_view contenido) {
+    if (contenido.size() < sizeof(Cabecera) || !EsSnapshot(contenido)) {
+        return {};
+    }
+    const Cabecera cabecera = LeerRegistro<Cabecera>(contenido.data());
+    if (cabecera.version != kVersion || cabecera.marcaOrden != kMarcaOrden || cabecera.bytesIndices > contenido.size()) {
+        return {};
+    }
+    return contenido.substr(contenido.size() - cabecera.bytesIndices);
+}
+
+bool SnapshotCatalogo::EsSnapshot(std::string_view contenido) {
+    return contenido.size() >= sizeof(kFirma) && std::memcmp(contenido.data(), kFirma, sizeof(kFirma)) == 0;
+}
+
+bool SnapshotCatalogo::Leer(std::string_view contenido, std::vector<PtrVideo>& videos, std::pmr::memory_resource* arena) {
+    if (contenido.size() < sizeof(Cabecera) || !EsSnapshot(contenido)) {
+        return false;
+    }
+    const Cabecera cabecera = LeerRegistro<Cabecera>(contenido.data());
+    if (cabecera.version != kVersion || cabecera.marcaOrden != kMarcaOrden) {
+        return false;
+    }
+
+    // El tamaño del archivo debe coincidir exactamente con lo que declara la cabecera
+    const std::uint64_t disponible = contenido.size() - sizeof(Cabecera);
+    if (cabecera.videos > disponible / sizeof(RegistroVideo)) {
+        return false;
+    }
+    const std::uint64_t bytesVideos = cabecera.videos * sizeof(RegistroVideo);
+    if (cabecera.episodios > (disponible - bytesVideos) / sizeof(RegistroEpisodio)) {
+        return false;
+    }
+    const std::uint64_t bytesEpisodios = cabecera.episodios * sizeof(RegistroEpisodio);
+    if (cabecera.bytesCadenas > disponible - bytesVideos - bytesEpisodios ||
+        cabecera.bytesIndices != disponible - bytesVideos - bytesEpisodios - cabecera.bytesCadenas) {
+        return false;
+    }
+
+    const char* seccionVideos = contenido.data() + sizeof(Cabecera);
+    const char* seccionEpisodios = seccionVideos + bytesVideos;
+    const char* cadenas = seccionEpisodios + bytesEpisodios;
+    auto texto = [cadenas](const RefCadena& ref) {
+        return std::string_view(cadenas + ref.desplazamiento, ref.longitud);
+    };
+
+    // Primera pasada: validar todo antes de construir objetos
+    for (std::uint64_t i = 0; i < cabecera.videos; ++i) {
+        const RegistroVideo registro = LeerRegistro<RegistroVideo>(seccionVideos + i * sizeof(RegistroVideo));
+        if (registro.tipo != kTipoPelicula && registro.tipo != kTipoSerie) {
+            return false;
+        }
+        if (registro.tipo == kTipoPelicula && registro.numEpisodios != 0) {
+            return false;
+        }
+        if (registro.primerEpisodio > cabecera.episodios ||
+            registro.numEpisodios > cabecera.episodios - registro.primerEpisodio) {
+            return false;
+        }
+        if (!RefValida(registro.id, cabecera.bytesCadenas) || !RefValida(registro.nombre, cabecera.bytesCadenas) ||
+            !RefValida(registro.genero, cabecera.bytesCadenas) || !HistogramaValido(registro.histograma)) {
+            return false;
+        }
+    }
+    for (std::uint64_t i = 0; i < cabecera.episodios; ++i) {
+        const RegistroEpisodio registro = LeerRegistro<RegistroEpisodio>(seccionEpisodios + i * sizeof(RegistroEpisodio));
+        if (!RefValida(registro.titulo, cabecera.bytesCadenas) || !HistogramaValido(registro.histograma)) {
+            return false;
+        }
+    }
+
+    // Segunda pasada: construir el catálogo
+    videos.reserve(videos.size() + cabecera.videos);
+    for (std::uint64_t i = 0; i < cabecera.videos; ++i) {
+        const RegistroVideo registro = LeerRegistro<RegistroVideo>(seccionVideos + i * sizeof(RegistroVideo));
+        PtrVideo video;
+        if (registro.tipo == kTipoSerie) {
+            video = CrearVideo<Serie>(arena, texto(registro.id), texto(registro.nombre), registro.duracion, texto(registro.genero));
+            Serie* serie = static_cast<Serie*>(video.get());
+            for (std::uint64_t e = 0; e < registro.numEpisodios; ++e) {
+                const RegistroEpisodio registroEp = LeerRegistro<RegistroEpisodio>(
+                    seccionEpisodios + (registro.primerEpisodio + e) * sizeof(RegistroEpisodio));
+                Episodio& episodio = serie->AgregarEpisodio(texto(registroEp.titulo), registroEp.temporada);
+                for (int c = AgregadoCalificaciones::kMinima; c <= AgregadoCalificaciones::kMaxima; ++c) {
+                    episodio.Calificar(c, registroEp.histograma[c - 1]);
+                }
+            }
+        } else {
+            video = CrearVideo<Pelicula>(arena, texto(registro.id), texto(registro.nombre), registro.duracion, texto(registro.genero));
+        }
+        RestaurarCalificaciones(registro.histograma, *video);
+        videos.push_back(std::move(video));
+    }
+    return true;
+}
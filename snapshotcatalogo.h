@@ -0,0 +1,85 @@
+#ifndef SNAPSHOTCATALOGO_H
+#define SNAPSHOTCATALOGO_H
+
+/**
+ * @file snapshotcatalogo.h
+ * @brief Declaración de la clase SnapshotCatalogo.
+ * @author Tu Nombre
+ * @date 2025-06-15
+ */
+
+#include "video.h"
+#include "seccionsnapshot.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @class SnapshotCatalogo
+ * @brief Formato binario versionado para guardar y recuperar un catálogo completo.
+ *
+ * El archivo contiene, en este orden:
+ * - una cabecera con la firma, la versión y el número de elementos de cada sección;
+ * - un registro de tamaño fijo por video (referencias a cadenas, duración,
+ *   histograma de calificaciones y el rango de sus episodios);
+ * - un registro de tamaño fijo por episodio, agrupados por serie;
+ * - la tabla de cadenas, con todos los textos concatenados;
+ * - opcionalmente, los índices del catálogo (ver Catalogo::GuardarIndices), para
+ *   cargarlos sin reconstruirlos. Su contenido lo define el catálogo; este formato
+ *   solo registra su tamaño.
+ *
+ * Los números se guardan en el orden de bytes de la máquina que escribe el archivo;
+ * la cabecera lo registra y Leer() rechaza archivos de otra arquitectura. La lectura
+ * trabaja sobre el contenido proyectado con ArchivoMapeado: no hay texto que
+ * tokenizar ni números que convertir, solo registros que copiar.
+ */
+class SnapshotCatalogo {
+public:
+    /** @brief Versión del formato que escribe y acepta esta implementación. */
+    static constexpr std::uint32_t kVersion = 2;
+
+    /** @brief Función que escribe la sección de índices. */
+    using EscritorIndices = std::function<void(EscritorSnapshot&)>;
+
+    /**
+     * @brief Escribe el catálogo en un archivo de snapshot.
+     * @param nombreArchivo La ruta del archivo a crear (se sobrescribe si existe).
+     * @param videos El catálogo a guardar.
+     * @param escribirIndices Escribe la sección de índices (si está vacía, el snapshot no la incluye).
+     * @return true si el archivo se escribió completo.
+     */
+    static bool Guardar(const std::string& nombreArchivo, const std::vector<PtrVideo>& videos,
+                        const EscritorIndices& escribirIndices = {});
+
+    /**
+     * @brief Reconstruye un catálogo a partir del contenido de un snapshot.
+     *
+     * Se valida la cabecera y que cada referencia quede dentro del archivo antes de
+     * construir nada; si algo no cuadra, el vector de salida no se modifica.
+     * @param contenido El contenido completo del archivo.
+     * @param videos El vector donde se agregan los videos leídos.
+     * @param arena Recurso de memoria del que se crean los videos (por defecto, el heap).
+     * @return true si el contenido es un snapshot válido de esta versión.
+     */
+    static bool Leer(std::string_view contenido, std::vector<PtrVideo>& videos,
+                     std::pmr::memory_resource* arena = std::pmr::get_default_resource());
+
+    /**
+     * @brief Obtiene la sección de índices de un snapshot que Leer() aceptó.
+     * @param contenido El contenido completo del archivo.
+     * @return Los bytes de la sección, o una vista vacía si el snapshot no la incluye.
+     */
+    static std::string_view SeccionIndices(std::string_view contenido);
+
+    /**
+     * @brief Indica si un contenido empieza con la firma de un snapshot.
+     * @param contenido El contenido (o al menos sus primeros bytes).
+     * @return true si la firma coincide, sin validar el resto.
+     */
+    static bool EsSnapshot(std::string_view contenido);
+};
+
+#endif // SNAPSHOTCATALOGO_H
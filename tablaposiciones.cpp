@@ -0,0 +1,45 @@
+/**
+ * @file tablaposiciones.cpp
+ * @brief Implementación de la clase TablaPosiciones.
+ * @author Tu Nombre
+ * @date 2025-06-15
+ */
+
+#include "tablaposiciones.h"
+#include <algorithm>
+
+bool TablaPosiciones::Mejor(const Entrada& a, const Entrada& b) {
+    return a.first > b.first || (a.first == b.first && a.second < b.second);
+}
+
+void TablaPosiciones::Reconstruir(std::vector<Entrada> entradas) {
+    orden.clear();
+    // Con las entradas ya ordenadas, cada inserción al final es O(1) amortizado
+    std::sort(entradas.begin(), entradas.end(), Mejor);
+    for (const auto& entrada : entradas) {
+        orden.emplace_hint(orden.end(), entrada);
+    }
+}
+
+void TablaPosiciones::Actualizar(std::size_t id, double anterior, double promedio) {
+    auto it = orden.find({anterior, id});
+    if (it == orden.end()) {
+        return;
+    }
+    // El nodo se reutiliza: solo cambia su clave y su lugar en el árbol
+    auto nodo = orden.extract(it);
+    nodo.value().first = promedio;
+    orden.insert(std::move(nodo));
+}
+
+TablaPosiciones::Iterador TablaPosiciones::begin() const {
+    return orden.begin();
+}
+
+TablaPosiciones::Iterador TablaPosiciones::end() const {
+    return orden.end();
+}
+
+std::size_t TablaPosiciones::GetTamano() const {
+    return orden.size();
+}
@@ -0,0 +1,91 @@
+#ifndef TABLAPOSICIONES_H
+#define TABLAPOSICIONES_H
+
+/**
+ * @file tablaposiciones.h
+ * @brief Declaración de la clase TablaPosiciones y de los tipos de las consultas de ranking.
+ * @author Tu Nombre
+ * @date 2025-06-15
+ */
+
+#include "video.h"
+#include "episodio.h"
+#include <cstddef>
+#include <set>
+#include <utility>
+#include <vector>
+
+/**
+ * @enum TipoRanking
+ * @brief Contenido que participa en una consulta TopK.
+ */
+enum class TipoRanking {
+    Videos,     ///< Películas y series.
+    Peliculas,  ///< Solo películas.
+    Series,     ///< Solo series.
+    Episodios   ///< Episodios de las series (el género es el de su serie).
+};
+
+/**
+ * @struct PosicionRanking
+ * @brief Una posición del resultado de TopK.
+ */
+struct PosicionRanking {
+    const Video* video = nullptr;       ///< El video o, para un episodio, su serie.
+    const Episodio* episodio = nullptr; ///< El episodio, o nullptr si la posición es un video.
+    double calificacion = 0.0;          ///< La calificación promedio con la que se ordenó.
+};
+
+/**
+ * @class TablaPosiciones
+ * @brief Elementos ordenados de mayor a menor calificación promedio, actualizables uno a uno.
+ *
+ * Los elementos se identifican por un entero (la posición en el catálogo); a igual
+ * promedio va primero el identificador menor. Recorrer los k mejores cuesta O(k)
+ * y actualizar un elemento O(log n).
+ */
+class TablaPosiciones {
+public:
+    /** @brief Par (promedio, identificador). */
+    using Entrada = std::pair<double, std::size_t>;
+
+    /**
+     * @brief Compara dos entradas.
+     * @return true si a va antes que b: mayor promedio o, a igual promedio, menor identificador.
+     */
+    static bool Mejor(const Entrada& a, const Entrada& b);
+
+private:
+    struct Comparador {
+        bool operator()(const Entrada& a, const Entrada& b) const { return Mejor(a, b); }
+    };
+    std::set<Entrada, Comparador> orden;
+
+public:
+    /** @brief Iterador constante que recorre las entradas de mejor a peor. */
+    using Iterador = std::set<Entrada, Comparador>::const_iterator;
+
+    /**
+     * @brief Reemplaza el contenido de la tabla.
+     * @param entradas Las entradas, en cualquier orden.
+     */
+    void Reconstruir(std::vector<Entrada> entradas);
+
+    /**
+     * @brief Cambia el promedio de un elemento.
+     * @param id El identificador.
+     * @param anterior El promedio con el que está en la tabla.
+     * @param promedio El promedio nuevo.
+     */
+    void Actualizar(std::size_t id, double anterior, double promedio);
+
+    /** @brief Obtiene el comienzo del recorrido (la mejor entrada). @return El iterador. */
+    Iterador begin() const;
+    /** @brief Obtiene el final del recorrido. @return El iterador. */
+    Iterador end() const;
+
+    /** @brief Obtiene el número de elementos. @return El tamaño de la tabla. */
+    std::size_t GetTamano() const;
+};
+
+#endif // TABLAPOSICIONES_H
@@ -10,13 +10,35 @@
 #include "serie.h"
 #include "serviciostreaming.h"
 #include "episodio.h"
-
+#include "parsercatalogo.h"
+#include "calificaciones.h"
+#include "indicecalificaciones.h"
+#include "diccionariogeneros.h"
+#include "indicetitulos.h"
+#include "formateador.h"
+#include "buffersalida.h"
+#include "snapshotcatalogo.h"
+#include "columnascatalogo.h"
+#include "filtrovectorial.h"
+#include "tablaposiciones.h"
+#include "buscadortitulos.h"
+#include "listapostings.h"
+#include "indicetextual.h"
+#include "filtroflujo.h"
+#include "reportecarga.h"
+
+#include <algorithm>
+#include <cmath>
+#include <set>
 #include <sstream>
 #include <string>
 #include <vector>
 #include <stdexcept>
 #include <fstream>
 #include <cstdio>
+#include <memory_resource>
+#include <atomic>
+#include <thread>
 
 // Helper para redirigir cout y cerr para testear la salida a consola
 class OutputRedirector {
@@ -78,6 +100,54 @@ TEST(VideoTest, CalificacionPromedioVacio) {
     EXPECT_EQ(v.GetCalificacionPromedio(), 0.0);
 }
 
+// --- Tests para la clase AgregadoCalificaciones ---
+
+TEST(AgregadoCalificacionesTest, ConteoSumaYPromedio) {
+    AgregadoCalificaciones agregado;
+    EXPECT_TRUE(agregado.Agregar(5));
+    EXPECT_TRUE(agregado.Agregar(4));
+    EXPECT_TRUE(agregado.Agregar(4));
+    EXPECT_FALSE(agregado.Agregar(0));
+    EXPECT_FALSE(agregado.Agregar(6));
+    EXPECT_EQ(agregado.GetConteo(), 3u);
+    EXPECT_EQ(agregado.GetSuma(), 13u);
+    EXPECT_NEAR(agregado.GetPromedio(), 13.0 / 3.0, 0.0001);
+    EXPECT_EQ(agregado.GetFrecuencia(4), 2u);
+    EXPECT_EQ(agregado.GetFrecuencia(1), 0u);
+    EXPECT_EQ(agregado.GetFrecuencia(9), 0u);
+}
+
+TEST(AgregadoCalificacionesTest, AgregarVariasVeces) {
+    AgregadoCalificaciones agregado;
+    agregado.Agregar(2, 1000000);
+    agregado.Agregar(5, 1000000);
+    EXPECT_EQ(agregado.GetConteo(), 2000000u);
+    EXPECT_DOUBLE_EQ(agregado.GetPromedio(), 3.5);
+}
+
+TEST(AgregadoCalificacionesTest, Percentiles) {
+    AgregadoCalificaciones agregado;
+    EXPECT_EQ(agregado.GetPercentil(50), 0); // Sin calificaciones
+    agregado.Agregar(1);
+    agregado.Agregar(3);
+    agregado.Agregar(3);
+    agregado.Agregar(5);
+    EXPECT_EQ(agregado.GetPercentil(0), 1);
+    EXPECT_EQ(agregado.GetPercentil(25), 1);
+    EXPECT_EQ(agregado.GetPercentil(50), 3);
+    EXPECT_EQ(agregado.GetPercentil(75), 3);
+    EXPECT_EQ(agregado.GetPercentil(100), 5);
+}
+
+TEST(VideoTest, ResumenDeCalificaciones) {
+    Pelicula v("V004", "Histogram", 100, "Drama");
+    v.Calificar(5);
+    v.Calificar(5);
+    v.Calificar(2);
+    EXPECT_EQ(v.GetCalificaciones().GetConteo(), 3u);
+    EXPECT_EQ(v.GetCalificaciones().GetFrecuencia(5), 2u);
+}
+
 // --- Tests para la clase Episodio ---
 
 TEST(EpisodioTest, CalificacionPromedioCorrecta) {
@@ -137,6 +207,26 @@ TEST(SerieTest, AgregarYCalificarEpisodios) {
     EXPECT_NEAR(episodios[1].GetCalificacionPromedio(), 3.0, 0.001);
 }
 
+TEST(SerieTest, CalificarEnLoteInformaSiSeRechaza) {
+    Serie s("S001", "Test Series", 60, "Drama");
+    Episodio& ep = s.AgregarEpisodio("Piloto", 1);
+    EXPECT_TRUE(s.Calificar(4, 10));
+    EXPECT_TRUE(ep.Calificar(5, 10));
+    // Un lote que desbordaría el agregado se rechaza entero y el llamador lo sabe
+    EXPECT_FALSE(s.Calificar(4, AgregadoCalificaciones::kConteoMaximo));
+    EXPECT_FALSE(ep.Calificar(5, AgregadoCalificaciones::kConteoMaximo));
+    EXPECT_FALSE(ep.Calificar(7, 1));
+    EXPECT_EQ(s.GetCalificaciones().GetConteo(), 10u);
+    EXPECT_EQ(ep.GetCalificaciones().GetConteo(), 10u);
+
+    // Una sola calificación también informa si se rechazó
+    EXPECT_FALSE(s.Calificar(0));
+    ASSERT_TRUE(ep.Calificar(5, AgregadoCalificaciones::kConteoMaximo - 11));
+    EXPECT_TRUE(ep.Calificar(5));
+    EXPECT_FALSE(ep.Calificar(5));
+    EXPECT_EQ(ep.GetCalificaciones().GetConteo(), AgregadoCalificaciones::kConteoMaximo);
+}
+
 TEST(SerieTest, MostrarDatos) {
     OutputRedirector redirector;
     Serie s("S001", "Test Series", 60, "Drama");
@@ -709,4 +799,1954 @@ TEST(ServicioStreamingTest, CargarEpisodioConCalificacionVacia) {
     // El promedio debe ser (5+4)/2 = 4.5
     EXPECT_NE(output.find("Calificacion promedio: 4.5"), std::string::npos);
     std::remove("temp_empty_ep_rating.txt");
-}
\ No newline at end of file
+}
+
+// ============================================================================================
+// ================================ CARGA MAPEADA (mmap) ======================================
+// ============================================================================================
+
+// Carga el archivo con el modo indicado y devuelve lo que escriben la carga y el listado completo.
+static std::string VolcarCatalogo(const std::string& archivo, ModoCarga modo) {
+    OutputRedirector redirector;
+    ServicioStreaming servicio;
+    servicio.CargarArchivo(archivo, modo);
+    servicio.MostrarVideosPorCalificacionOGenero(0.0, "");
+    return redirector.GetCout() + redirector.GetCerr();
+}
+
+TEST(ParserCatalogoTest, ParsearEnteroToleraComoStoi) {
+    int valor = 0;
+    EXPECT_TRUE(ParserCatalogo::ParsearEntero("5", valor));
+    EXPECT_EQ(valor, 5);
+    EXPECT_TRUE(ParserCatalogo::ParsearEntero("  4\r", valor));
+    EXPECT_EQ(valor, 4);
+    EXPECT_TRUE(ParserCatalogo::ParsearEntero("5;4;5", valor)); // stoi ignora el sobrante
+    EXPECT_EQ(valor, 5);
+    EXPECT_TRUE(ParserCatalogo::ParsearEntero("+3", valor));
+    EXPECT_EQ(valor, 3);
+    EXPECT_FALSE(ParserCatalogo::ParsearEntero("invalid", valor));
+    EXPECT_FALSE(ParserCatalogo::ParsearEntero("", valor));
+    EXPECT_FALSE(ParserCatalogo::ParsearEntero("+-3", valor));
+}
+
+TEST(ParserCatalogoTest, ParsearDecimal) {
+    double valor = 0.0;
+    EXPECT_TRUE(ParserCatalogo::ParsearDecimal("90.5", valor));
+    EXPECT_DOUBLE_EQ(valor, 90.5);
+    EXPECT_TRUE(ParserCatalogo::ParsearDecimal(" 60", valor));
+    EXPECT_DOUBLE_EQ(valor, 60.0);
+    EXPECT_FALSE(ParserCatalogo::ParsearDecimal("invalid_duration", valor));
+}
+
+TEST(ServicioStreamingTest, CargaMapeadaEquivalenteAFlujo) {
+    std::ofstream dummy_file("temp_modo_mapeado.txt");
+    dummy_file << "Pelicula,P001,Movie A,90.0,Action,5-4\n";
+    dummy_file << "\r\n";
+    dummy_file << "Pelicula,P002,Movie B,invalid,Comedy,3\n";
+    dummy_file << "Pelicula,P003,Movie C,75,Drama,5;4;5;5\r\n";
+    dummy_file << "Serie,S001,Series B,45.0,Drama,3-invalid-4;Ep1:1:5-4|Ep2|:2:3|Ep3:x:1|Ep4:2:5--4\n";
+    dummy_file << "Serie,S002,Series C,nada,Comedy,\n";
+    dummy_file << "Unknown,U001,Mystery,60.0,Mystery,5\n";
+    dummy_file << "Pelicula,P004,Sin Salto,100,Action,2"; // Última línea sin salto de línea
+    dummy_file.close();
+
+    std::string flujo = VolcarCatalogo("temp_modo_mapeado.txt", ModoCarga::Flujo);
+    std::string mapeado = VolcarCatalogo("temp_modo_mapeado.txt", ModoCarga::Mapeado);
+
+    EXPECT_NE(flujo.find("Total de videos: 5"), std::string::npos);
+    EXPECT_EQ(flujo, mapeado);
+    std::remove("temp_modo_mapeado.txt");
+}
+
+TEST(ServicioStreamingTest, CargaMapeadaArchivoNoExistente) {
+    OutputRedirector redirector;
+    ServicioStreaming servicio;
+    servicio.CargarArchivo("non_existent_file.txt", ModoCarga::Mapeado);
+    EXPECT_NE(redirector.GetCerr().find("Error: No se pudo abrir el archivo non_existent_file.txt"), std::string::npos);
+}
+
+TEST(ServicioStreamingTest, CargaMapeadaArchivoVacio) {
+    OutputRedirector redirector;
+    ServicioStreaming servicio;
+    std::ofstream dummy_file("temp_mapeado_vacio.txt"); dummy_file.close();
+    servicio.CargarArchivo("temp_mapeado_vacio.txt", ModoCarga::Mapeado);
+    EXPECT_NE(redirector.GetCout().find("Total de videos: 0"), std::string::npos);
+    std::remove("temp_mapeado_vacio.txt");
+}
+
+// ============================================================================================
+// =============================== CARGA PARALELA POR BLOQUES =================================
+// ============================================================================================
+
+TEST(ParserCatalogoTest, DividirEnBloquesRespetaLineas) {
+    std::string texto = "linea uno\nlinea dos\nlinea tres\nlinea cuatro\nfinal sin salto";
+    auto bloques = ParserCatalogo::DividirEnBloques(texto, 3);
+    ASSERT_GE(bloques.size(), 2u);
+
+    std::string unido;
+    for (size_t i = 0; i < bloques.size(); ++i) {
+        if (i + 1 < bloques.size()) {
+            EXPECT_EQ(bloques[i].back(), '\n'); // Ningún bloque corta una línea
+        }
+        unido += std::string(bloques[i]);
+    }
+    EXPECT_EQ(unido, texto);
+    EXPECT_TRUE(ParserCatalogo::DividirEnBloques("", 4).empty());
+}
+
+TEST(ServicioStreamingTest, CargaParalelaEquivalenteAFlujo) {
+    // Suficientes líneas para que el archivo se reparta en varios bloques
+    std::ofstream dummy_file("temp_modo_paralelo.txt");
+    for (int i = 0; i < 40000; ++i) {
+        if (i % 2 == 0) {
+            dummy_file << "Pelicula,P" << i << ",Movie " << i << "," << 60 + i % 90 << ",Action," << 1 + i % 5 << "-4\n";
+        } else {
+            dummy_file << "Serie,S" << i << ",Series " << i << ",30,Drama," << 1 + i % 5 << ";Ep" << i << ":1:5|Ep" << i << "b:x:3\n";
+        }
+    }
+    dummy_file.close();
+
+    std::string flujo = VolcarCatalogo("temp_modo_paralelo.txt", ModoCarga::Flujo);
+    std::string paralelo;
+    {
+        OutputRedirector redirector;
+        ServicioStreaming servicio;
+        servicio.CargarArchivo("temp_modo_paralelo.txt", ModoCarga::Paralelo, 4);
+        servicio.MostrarVideosPorCalificacionOGenero(0.0, "");
+        paralelo = redirector.GetCout() + redirector.GetCerr();
+    }
+
+    EXPECT_NE(flujo.find("Total de videos: 40000"), std::string::npos);
+    EXPECT_TRUE(flujo == paralelo);
+    std::remove("temp_modo_paralelo.txt");
+}
+
+// ============================================================================================
+// ================================== REPORTE DE CARGA ========================================
+// ============================================================================================
+
+TEST(ReporteCargaTest, CombinarDesplazaLineasYConservaLasPrimerasMuestras) {
+    ReporteCarga primero, segundo;
+    primero.lineas = 3;
+    primero.Registrar(ErrorCarga::TipoDesconocido, {"uno"});
+    for (std::size_t i = 1; i <= ReporteCarga::kMuestrasPorTipo + 2; ++i) {
+        segundo.lineas = i;
+        segundo.Registrar(ErrorCarga::TipoDesconocido, {"dos-", std::to_string(i)});
+    }
+    segundo.Registrar(ErrorCarga::EpisodioIncompleto, {"tres"});
+    primero.Combinar(segundo);
+
+    EXPECT_EQ(primero.lineas, 3 + ReporteCarga::kMuestrasPorTipo + 2);
+    EXPECT_EQ(primero.GetErrores(ErrorCarga::TipoDesconocido), ReporteCarga::kMuestrasPorTipo + 3);
+    EXPECT_EQ(primero.GetTotalErrores(), ReporteCarga::kMuestrasPorTipo + 4);
+    const auto& muestras = primero.GetMuestras();
+    ASSERT_EQ(muestras.size(), ReporteCarga::kMuestrasPorTipo + 1);
+    EXPECT_EQ(muestras[0].linea, 3u);
+    EXPECT_EQ(muestras[1].linea, 4u);
+    EXPECT_EQ(muestras[1].mensaje, "dos-1");
+    EXPECT_EQ(muestras.back().tipo, ErrorCarga::EpisodioIncompleto);
+    EXPECT_EQ(muestras.back().linea, primero.lineas);
+
+    // Solo los tipos que son advertencias se escriben; el resto se resume en una línea
+    std::ostringstream salida;
+    primero.EscribirAdvertencias(salida);
+    EXPECT_EQ(salida.str().find("tres"), std::string::npos);
+    EXPECT_NE(salida.str().find("Se omitieron otras 3 advertencias"), std::string::npos);
+}
+
+TEST(ServicioStreamingTest, ReporteDeCargaIgualEnTodosLosModos) {
+    std::ofstream dummy_file("temp_reporte_carga.txt");
+    dummy_file << "Pelicula,P001,Movie A,90.0,Action,5;4;x;9\n";                    // 1: invalida y fuera de rango
+    dummy_file << "\n";                                                          // 2
+    dummy_file << "Serie,S001,Series B,nada,Drama,3-4;Ep1:1:5;y|Ep2|Ep3:z:1\n"; // 3
+    dummy_file << "Unknown,U001,Mystery,60.0,Mystery,5\n";                       // 4
+    for (int i = 0; i < 20000; ++i) {                                            // 5...: una invalida por línea
+        dummy_file << "Pelicula,P" << i << ",Movie " << i << ",90,Action,4-bad" << i << "\n";
+    }
+    dummy_file << "Pelicula,P999,Final,abc,Action,5"; // Última línea sin salto de línea
+    dummy_file.close();
+
+    ServicioStreaming servicio;
+    std::vector<ReporteCarga> reportes;
+    {
+        OutputRedirector redirector;
+        reportes.push_back(servicio.CargarArchivo("temp_reporte_carga.txt", ModoCarga::Flujo));
+        reportes.push_back(servicio.CargarArchivo("temp_reporte_carga.txt", ModoCarga::Mapeado));
+        reportes.push_back(servicio.CargarArchivo("temp_reporte_carga.txt", ModoCarga::Paralelo, 4));
+    }
+
+    const ReporteCarga& flujo = reportes[0];
+    EXPECT_TRUE(flujo.cargado);
+    EXPECT_EQ(flujo.lineas, 20005u);
+    EXPECT_EQ(flujo.peliculas, 20001u);
+    EXPECT_EQ(flujo.series, 1u);
+    EXPECT_EQ(flujo.episodios, 1u);
+    EXPECT_EQ(flujo.calificaciones, 2u + 2u + 1u + 20000u);
+    EXPECT_EQ(flujo.GetErrores(ErrorCarga::CalificacionInvalida), 20001u);
+    EXPECT_EQ(flujo.GetErrores(ErrorCarga::CalificacionFueraDeRango), 1u);
+    EXPECT_EQ(flujo.GetErrores(ErrorCarga::DuracionSerieInvalida), 1u);
+    EXPECT_EQ(flujo.GetErrores(ErrorCarga::CalificacionEpisodioInvalida), 1u);
+    EXPECT_EQ(flujo.GetErrores(ErrorCarga::EpisodioIncompleto), 1u);
+    EXPECT_EQ(flujo.GetErrores(ErrorCarga::TemporadaInvalida), 1u);
+    EXPECT_EQ(flujo.GetErrores(ErrorCarga::TipoDesconocido), 1u);
+    EXPECT_EQ(flujo.GetErrores(ErrorCarga::DuracionInvalida), 1u);
+    EXPECT_EQ(flujo.GetTotalErrores(), 20008u);
+
+    // La muestra es acotada y conserva el número de línea de cada error
+    std::size_t invalidas = 0;
+    for (const auto& muestra : flujo.GetMuestras()) {
+        if (muestra.tipo == ErrorCarga::CalificacionInvalida) {
+            ++invalidas;
+        } else if (muestra.tipo == ErrorCarga::DuracionInvalida) {
+            EXPECT_EQ(muestra.linea, 20005u);
+        } else if (muestra.tipo == ErrorCarga::TipoDesconocido) {
+            EXPECT_EQ(muestra.linea, 4u);
+        }
+    }
+    EXPECT_EQ(invalidas, ReporteCarga::kMuestrasPorTipo);
+    EXPECT_EQ(flujo.GetMuestras()[0].linea, 1u);
+    EXPECT_EQ(flujo.GetMuestras()[0].mensaje, "Advertencia: Calificacion invalida para Pelicula 'Movie A': 'x'");
+
+    for (std::size_t i = 1; i < reportes.size(); ++i) {
+        const ReporteCarga& otro = reportes[i];
+        EXPECT_EQ(otro.lineas, flujo.lineas);
+        EXPECT_EQ(otro.calificaciones, flujo.calificaciones);
+        EXPECT_EQ(otro.episodios, flujo.episodios);
+        for (std::size_t tipo = 0; tipo < ReporteCarga::kTiposError; ++tipo) {
+            EXPECT_EQ(otro.GetErrores(static_cast<ErrorCarga>(tipo)), flujo.GetErrores(static_cast<ErrorCarga>(tipo)));
+        }
+        ASSERT_EQ(otro.GetMuestras().size(), flujo.GetMuestras().size());
+        for (std::size_t m = 0; m < flujo.GetMuestras().size(); ++m) {
+            EXPECT_EQ(otro.GetMuestras()[m].linea, flujo.GetMuestras()[m].linea);
+            EXPECT_EQ(otro.GetMuestras()[m].mensaje, flujo.GetMuestras()[m].mensaje);
+        }
+    }
+    std::remove("temp_reporte_carga.txt");
+}
+
+TEST(ServicioStreamingTest, CalificacionesSeparadasPorPuntoYComa) {
+    std::ofstream dummy_file("temp_punto_y_coma.txt");
+    dummy_file << "Pelicula,P001,Interstellar,169,Ciencia Ficcion,5;4;5;5\n";
+    dummy_file << "Serie,S001,Breaking Bad,60,Drama,5-4-5;Pilot:1:5;3|Cat:1:4-5\n";
+    dummy_file.close();
+
+    for (ModoCarga modo : {ModoCarga::Flujo, ModoCarga::Mapeado}) {
+        OutputRedirector redirector;
+        ServicioStreaming servicio;
+        ReporteCarga reporte = servicio.CargarArchivo("temp_punto_y_coma.txt", modo);
+        EXPECT_EQ(reporte.GetTotalErrores(), 0u);
+        EXPECT_EQ(reporte.calificaciones, 4u + 3u + 2u + 2u);
+        auto catalogo = servicio.GetCatalogo();
+        EXPECT_EQ(catalogo->GetVideos()[0]->GetCalificaciones().GetConteo(), 4u);
+        EXPECT_DOUBLE_EQ(catalogo->GetVideos()[0]->GetCalificacionPromedio(), 4.75);
+        const Serie* serie = servicio.BuscarSerie("Breaking Bad");
+        ASSERT_NE(serie, nullptr);
+        EXPECT_DOUBLE_EQ(serie->GetEpisodios()[0].GetCalificacionPromedio(), 4.0);
+        EXPECT_TRUE(redirector.GetCerr().empty());
+    }
+    std::remove("temp_punto_y_coma.txt");
+}
+
+TEST(ServicioStreamingTest, ReporteDeCargaMideFasesYBytes) {
+    std::ofstream dummy_file("temp_fases_carga.txt");
+    for (int i = 0; i < 2000; ++i) {
+        dummy_file << "Pelicula,P" << i << ",Movie " << i << ",90,Action,4-5\n";
+        dummy_file << "Serie,S" << i << ",Series " << i << ",30,Drama,3;Ep" << i << ":1:5-4|Fin" << i << ":2:3\n";
+    }
+    dummy_file.close();
+    std::ifstream leido("temp_fases_carga.txt", std::ios::binary | std::ios::ate);
+    const std::size_t tamano = static_cast<std::size_t>(leido.tellg());
+
+    ServicioStreaming servicio;
+    {
+        OutputRedirector redirector;
+        ASSERT_TRUE(servicio.CargarArchivo("temp_fases_carga.txt").cargado);
+        ASSERT_TRUE(servicio.GuardarSnapshot("temp_fases_carga.snap"));
+    }
+    for (ModoCarga modo : {ModoCarga::Flujo, ModoCarga::Mapeado, ModoCarga::Paralelo, ModoCarga::Snapshot}) {
+        OutputRedirector redirector;
+        const bool snapshot = modo == ModoCarga::Snapshot;
+        ReporteCarga reporte = servicio.CargarArchivo(snapshot ? "temp_fases_carga.snap" : "temp_fases_carga.txt", modo, 2);
+        ASSERT_TRUE(reporte.cargado);
+        EXPECT_EQ(reporte.peliculas, 2000u);
+        EXPECT_EQ(reporte.series, 2000u);
+        EXPECT_EQ(reporte.episodios, 4000u);
+        EXPECT_EQ(reporte.calificaciones, 2000u * (2 + 1 + 2 + 1));
+        if (!snapshot) {
+            EXPECT_EQ(reporte.bytes, tamano);
+            EXPECT_EQ(reporte.lineas, 4000u);
+            EXPECT_GT(reporte.GetLineasPorSegundo(), 0.0);
+            EXPECT_GT(reporte.tiempos.parseoSeries, 0.0);
+            EXPECT_LE(reporte.tiempos.parseoSeries, reporte.tiempos.parseo * reporte.hilos);
+        }
+        EXPECT_GT(reporte.tiempos.parseo, 0.0);
+        EXPECT_GT(reporte.tiempos.indices.Total(), 0.0);
+        EXPECT_GE(reporte.tiempos.total, reporte.tiempos.lectura + reporte.tiempos.parseo + reporte.tiempos.indices.Total());
+        EXPECT_GT(reporte.memoriaPicoKb, 0u);
+    }
+    std::remove("temp_fases_carga.txt");
+    std::remove("temp_fases_carga.snap");
+}
+
+TEST(ServicioStreamingTest, RegistroDeCargaEnJson) {
+    std::ofstream dummy_file("temp_registro_carga.txt");
+    dummy_file << "Pelicula,P001,Movie A,90.0,Action,5-4\n";
+    dummy_file << "Tipo \"raro\",U001,Mystery,60.0,Mystery,5\n";
+    dummy_file.close();
+    std::remove("temp_registro_carga.jsonl");
+
+    ServicioStreaming servicio;
+    {
+        OutputRedirector redirector;
+        servicio.SetRegistroCarga("temp_registro_carga.jsonl");
+        servicio.CargarArchivo("temp_registro_carga.txt", ModoCarga::Mapeado);
+        servicio.CargarArchivo("no_existe_registro.txt");
+        servicio.SetRegistroCarga("");
+        servicio.CargarArchivo("temp_registro_carga.txt");
+    }
+
+    std::ifstream registro("temp_registro_carga.jsonl");
+    std::vector<std::string> lineas;
+    for (std::string linea; std::getline(registro, linea);) {
+        lineas.push_back(linea);
+    }
+    ASSERT_EQ(lineas.size(), 2u);
+    EXPECT_EQ(lineas[0].front(), '{');
+    EXPECT_EQ(lineas[0].back(), '}');
+    EXPECT_NE(lineas[0].find("\"archivo\":\"temp_registro_carga.txt\",\"modo\":\"mapeado\""), std::string::npos);
+    EXPECT_NE(lineas[0].find("\"cargado\":true"), std::string::npos);
+    EXPECT_NE(lineas[0].find("\"lineas\":2,"), std::string::npos);
+    EXPECT_NE(lineas[0].find("\"calificaciones\":2,"), std::string::npos);
+    EXPECT_NE(lineas[0].find("\"indices\":{\"tablas\":"), std::string::npos);
+    EXPECT_NE(lineas[0].find("\"TipoDesconocido\":1"), std::string::npos);
+    EXPECT_NE(lineas[0].find("{\"tipo\":\"TipoDesconocido\",\"linea\":2,"
+                             "\"mensaje\":\"Advertencia: Tipo de video desconocido 'Tipo \\\"raro\\\"'\"}"),
+              std::string::npos);
+    EXPECT_NE(lineas[1].find("\"modo\":\"flujo\""), std::string::npos);
+    EXPECT_NE(lineas[1].find("\"cargado\":false"), std::string::npos);
+    std::remove("temp_registro_carga.txt");
+    std::remove("temp_registro_carga.jsonl");
+}
+
+// ============================================================================================
+// ============================== ÍNDICE POR CALIFICACIÓN =====================================
+// ============================================================================================
+
+TEST(IndiceCalificacionesTest, BuscarDesdeEnOrdenDeCatalogo) {
+    std::vector<PtrVideo> videos;
+    int ratings[] = {3, 5, 1, 4, 5};
+    for (int i = 0; i < 5; ++i) {
+        videos.push_back(std::make_unique<Pelicula>("P" + std::to_string(i), "Movie " + std::to_string(i), 90, "Action"));
+        videos.back()->Calificar(ratings[i]);
+    }
+    IndiceCalificaciones indice;
+    indice.Reconstruir(videos);
+
+    EXPECT_EQ(indice.GetTamano(), 5u);
+    EXPECT_EQ(indice.BuscarDesde(4.0), (std::vector<size_t>{1, 3, 4}));
+    EXPECT_EQ(indice.BuscarDesde(5.0), (std::vector<size_t>{1, 4}));
+    EXPECT_TRUE(indice.BuscarDesde(5.1).empty());
+
+    indice.Actualizar(2, 4.5);
+    indice.Actualizar(4, 2.0);
+    EXPECT_EQ(indice.BuscarDesde(4.0), (std::vector<size_t>{1, 2, 3}));
+    indice.Actualizar(99, 5.0); // Posición inexistente: se ignora
+    EXPECT_EQ(indice.GetTamano(), 5u);
+}
+
+TEST(ServicioStreamingTest, CalificarVideoActualizaIndiceDeCalificacion) {
+    OutputRedirector redirector;
+    ServicioStreaming servicio;
+    std::ofstream dummy_file("temp_indice_calificacion.txt");
+    dummy_file << "Pelicula,P001,Movie A,90.0,Action,3\n";
+    dummy_file << "Pelicula,P002,Movie B,80.0,Comedy,5\n";
+    dummy_file.close();
+    servicio.CargarArchivo("temp_indice_calificacion.txt");
+
+    redirector.Clear();
+    servicio.MostrarPeliculasConCalificacion(4.0);
+    EXPECT_EQ(redirector.GetCout().find("Movie A"), std::string::npos);
+
+    servicio.CalificarVideo("Movie A", 5);
+    servicio.CalificarVideo("Movie A", 5); // Promedio 4.3
+    servicio.CalificarVideo("Movie B", 1); // Promedio 3.0
+    redirector.Clear();
+    servicio.MostrarVideosPorCalificacionOGenero(4.0, "");
+    std::string output = redirector.GetCout();
+    EXPECT_NE(output.find("Movie A"), std::string::npos);
+    EXPECT_EQ(output.find("Movie B"), std::string::npos);
+    std::remove("temp_indice_calificacion.txt");
+}
+
+// ============================================================================================
+// ============================== DICCIONARIO DE GÉNEROS ======================================
+// ============================================================================================
+
+TEST(DiccionarioGenerosTest, RegistrarSinDistinguirMayusculas) {
+    DiccionarioGeneros generos;
+    std::uint32_t drama = generos.Registrar("Drama");
+    std::uint32_t comedia = generos.Registrar("Comedia");
+    EXPECT_NE(drama, comedia);
+    EXPECT_EQ(generos.Registrar("DRAMA"), drama);
+    EXPECT_EQ(generos.Buscar("dRaMa"), drama);
+    EXPECT_EQ(generos.Buscar("Terror"), DiccionarioGeneros::kSinGenero);
+    EXPECT_EQ(generos.GetNombre(drama), "drama");
+    EXPECT_EQ(generos.GetTamano(), 2u);
+
+    generos.Limpiar();
+    EXPECT_EQ(generos.GetTamano(), 0u);
+    EXPECT_EQ(generos.Buscar("Drama"), DiccionarioGeneros::kSinGenero);
+}
+
+TEST(ServicioStreamingTest, MostrarVideosPorGeneroSinDistinguirMayusculas) {
+    OutputRedirector redirector;
+    ServicioStreaming servicio;
+    std::ofstream dummy_file("temp_filter_genre_case.txt");
+    dummy_file << "Pelicula,P001,Movie A,90.0,Action,5\n";
+    dummy_file << "Serie,S001,Series B,30.0,ACTION,2;Ep1:1:5\n";
+    dummy_file << "Pelicula,P002,Movie C,80.0,Comedy,5\n";
+    dummy_file.close();
+    servicio.CargarArchivo("temp_filter_genre_case.txt");
+
+    redirector.Clear();
+    servicio.MostrarVideosPorCalificacionOGenero(0.0, "action");
+    std::string output = redirector.GetCout();
+    EXPECT_NE(output.find("Movie A"), std::string::npos);
+    EXPECT_NE(output.find("Series B"), std::string::npos);
+    EXPECT_EQ(output.find("Movie C"), std::string::npos);
+    EXPECT_LT(output.find("Movie A"), output.find("Series B")); // Orden del catálogo
+
+    redirector.Clear();
+    servicio.MostrarVideosPorCalificacionOGenero(3.0, "Action");
+    output = redirector.GetCout();
+    EXPECT_NE(output.find("Movie A"), std::string::npos);
+    EXPECT_EQ(output.find("Series B"), std::string::npos);
+
+    redirector.Clear();
+    servicio.MostrarVideosPorCalificacionOGenero(0.0, "Terror");
+    EXPECT_NE(redirector.GetCout().find("No se encontraron videos con los criterios especificados."), std::string::npos);
+    std::remove("temp_filter_genre_case.txt");
+}
+
+// ============================================================================================
+// ================================ ÍNDICE HASH DE TÍTULOS ====================================
+// ============================================================================================
+
+TEST(IndiceTitulosTest, BusquedaNoSensibleAMayusculas) {
+    IndiceTitulos<int> indice;
+    EXPECT_EQ(indice.Buscar("Nada"), nullptr); // Índice vacío
+    indice.Insertar("Breaking Bad", 1);
+    indice.Insertar("The Office", 2);
+
+    ASSERT_NE(indice.Buscar("breaking bad"), nullptr);
+    EXPECT_EQ(*indice.Buscar("BREAKING BAD"), 1);
+    EXPECT_EQ(*indice.Buscar(std::string_view("the office")), 2);
+    EXPECT_EQ(indice.Buscar("breaking"), nullptr);
+
+    indice.Insertar("THE OFFICE", 3); // Gana la última inserción, como std::map
+    EXPECT_EQ(*indice.Buscar("The Office"), 3);
+    EXPECT_EQ(indice.GetTamano(), 2u);
+
+    indice.Limpiar();
+    EXPECT_EQ(indice.Buscar("The Office"), nullptr);
+}
+
+TEST(IndiceTitulosTest, CreceConservandoEntradas) {
+    IndiceTitulos<size_t> indice;
+    for (size_t i = 0; i < 5000; ++i) {
+        indice.Insertar("Titulo " + std::to_string(i), i);
+    }
+    EXPECT_EQ(indice.GetTamano(), 5000u);
+    for (size_t i = 0; i < 5000; i += 7) {
+        const size_t* valor = indice.Buscar("TITULO " + std::to_string(i));
+        ASSERT_NE(valor, nullptr);
+        EXPECT_EQ(*valor, i);
+    }
+    EXPECT_EQ(indice.Buscar("Titulo 5000"), nullptr);
+}
+
+// ============================================================================================
+// ========================== EPISODIOS CON DIRECCIONES ESTABLES ==============================
+// ============================================================================================
+
+TEST(SerieTest, AgregarEpisodioConservaDirecciones) {
+    Serie s("S500", "Long Series", 40, "Drama");
+    Episodio* primero = &s.AgregarEpisodio(Episodio("Ep 0", 1));
+    for (int i = 1; i < 1000; ++i) {
+        s.AgregarEpisodio(Episodio("Ep " + std::to_string(i), 1 + i / 10));
+    }
+    EXPECT_EQ(primero, &s.GetEpisodiosMutables()[0]);
+    EXPECT_EQ(primero->GetTitulo(), "Ep 0");
+    EXPECT_EQ(s.GetEpisodios().size(), 1000u);
+}
+
+TEST(ServicioStreamingTest, AgregarEpisodioIncremental) {
+    OutputRedirector redirector;
+    ServicioStreaming servicio;
+    std::ofstream dummy_file("temp_agregar_episodio.txt");
+    dummy_file << "Serie,S001,Growing Series,30.0,Drama,4;Ep1:1:5\n";
+    dummy_file << "Pelicula,P001,Some Movie,90.0,Action,3\n";
+    dummy_file.close();
+    servicio.CargarArchivo("temp_agregar_episodio.txt");
+
+    // Muchos episodios nuevos: el índice no debe quedar con punteros colgantes
+    for (int i = 2; i <= 200; ++i) {
+        EXPECT_TRUE(servicio.AgregarEpisodio("growing series", Episodio("Ep" + std::to_string(i), 1)));
+    }
+    EXPECT_FALSE(servicio.AgregarEpisodio("Some Movie", Episodio("Nope", 1)));
+    EXPECT_FALSE(servicio.AgregarEpisodio("Missing Series", Episodio("Nope", 1)));
+
+    redirector.Clear();
+    servicio.CalificarVideo("Ep1", 3);
+    servicio.CalificarVideo("Ep200", 2);
+    std::string output = redirector.GetCout();
+    EXPECT_NE(output.find("Episodio 'Ep1' calificado. Nueva calificacion promedio: 4.0"), std::string::npos);
+    EXPECT_NE(output.find("Episodio 'Ep200' calificado. Nueva calificacion promedio: 2.0"), std::string::npos);
+    std::remove("temp_agregar_episodio.txt");
+}
+
+// ============================================================================================
+// ====================== ÍNDICE DE EPISODIOS POR (SERIE, TEMPORADA, TÍTULO) ==================
+// ============================================================================================
+
+TEST(ServicioStreamingTest, CalificarEpisodioSinAmbiguedad) {
+    OutputRedirector redirector;
+    ServicioStreaming servicio;
+    std::ofstream dummy_file("temp_calificar_episodio.txt");
+    dummy_file << "Serie,S001,First Show,30.0,Drama,4;Pilot:1:5|Pilot:2:1\n";
+    dummy_file << "Serie,S002,Second Show,30.0,Comedy,4;Pilot:1:2\n";
+    dummy_file.close();
+    servicio.CargarArchivo("temp_calificar_episodio.txt");
+
+    redirector.Clear();
+    EXPECT_TRUE(servicio.CalificarEpisodio("S001", 1, "PILOT", 3)); // (5+3)/2
+    EXPECT_TRUE(servicio.CalificarEpisodio("S002", 1, "pilot", 4)); // (2+4)/2
+    EXPECT_FALSE(servicio.CalificarEpisodio("S002", 2, "Pilot", 4));
+    std::string output = redirector.GetCout();
+    EXPECT_NE(output.find("Episodio 'Pilot' calificado. Nueva calificacion promedio: 4.0"), std::string::npos);
+    EXPECT_NE(output.find("Episodio 'Pilot' calificado. Nueva calificacion promedio: 3.0"), std::string::npos);
+    EXPECT_NE(output.find("Episodio 'Pilot' (temporada 2) de la serie 'S002' no encontrado."), std::string::npos);
+
+    // La temporada 2 de S001 no se tocó
+    redirector.Clear();
+    servicio.MostrarEpisodiosDeSerieConCalificacion("First Show", 0.0);
+    EXPECT_NE(redirector.GetCout().find("Calificacion promedio: 1.0"), std::string::npos);
+    std::remove("temp_calificar_episodio.txt");
+}
+
+TEST(ServicioStreamingTest, SinIndiceGlobalDeEpisodios) {
+    OutputRedirector redirector;
+    ServicioStreaming servicio;
+    servicio.SetIndiceGlobalEpisodios(false);
+    std::ofstream dummy_file("temp_sin_indice_global.txt");
+    dummy_file << "Serie,S001,Only Show,30.0,Drama,4;Ep1:1:5\n";
+    dummy_file.close();
+    servicio.CargarArchivo("temp_sin_indice_global.txt");
+    servicio.AgregarEpisodio("Only Show", Episodio("Ep2", 1));
+
+    redirector.Clear();
+    servicio.CalificarVideo("Ep1", 3);
+    EXPECT_NE(redirector.GetCout().find("Video o episodio 'Ep1' no encontrado."), std::string::npos);
+    EXPECT_TRUE(servicio.CalificarEpisodio("S001", 1, "Ep1", 3));
+    EXPECT_TRUE(servicio.CalificarEpisodio("S001", 1, "Ep2", 3));
+    std::remove("temp_sin_indice_global.txt");
+}
+
+// ============================================================================================
+// ================================ CALIFICACIÓN POR LOTES ====================================
+// ============================================================================================
+
+TEST(ServicioStreamingTest, CalificarLoteAgrupaYResume) {
+    OutputRedirector redirector;
+    ServicioStreaming servicio;
+    std::ofstream dummy_file("temp_calificar_lote.txt");
+    dummy_file << "Pelicula,P001,Movie A,90.0,Action,3\n";
+    dummy_file << "Pelicula,P002,Movie B,80.0,Comedy,5\n";
+    dummy_file << "Serie,S001,Series C,30.0,Drama,4;Ep1:1:5\n";
+    dummy_file.close();
+    servicio.CargarArchivo("temp_calificar_lote.txt");
+    redirector.Clear();
+
+    std::vector<EventoCalificacion> eventos = {
+        {"movie a", 5}, {"MOVIE A", 4}, {"Movie B", 1}, {"ep1", 1},
+        {"Movie A", 9}, {"Unknown", 3}, {"Movie A", 0},
+    };
+    ResultadoLote resultado = servicio.CalificarLote(eventos);
+    EXPECT_EQ(resultado.aplicadas, 4u);
+    EXPECT_EQ(resultado.invalidas, 2u);
+    EXPECT_EQ(resultado.noEncontradas, 1u);
+    EXPECT_EQ(resultado.titulosAfectados, 3u);
+    EXPECT_TRUE(redirector.GetCout().empty()); // El lote no escribe en consola
+
+    // Movie A: (3+5+4)/3 = 4.0; Movie B: (5+1)/2 = 3.0
+    servicio.MostrarVideosPorCalificacionOGenero(4.0, "");
+    std::string output = redirector.GetCout();
+    EXPECT_NE(output.find("Movie A"), std::string::npos);
+    EXPECT_EQ(output.find("Movie B"), std::string::npos);
+
+    redirector.Clear();
+    servicio.CalificarVideo("Ep1", 3); // (5+1+3)/3
+    EXPECT_NE(redirector.GetCout().find("Nueva calificacion promedio: 3.0"), std::string::npos);
+
+    // Un título que ya no admite el grupo entero lo rechaza y no cuenta como afectado
+    Episodio* ep1 = servicio.GetCatalogo()->BuscarEpisodio("Ep1");
+    ASSERT_NE(ep1, nullptr);
+    ASSERT_TRUE(ep1->Calificar(5, AgregadoCalificaciones::kConteoMaximo - ep1->GetCalificaciones().GetConteo() - 1));
+    resultado = servicio.CalificarLote({{"Ep1", 2}, {"ep1", 2}, {"Movie B", 2}});
+    EXPECT_EQ(resultado.aplicadas, 1u);
+    EXPECT_EQ(resultado.rechazadas, 2u);
+    EXPECT_EQ(resultado.titulosAfectados, 1u);
+    EXPECT_EQ(ep1->GetCalificaciones().GetFrecuencia(2), 0u);
+
+    // Aunque una parte del grupo cabría, no se aplica ninguna de sus calificaciones
+    resultado = servicio.CalificarLote({{"Ep1", 1}, {"Ep1", 5}});
+    EXPECT_EQ(resultado.aplicadas, 0u);
+    EXPECT_EQ(resultado.rechazadas, 2u);
+    EXPECT_EQ(resultado.titulosAfectados, 0u);
+    EXPECT_EQ(ep1->GetCalificaciones().GetFrecuencia(1), 1u);
+    EXPECT_EQ(ep1->GetCalificaciones().GetConteo(), AgregadoCalificaciones::kConteoMaximo - 1);
+
+    // Con el agregado lleno, calificar uno por uno informa el rechazo en lugar del promedio
+    redirector.Clear();
+    servicio.CalificarVideo("Ep1", 4);
+    servicio.CalificarVideo("Ep1", 4);
+    EXPECT_NE(redirector.GetCout().find("Episodio 'Ep1' calificado."), std::string::npos);
+    EXPECT_NE(redirector.GetCout().find("Episodio 'Ep1': calificacion 4 rechazada."), std::string::npos);
+    EXPECT_FALSE(servicio.CalificarEpisodio("S001", 1, "Ep1", 4));
+    EXPECT_EQ(ep1->GetCalificaciones().GetFrecuencia(4), 1u);
+    Video& peliculaB = servicio.GetCatalogo()->GetVideo(servicio.GetCatalogo()->BuscarPosicion("Movie B"));
+    ASSERT_TRUE(peliculaB.Calificar(1, AgregadoCalificaciones::kConteoMaximo - peliculaB.GetCalificaciones().GetConteo()));
+    redirector.Clear();
+    servicio.CalificarVideo("Movie B", 5);
+    EXPECT_EQ(redirector.GetCout(), "Video 'Movie B': calificacion 5 rechazada.\n");
+    std::remove("temp_calificar_lote.txt");
+}
+
+// ============================================================================================
+// ========================= CONSULTAS CON RESULTADOS Y FORMATEADOR ===========================
+// ============================================================================================
+
+TEST(ServicioStreamingTest, ConsultasDevuelvenResultados) {
+    OutputRedirector redirector;
+    ServicioStreaming servicio;
+    std::ofstream dummy_file("temp_consultas.txt");
+    dummy_file << "Pelicula,P001,Movie A,90.0,Action,5-4\n";
+    dummy_file << "Serie,S001,Series B,45.0,Action,3-4;Ep1:1:5-4|Ep2:1:3\n";
+    dummy_file << "Pelicula,P002,Movie C,80.0,Comedy,2\n";
+    dummy_file.close();
+    servicio.CargarArchivo("temp_consultas.txt");
+    redirector.Clear();
+
+    auto videos = servicio.BuscarVideos(3.5, "");
+    ASSERT_EQ(videos.size(), 2u);
+    EXPECT_EQ(videos[0]->GetNombre(), "Movie A");
+    EXPECT_EQ(videos[1]->GetNombre(), "Series B");
+    EXPECT_EQ(servicio.BuscarVideos(0.0, "comedy").size(), 1u);
+
+    auto peliculas = servicio.BuscarPeliculas(0.0);
+    ASSERT_EQ(peliculas.size(), 2u);
+    EXPECT_EQ(peliculas[1]->GetId(), "P002");
+
+    ASSERT_NE(servicio.BuscarSerie("series b"), nullptr);
+    EXPECT_EQ(servicio.BuscarSerie("Movie A"), nullptr);
+    auto episodios = servicio.BuscarEpisodiosDeSerie("Series B", 4.0);
+    ASSERT_EQ(episodios.size(), 1u);
+    EXPECT_EQ(episodios[0]->GetTitulo(), "Ep1");
+    EXPECT_TRUE(servicio.BuscarEpisodiosDeSerie("Missing", 0.0).empty());
+
+    EXPECT_TRUE(redirector.GetCout().empty()); // Las consultas no escriben en consola
+    std::remove("temp_consultas.txt");
+}
+
+TEST(FormateadorTest, EscribeEnCualquierBuffer) {
+    Pelicula p("P010", "Formatted Movie", 95, "Drama");
+    p.Calificar(4);
+    Serie s("S010", "Formatted Series", 30, "Comedy");
+    s.AgregarEpisodio(Episodio("Only Ep", 2));
+
+    std::ostringstream destino;
+    {
+        BufferSalida salida(destino);
+        Formateador::EscribirVideos(salida, {&p, &s});
+    }
+    std::string texto = destino.str();
+    EXPECT_NE(texto.find("Tipo: Pelicula"), std::string::npos);
+    EXPECT_NE(texto.find("Nombre: Formatted Movie"), std::string::npos);
+    EXPECT_NE(texto.find("Calificacion promedio: 4.0"), std::string::npos);
+    EXPECT_NE(texto.find("Tipo: Serie"), std::string::npos);
+    EXPECT_NE(texto.find("Titulo Episodio: Only Ep"), std::string::npos);
+    EXPECT_NE(texto.find("Temporada: 2"), std::string::npos);
+    EXPECT_NE(texto.find("--------------------"), std::string::npos);
+}
+
+// ============================================================================================
+// ========================== SALIDA CON BUFFER Y EXPORTACION =================================
+// ============================================================================================
+
+TEST(BufferSalidaTest, FormateaNumerosSinEstadoDelFlujo) {
+    std::ostringstream destino;
+    {
+        BufferSalida salida(destino);
+        salida.AgregarDecimal(4.25, 1).Agregar(' ').AgregarDecimal(3.0, 1).Agregar(' ')
+              .AgregarDecimal(169.0).Agregar(' ').AgregarDecimal(22.5).Agregar(' ').AgregarEntero(-42);
+        EXPECT_TRUE(destino.str().empty()); // Nada se escribe hasta vaciar
+    }
+    EXPECT_EQ(destino.str(), "4.2 3.0 169 22.5 -42");
+}
+
+TEST(BufferSalidaTest, EscribeEnBloquesDelTamanoIndicado) {
+    std::ostringstream destino;
+    BufferSalida salida(destino, 16);
+    for (int i = 0; i < 10; ++i) {
+        salida.Agregar("0123456789"); // 100 bytes en total
+    }
+    salida.Vaciar();
+    EXPECT_EQ(destino.str().size(), 100u);
+    EXPECT_EQ(salida.GetBytesEscritos(), 100u);
+    EXPECT_EQ(salida.GetBloquesEscritos(), 5u); // Se vacía cada dos agregados (20 bytes >= 16)
+}
+
+TEST(ServicioStreamingTest, ExportarCatalogoIgualQueLaConsola) {
+    OutputRedirector redirector;
+    ServicioStreaming servicio;
+    std::ofstream dummy_file("temp_exportar.txt");
+    dummy_file << "Pelicula,P001,Movie A,120,Action,5-4\n";
+    dummy_file << "Serie,S001,Series B,45.5,Drama,4;Ep1:1:5|Ep2:1:3\n";
+    dummy_file.close();
+    servicio.CargarArchivo("temp_exportar.txt");
+    redirector.Clear();
+    servicio.MostrarVideosPorCalificacionOGenero(0.0, "");
+    std::string consola = redirector.GetCout();
+
+    ASSERT_TRUE(servicio.ExportarCatalogo("temp_exportado.txt"));
+    std::ifstream exportado("temp_exportado.txt", std::ios::binary);
+    std::string texto((std::istreambuf_iterator<char>(exportado)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(texto, consola);
+    EXPECT_NE(texto.find("Duracion: 120 mins"), std::string::npos);
+    EXPECT_NE(texto.find("Duracion: 45.5 mins"), std::string::npos);
+    EXPECT_NE(texto.find("Calificacion promedio: 4.5"), std::string::npos);
+
+    EXPECT_FALSE(servicio.ExportarCatalogo("directorio_inexistente/salida.txt"));
+    std::remove("temp_exportar.txt");
+    std::remove("temp_exportado.txt");
+}
+
+// ============================================================================================
+// ================================== SNAPSHOT BINARIO ========================================
+// ============================================================================================
+
+TEST(ServicioStreamingTest, SnapshotReproduceElCatalogoExacto) {
+    OutputRedirector redirector;
+    std::ofstream dummy_file("temp_snapshot.txt");
+    dummy_file << "Pelicula,P001,Movie A,90.5,Action,5-4\n";
+    dummy_file << "Serie,S001,Series B,45.0,Drama,3-4;Ep1:1:5-4|Ep2:2:3\n";
+    dummy_file << "Serie,S002,Series C,30,Comedy,\n";
+    dummy_file << "Pelicula,P002,Movie D,100,action,\n";
+    dummy_file.close();
+
+    ServicioStreaming original;
+    original.CargarArchivo("temp_snapshot.txt");
+    original.CalificarVideo("Movie D", 2);
+    original.CalificarEpisodio("S001", 2, "Ep2", 5);
+    ASSERT_TRUE(original.GuardarSnapshot("temp_snapshot.snap"));
+    redirector.Clear();
+    original.MostrarVideosPorCalificacionOGenero(0.0, "");
+    std::string esperado = redirector.GetCout();
+
+    ServicioStreaming restaurado;
+    restaurado.CargarArchivo("temp_snapshot.snap", ModoCarga::Snapshot);
+    EXPECT_NE(redirector.GetCout().find("Datos cargados exitosamente. Total de videos: 4"), std::string::npos);
+    redirector.Clear();
+    restaurado.MostrarVideosPorCalificacionOGenero(0.0, "");
+    EXPECT_EQ(redirector.GetCout(), esperado);
+
+    // Los índices se reconstruyen igual que tras una carga de texto
+    EXPECT_EQ(restaurado.BuscarVideos(0.0, "ACTION").size(), 2u);
+    EXPECT_EQ(restaurado.BuscarVideos(4.0, "").size(), 1u);
+    const Serie* serie = restaurado.BuscarSerie("series b");
+    ASSERT_NE(serie, nullptr);
+    ASSERT_EQ(serie->GetEpisodios().size(), 2u);
+    EXPECT_EQ(serie->GetEpisodios()[1].GetCalificaciones().GetFrecuencia(5), 1u);
+    EXPECT_EQ(serie->GetEpisodios()[1].GetCalificaciones().GetFrecuencia(3), 1u);
+    EXPECT_TRUE(restaurado.CalificarEpisodio("S001", 1, "Ep1", 1));
+    EXPECT_TRUE(redirector.GetCerr().empty());
+
+    std::remove("temp_snapshot.txt");
+    std::remove("temp_snapshot.snap");
+}
+
+TEST(ServicioStreamingTest, SnapshotRestauraLosIndicesSinReconstruirlos) {
+    OutputRedirector redirector;
+    {
+        std::ofstream dummy_file("temp_snapshot_indices.txt");
+        const char* generos[] = {"Drama", "Comedy", "Action", "Sci-Fi"};
+        for (int i = 0; i < 40; ++i) {
+            dummy_file << "Pelicula,P" << i << ",Movie " << i << " Night,90," << generos[i % 4] << "," << 1 + i % 5 << "\n";
+            dummy_file << "Serie,S" << i << ",Series " << i << " Story,45," << generos[(i + 1) % 4] << ",4;Pilot " << i
+                       << ":1:5|Finale " << i << ":2:3\n";
+        }
+    }
+    ServicioStreaming texto;
+    texto.CargarArchivo("temp_snapshot_indices.txt");
+    ASSERT_TRUE(texto.GuardarSnapshot("temp_snapshot_indices.snap"));
+    ServicioStreaming restaurado;
+    EXPECT_TRUE(restaurado.CargarArchivo("temp_snapshot_indices.snap", ModoCarga::Snapshot).indicesRestaurados);
+
+    // Cada índice copiado responde igual que el construido desde el texto
+    auto nombres = [](const std::vector<const Video*>& videos) {
+        std::vector<std::string> resultado;
+        for (const Video* video : videos) resultado.emplace_back(video->GetNombre());
+        return resultado;
+    };
+    auto documentos = [](const std::vector<ResultadoTexto>& resultados) {
+        std::vector<std::string> resultado;
+        for (const auto& r : resultados) resultado.emplace_back(r.episodio ? r.episodio->GetTitulo() : r.video->GetNombre());
+        return resultado;
+    };
+    for (const char* consulta : {"mov", "story", "Moive 12 Nigth", "series 3"}) {
+        EXPECT_EQ(nombres(restaurado.BuscarTitulos(consulta)), nombres(texto.BuscarTitulos(consulta))) << consulta;
+    }
+    for (const char* consulta : {"drama AND pilot", "finale NOT comedy", "(night OR story) AND sci"}) {
+        EXPECT_EQ(documentos(restaurado.BuscarTexto(consulta)), documentos(texto.BuscarTexto(consulta))) << consulta;
+    }
+    EXPECT_EQ(nombres(restaurado.BuscarVideos(3.0, "comedy")), nombres(texto.BuscarVideos(3.0, "comedy")));
+    ASSERT_NE(restaurado.BuscarSerie("SERIES 7 STORY"), nullptr);
+    EXPECT_TRUE(restaurado.CalificarEpisodio("S7", 2, "finale 7", 5));
+    redirector.Clear();
+    restaurado.CalificarVideo("Pilot 9", 1);
+    EXPECT_NE(redirector.GetCout().find("Episodio 'Pilot 9' calificado"), std::string::npos);
+
+    // Los índices restaurados siguen creciendo con los episodios nuevos
+    ASSERT_TRUE(restaurado.AgregarEpisodio("Series 3 Story", Episodio("Bonus Drama", 3)));
+    ASSERT_EQ(documentos(restaurado.BuscarTexto("bonus")), std::vector<std::string>{"Bonus Drama"});
+
+    // Con otra configuración del índice de episodios, se construyen como siempre
+    ServicioStreaming sinIndiceGlobal;
+    sinIndiceGlobal.SetIndiceGlobalEpisodios(false);
+    EXPECT_FALSE(sinIndiceGlobal.CargarArchivo("temp_snapshot_indices.snap", ModoCarga::Snapshot).indicesRestaurados);
+    EXPECT_TRUE(sinIndiceGlobal.CalificarEpisodio("S7", 2, "Finale 7", 5));
+    EXPECT_EQ(documentos(sinIndiceGlobal.BuscarTexto("pilot AND drama")), documentos(texto.BuscarTexto("pilot AND drama")));
+
+    // Una sección de índices dañada nunca rompe la carga: o se detecta y se reconstruye, o
+    // el daño no toca una referencia (el catálogo en sí ya fue validado)
+    std::ifstream original("temp_snapshot_indices.snap", std::ios::binary);
+    const std::string bytes((std::istreambuf_iterator<char>(original)), std::istreambuf_iterator<char>());
+    const std::size_t inicioIndices = bytes.size() - SnapshotCatalogo::SeccionIndices(bytes).size();
+    ASSERT_LT(inicioIndices, bytes.size());
+    redirector.Clear();
+    texto.MostrarVideosPorCalificacionOGenero(0.0, "");
+    const std::string listado = redirector.GetCout();
+    std::size_t reconstruidos = 0;
+    const std::size_t paso = (bytes.size() - inicioIndices) / 24 + 1;
+    for (std::size_t desde = inicioIndices; desde < bytes.size(); desde += paso) {
+        std::string danado = bytes;
+        for (std::size_t i = desde; i < std::min(desde + 8, danado.size()); ++i) {
+            danado[i] = '\xff';
+        }
+        std::ofstream("temp_snapshot_danado.snap", std::ios::binary) << danado;
+        ServicioStreaming servicio;
+        const ReporteCarga reporte = servicio.CargarArchivo("temp_snapshot_danado.snap", ModoCarga::Snapshot);
+        ASSERT_TRUE(reporte.cargado);
+        reconstruidos += reporte.indicesRestaurados ? 0 : 1;
+        redirector.Clear();
+        servicio.MostrarVideosPorCalificacionOGenero(0.0, "");
+        EXPECT_EQ(redirector.GetCout(), listado) << desde;
+    }
+    EXPECT_GT(reconstruidos, 0u);
+
+    std::remove("temp_snapshot_indices.txt");
+    std::remove("temp_snapshot_indices.snap");
+    std::remove("temp_snapshot_danado.snap");
+}
+
+TEST(ServicioStreamingTest, SnapshotInvalidoNoModificaElCatalogo) {
+    OutputRedirector redirector;
+    std::ofstream dummy_file("temp_snapshot_base.txt");
+    dummy_file << "Pelicula,P001,Movie A,90,Action,5\n";
+    dummy_file.close();
+    ServicioStreaming servicio;
+    servicio.CargarArchivo("temp_snapshot_base.txt");
+    ASSERT_TRUE(servicio.GuardarSnapshot("temp_snapshot_base.snap"));
+
+    // Un archivo de texto no es un snapshot
+    servicio.CargarArchivo("temp_snapshot_base.txt", ModoCarga::Snapshot);
+    EXPECT_NE(redirector.GetCerr().find("Error: El archivo temp_snapshot_base.txt no es un snapshot valido"), std::string::npos);
+    EXPECT_EQ(servicio.BuscarVideos(0.0, "").size(), 1u);
+
+    // Un snapshot truncado tampoco
+    std::ifstream completo("temp_snapshot_base.snap", std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(completo)), std::istreambuf_iterator<char>());
+    std::vector<PtrVideo> leidos;
+    EXPECT_TRUE(SnapshotCatalogo::EsSnapshot(bytes));
+    EXPECT_TRUE(SnapshotCatalogo::Leer(bytes, leidos));
+    EXPECT_EQ(leidos.size(), 1u);
+    leidos.clear();
+    EXPECT_FALSE(SnapshotCatalogo::Leer(std::string_view(bytes).substr(0, bytes.size() - 1), leidos));
+    EXPECT_TRUE(leidos.empty());
+
+    EXPECT_FALSE(servicio.GuardarSnapshot("directorio_inexistente/catalogo.snap"));
+    std::remove("temp_snapshot_base.txt");
+    std::remove("temp_snapshot_base.snap");
+}
+
+// ============================================================================================
+// ================================ CATALOGO COLUMNAR =========================================
+// ============================================================================================
+
+TEST(ColumnasCatalogoTest, ReconstruirYFiltrar) {
+    std::vector<PtrVideo> videos;
+    videos.push_back(std::make_unique<Pelicula>("P1", "Movie One", 90.5, "Action"));
+    videos.push_back(std::make_unique<Serie>("S1", "Series One", 30, "Drama"));
+    videos.push_back(std::make_unique<Pelicula>("P2", "Movie Two", 100, "Drama"));
+    videos.push_back(std::make_unique<Serie>("S2", "", 45, "Action"));
+    int ratings[] = {5, 4, 2, 5};
+    for (size_t i = 0; i < videos.size(); ++i) {
+        videos[i]->Calificar(ratings[i]);
+        videos[i]->SetGeneroId(videos[i]->GetGenero() == "Action" ? 0 : 1);
+    }
+    videos[0]->Calificar(4);
+
+    ColumnasCatalogo columnas;
+    columnas.Reconstruir(videos);
+    ASSERT_EQ(columnas.GetTamano(), 4u);
+    EXPECT_EQ(columnas.GetTipo(0), ColumnasCatalogo::kTipoPelicula);
+    EXPECT_EQ(columnas.GetTipo(1), ColumnasCatalogo::kTipoSerie);
+    EXPECT_EQ(columnas.GetGeneroId(2), 1u);
+    EXPECT_DOUBLE_EQ(columnas.GetPromedio(0), 4.5);
+
+    CriterioFiltro criterio;
+    criterio.calificacionMinima = 4.0;
+    EXPECT_EQ(columnas.Filtrar(criterio), (std::vector<size_t>{0, 1, 3}));
+    criterio.generoId = 0;
+    EXPECT_EQ(columnas.Filtrar(criterio), (std::vector<size_t>{0, 3}));
+    criterio.tipo = ColumnasCatalogo::kTipoSerie;
+    EXPECT_EQ(columnas.Filtrar(criterio), (std::vector<size_t>{3}));
+    criterio.generoId = ColumnasCatalogo::kCualquierGenero;
+    criterio.tipo = ColumnasCatalogo::kTipoPelicula;
+    criterio.calificacionMinima = 0.0;
+    EXPECT_EQ(columnas.Filtrar(criterio), (std::vector<size_t>{0, 2}));
+
+    videos[2]->Calificar(5, 3);
+    columnas.ActualizarCalificaciones(2, videos[2]->GetCalificaciones());
+    columnas.ActualizarCalificaciones(99, videos[2]->GetCalificaciones()); // Fila inexistente: se ignora
+    EXPECT_DOUBLE_EQ(columnas.GetPromedio(2), videos[2]->GetCalificacionPromedio());
+    criterio.calificacionMinima = 4.0;
+    EXPECT_EQ(columnas.Filtrar(criterio), (std::vector<size_t>{0, 2}));
+}
+
+TEST(ServicioStreamingTest, ConsultasSiguenLasCalificacionesConColumnas) {
+    OutputRedirector redirector;
+    ServicioStreaming servicio;
+    std::ofstream dummy_file("temp_columnas.txt");
+    dummy_file << "Pelicula,P001,Movie A,90,Action,2\n";
+    dummy_file << "Serie,S001,Series B,45,Action,5\n";
+    dummy_file << "Pelicula,P002,Movie C,80,Comedy,\n";
+    dummy_file.close();
+    servicio.CargarArchivo("temp_columnas.txt");
+
+    EXPECT_EQ(servicio.BuscarPeliculas(0.0).size(), 2u);
+    EXPECT_TRUE(servicio.BuscarPeliculas(4.0).empty());
+    EXPECT_TRUE(servicio.BuscarVideos(3.0, "comedy").empty());
+
+    servicio.CalificarVideo("Movie C", 5);
+    std::vector<std::string> titulos = {"Movie A", "Movie A"};
+    servicio.CalificarLote({{titulos[0], 5}, {titulos[1], 5}});
+
+    auto peliculas = servicio.BuscarPeliculas(3.0);
+    ASSERT_EQ(peliculas.size(), 2u);
+    EXPECT_EQ(peliculas[0]->GetNombre(), "Movie A"); // (2 + 5 + 5) / 3 = 4
+    EXPECT_EQ(peliculas[1]->GetNombre(), "Movie C");
+    EXPECT_EQ(servicio.BuscarVideos(3.0, "comedy").size(), 1u);
+    EXPECT_EQ(servicio.BuscarVideos(4.0, "ACTION").size(), 2u);
+    std::remove("temp_columnas.txt");
+}
+
+// ============================================================================================
+// ================================ FILTRO VECTORIAL ==========================================
+// ============================================================================================
+
+TEST(FiltroVectorialTest, TodasLasImplementacionesCoincidenConLaEscalar) {
+    EXPECT_TRUE(FiltroVectorial::EstaDisponible(ImplementacionFiltro::Escalar));
+    const ImplementacionFiltro implementaciones[] = {ImplementacionFiltro::Escalar, ImplementacionFiltro::SSE2,
+                                                     ImplementacionFiltro::AVX2};
+    // Tamaños alrededor de los límites de palabra (64) y de bloque SIMD
+    for (size_t filas : {0u, 1u, 7u, 63u, 64u, 65u, 200u, 1000u}) {
+        std::vector<uint32_t> generoIds(filas);
+        std::vector<uint8_t> tipos(filas);
+        std::vector<double> promedios(filas);
+        uint32_t estado = 12345;
+        for (size_t i = 0; i < filas; ++i) {
+            estado = estado * 1103515245u + 12345u;
+            generoIds[i] = (estado >> 8) % 4;
+            tipos[i] = static_cast<uint8_t>((estado >> 12) % 2);
+            promedios[i] = ((estado >> 16) % 41) / 8.0; // 0.0, 0.125, ... 5.0: incluye valores iguales al umbral
+        }
+        std::vector<size_t> esperadoGenero, esperadoTipo;
+        for (size_t i = 0; i < filas; ++i) {
+            if (generoIds[i] == 2 && promedios[i] >= 3.5) esperadoGenero.push_back(i);
+            if (tipos[i] == ColumnasCatalogo::kTipoPelicula && promedios[i] >= 3.5) esperadoTipo.push_back(i);
+        }
+
+        for (ImplementacionFiltro implementacion : implementaciones) {
+            if (!FiltroVectorial::EstaDisponible(implementacion)) {
+                continue;
+            }
+            MapaSeleccion mapa;
+            FiltroVectorial::FiltrarGeneroYCalificacion(generoIds.data(), promedios.data(), filas, 2, 3.5, mapa, implementacion);
+            EXPECT_EQ(mapa.size(), (filas + 63) / 64);
+            EXPECT_EQ(FiltroVectorial::FilasSeleccionadas(mapa), esperadoGenero) << "filas=" << filas;
+            FiltroVectorial::FiltrarTipoYCalificacion(tipos.data(), promedios.data(), filas,
+                                                      ColumnasCatalogo::kTipoPelicula, 3.5, mapa, implementacion);
+            EXPECT_EQ(FiltroVectorial::FilasSeleccionadas(mapa), esperadoTipo) << "filas=" << filas;
+        }
+    }
+}
+
+TEST(ServicioStreamingTest, ConsultasVectorialesIgualesAlRecorridoSimple) {
+    OutputRedirector redirector;
+    std::ofstream dummy_file("temp_filtro_vectorial.txt");
+    const char* generos[] = {"Drama", "Comedy", "Action"};
+    for (int i = 0; i < 300; ++i) {
+        dummy_file << (i % 3 == 0 ? "Serie" : "Pelicula") << ",V" << i << ",Title " << i << ",60,"
+                   << generos[i % 3] << "," << 1 + i % 5 << "-" << 1 + (i / 5) % 5 << "\n";
+    }
+    dummy_file.close();
+    ServicioStreaming servicio;
+    servicio.CargarArchivo("temp_filtro_vectorial.txt");
+    auto todos = servicio.BuscarVideos(0.0, "");
+    ASSERT_EQ(todos.size(), 300u);
+
+    for (double minimo : {0.0, 2.5, 3.0, 4.5, 5.0}) {
+        std::vector<const Video*> generoEsperado, peliculasEsperadas;
+        for (const Video* video : todos) {
+            if (video->GetGenero() == "Comedy" && video->GetCalificacionPromedio() >= minimo) generoEsperado.push_back(video);
+            if (dynamic_cast<const Pelicula*>(video) && video->GetCalificacionPromedio() >= minimo) peliculasEsperadas.push_back(video);
+        }
+        EXPECT_EQ(servicio.BuscarVideos(minimo, "comedy"), generoEsperado) << "minimo=" << minimo;
+        EXPECT_EQ(servicio.BuscarPeliculas(minimo), peliculasEsperadas) << "minimo=" << minimo;
+    }
+    std::remove("temp_filtro_vectorial.txt");
+}
+
+// ============================================================================================
+// ============================== TIPO DE CONTENIDO ===========================================
+// ============================================================================================
+
+TEST(VideoTest, TipoContenidoSinRtti) {
+    Pelicula pelicula("P1", "Movie", 90, "Drama");
+    Serie serie("S1", "Series", 30, "Drama");
+    EXPECT_EQ(pelicula.GetTipo(), TipoContenido::Pelicula);
+    EXPECT_EQ(serie.GetTipo(), TipoContenido::Serie);
+
+    const Video& comoVideoPelicula = pelicula;
+    Video& comoVideoSerie = serie;
+    EXPECT_EQ(ComoPelicula(comoVideoPelicula), &pelicula);
+    EXPECT_EQ(ComoSerie(comoVideoPelicula), nullptr);
+    EXPECT_EQ(ComoSerie(comoVideoSerie), &serie);
+    EXPECT_EQ(ComoPelicula(comoVideoSerie), nullptr);
+    ComoSerie(comoVideoSerie)->AgregarEpisodio(Episodio("Ep", 1));
+    EXPECT_EQ(serie.GetEpisodios().size(), 1u);
+}
+
+// ============================================================================================
+// ================================ ARENA DEL CATALOGO ========================================
+// ============================================================================================
+
+// Recurso que cuenta lo que pide y devuelve, delegando en el heap
+class RecursoContador : public std::pmr::memory_resource {
+public:
+    std::size_t reservas = 0;
+    std::size_t liberaciones = 0;
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alineacion) override {
+        ++reservas;
+        return std::pmr::new_delete_resource()->allocate(bytes, alineacion);
+    }
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alineacion) override {
+        ++liberaciones;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alineacion);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& otro) const noexcept override {
+        return this == &otro;
+    }
+};
+
+TEST(ArenaCatalogoTest, VideosYTextosSalenDeLaArena) {
+    RecursoContador heap;
+    ReporteCarga reporte;
+    {
+        std::pmr::monotonic_buffer_resource arena(&heap);
+        std::vector<PtrVideo> videos;
+        // Cualquier reserva que no use la arena cae en el recurso nulo y lanza std::bad_alloc
+        std::pmr::memory_resource* anterior = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+        ParserCatalogo parser(reporte, &arena);
+        parser.ParsearTexto("Pelicula,P001,Una pelicula con un titulo bastante largo,120.5,Ciencia ficcion,5-4\n"
+                            "Serie,S001,Una serie con un titulo bastante largo,30.0,Drama,4;"
+                            "Episodio piloto con un titulo largo:1:5-3|Segundo episodio con titulo largo:1:4\n",
+                            videos);
+        std::pmr::set_default_resource(anterior);
+
+        ASSERT_EQ(videos.size(), 2u);
+        EXPECT_EQ(videos[0]->GetNombre(), "Una pelicula con un titulo bastante largo");
+        const Serie* serie = ComoSerie(*videos[1]);
+        ASSERT_NE(serie, nullptr);
+        ASSERT_EQ(serie->GetEpisodios().size(), 2u);
+        EXPECT_EQ(serie->GetEpisodios()[0].GetTitulo(), "Episodio piloto con un titulo largo");
+        EXPECT_DOUBLE_EQ(serie->GetEpisodios()[0].GetCalificacionPromedio(), 4.0);
+
+        // Destruir los videos no libera memoria: eso lo hace la arena de una vez
+        const std::size_t reservas = heap.reservas;
+        EXPECT_GT(reservas, 0u);
+        videos.clear();
+        EXPECT_EQ(heap.liberaciones, 0u);
+    }
+    EXPECT_EQ(heap.liberaciones, heap.reservas);
+    EXPECT_EQ(reporte.GetTotalErrores(), 0u);
+}
+
+TEST(ArenaCatalogoTest, RecargarReemplazaLaArena) {
+    OutputRedirector redirector;
+    std::ofstream dummy_file("temp_arena.txt");
+    dummy_file << "Serie,S001,Show,30.0,Drama,4;Ep1:1:5\n";
+    dummy_file << "Pelicula,P001,Movie,90.0,Action,3\n";
+    dummy_file.close();
+
+    ServicioStreaming servicio;
+    for (ModoCarga modo : {ModoCarga::Flujo, ModoCarga::Mapeado, ModoCarga::Paralelo, ModoCarga::Flujo}) {
+        servicio.CargarArchivo("temp_arena.txt", modo, 2);
+        EXPECT_EQ(servicio.GetNumeroArenas(), 1u);
+        EXPECT_EQ(servicio.BuscarVideos(0.0, "").size(), 2u);
+    }
+
+    // Los episodios agregados después de la carga viven en la misma arena que su serie
+    EXPECT_TRUE(servicio.AgregarEpisodio("show", Episodio("Ep2", 1)));
+    redirector.Clear();
+    servicio.CalificarVideo("Ep2", 3);
+    EXPECT_NE(redirector.GetCout().find("Episodio 'Ep2' calificado. Nueva calificacion promedio: 3.0"), std::string::npos);
+
+    // Un snapshot inválido no descarta el catálogo ni su arena
+    std::ofstream invalido("temp_arena.snap", std::ios::binary);
+    invalido << "no es un snapshot";
+    invalido.close();
+    servicio.CargarArchivo("temp_arena.snap", ModoCarga::Snapshot);
+    EXPECT_EQ(servicio.GetNumeroArenas(), 1u);
+    EXPECT_EQ(servicio.BuscarVideos(0.0, "").size(), 2u);
+    std::remove("temp_arena.txt");
+    std::remove("temp_arena.snap");
+}
+
+// ============================================================================================
+// ============================ TEXTOS SIN COPIAS (STRING_VIEW) ===============================
+// ============================================================================================
+
+TEST(VideoTest, GettersDevuelvenVistasDelAlmacenamientoPropio) {
+    std::string id = "P001";
+    std::string nombre = "Una pelicula con un nombre bastante largo";
+    std::string genero = "Ciencia ficcion";
+    Pelicula pelicula(id, nombre, 120, genero);
+    // Un video independiente es dueño de sus textos: no depende de los originales
+    id.assign(id.size(), 'x');
+    nombre.assign(nombre.size(), 'x');
+    genero.clear();
+    EXPECT_EQ(pelicula.GetId(), "P001");
+    EXPECT_EQ(pelicula.GetNombre(), "Una pelicula con un nombre bastante largo");
+    EXPECT_EQ(pelicula.GetGenero(), "Ciencia ficcion");
+    // Los tres textos se guardan contiguos y cada llamada devuelve la misma vista
+    EXPECT_EQ(pelicula.GetNombre().data(), pelicula.GetId().data() + pelicula.GetId().size());
+    EXPECT_EQ(pelicula.GetGenero().data(), pelicula.GetNombre().data() + pelicula.GetNombre().size());
+    EXPECT_EQ(pelicula.GetNombre().data(), pelicula.GetNombre().data());
+
+    Serie serie("S001", "", 30, "Drama");
+    EXPECT_TRUE(serie.GetNombre().empty());
+    EXPECT_EQ(serie.GetGenero(), "Drama");
+    const Episodio& episodio = serie.AgregarEpisodio(std::string("Un episodio con un titulo largo"), 1);
+    EXPECT_EQ(episodio.GetTitulo(), "Un episodio con un titulo largo");
+
+    // Copiar un episodio copia su título
+    Episodio copia = episodio;
+    EXPECT_EQ(copia.GetTitulo(), episodio.GetTitulo());
+    EXPECT_NE(copia.GetTitulo().data(), episodio.GetTitulo().data());
+}
+
+// ============================================================================================
+// =============================== CALIFICACIONES CONCURRENTES ================================
+// ============================================================================================
+
+TEST(CalificacionesTest, AgregadoAtomicoEntreHilos) {
+    AgregadoCalificaciones agregado;
+    const int hilos = 8;
+    const int porHilo = 20000;
+    std::atomic<bool> inconsistente{false};
+    std::vector<std::thread> trabajadores;
+    for (int h = 0; h < hilos; ++h) {
+        trabajadores.emplace_back([&, h]() {
+            for (int i = 0; i < porHilo; ++i) {
+                agregado.Agregar(1 + (h + i) % 5);
+                // Conteo y suma se leen juntos: el promedio nunca sale del rango 1-5
+                const double promedio = agregado.GetPromedio();
+                if (promedio < 1.0 || promedio > 5.0) {
+                    inconsistente = true;
+                }
+            }
+        });
+    }
+    for (auto& trabajador : trabajadores) {
+        trabajador.join();
+    }
+    EXPECT_FALSE(inconsistente);
+    EXPECT_EQ(agregado.GetConteo(), static_cast<std::uint64_t>(hilos) * porHilo);
+    std::uint64_t sumaEsperada = 0;
+    for (int h = 0; h < hilos; ++h) {
+        for (int i = 0; i < porHilo; ++i) {
+            sumaEsperada += 1 + (h + i) % 5;
+        }
+    }
+    EXPECT_EQ(agregado.GetSuma(), sumaEsperada);
+    std::uint64_t total = 0;
+    for (int c = 1; c <= 5; ++c) {
+        total += agregado.GetFrecuencia(c);
+    }
+    EXPECT_EQ(total, agregado.GetConteo());
+
+    // Un lote que no cabe se rechaza completo
+    AgregadoCalificaciones lleno;
+    EXPECT_TRUE(lleno.Agregar(5, AgregadoCalificaciones::kConteoMaximo));
+    EXPECT_FALSE(lleno.Agregar(1));
+    EXPECT_EQ(lleno.GetConteo(), AgregadoCalificaciones::kConteoMaximo);
+    EXPECT_DOUBLE_EQ(lleno.GetPromedio(), 5.0);
+
+    // Un grupo de calificaciones distintas cambia conteo, suma e histograma de una vez, o nada
+    AgregadoCalificaciones grupo;
+    EXPECT_TRUE(grupo.Agregar(AgregadoCalificaciones::Frecuencias{2, 0, 1, 0, 3}));
+    EXPECT_EQ(grupo.GetConteo(), 6u);
+    EXPECT_EQ(grupo.GetSuma(), 2u + 3u + 15u);
+    EXPECT_EQ(grupo.GetFrecuencia(5), 3u);
+    EXPECT_FALSE(grupo.Agregar(AgregadoCalificaciones::Frecuencias{1, 0, 0, 0, AgregadoCalificaciones::kConteoMaximo - 6}));
+    EXPECT_EQ(grupo.GetConteo(), 6u);
+    EXPECT_EQ(grupo.GetFrecuencia(1), 2u);
+}
+
+TEST(ServicioStreamingTest, CalificacionesConcurrentesConConsultas) {
+    OutputRedirector redirector;
+    std::ofstream dummy_file("temp_concurrente.txt");
+    const char* generos[] = {"Drama", "Comedy"};
+    for (int i = 0; i < 40; ++i) {
+        if (i % 4 == 0) {
+            dummy_file << "Serie,S" << i << ",Title " << i << ",30," << generos[i % 2] << ",3;Ep " << i << ":1:4\n";
+        } else {
+            dummy_file << "Pelicula,P" << i << ",Title " << i << ",90," << generos[i % 2] << ",3\n";
+        }
+    }
+    dummy_file.close();
+    ServicioStreaming servicio;
+    servicio.CargarArchivo("temp_concurrente.txt");
+
+    const int escritores = 4;
+    const int lotes = 200;
+    std::atomic<int> activos{escritores};
+    std::atomic<bool> inconsistente{false};
+    std::vector<std::thread> hilos;
+    for (int h = 0; h < escritores; ++h) {
+        hilos.emplace_back([&, h]() {
+            std::vector<std::string> titulos;
+            for (int i = 0; i < 40; ++i) {
+                titulos.push_back("Title " + std::to_string(i));
+                titulos.push_back("Ep " + std::to_string(i)); // Solo existe para las series
+            }
+            for (int l = 0; l < lotes; ++l) {
+                std::vector<EventoCalificacion> eventos;
+                for (std::size_t t = 0; t < titulos.size(); ++t) {
+                    eventos.push_back({titulos[t], 1 + static_cast<int>((h + l + t) % 5)});
+                }
+                servicio.CalificarLote(eventos);
+            }
+            --activos;
+        });
+    }
+    // Lectores: las consultas corren mientras llegan calificaciones
+    for (int r = 0; r < 2; ++r) {
+        hilos.emplace_back([&]() {
+            while (activos > 0) {
+                for (const Video* video : servicio.BuscarVideos(0.0, "")) {
+                    const double promedio = video->GetCalificacionPromedio();
+                    if (promedio < 1.0 || promedio > 5.0) {
+                        inconsistente = true;
+                    }
+                }
+                servicio.BuscarVideos(3.0, "drama");
+                servicio.BuscarVideos(3.0, "");
+                servicio.BuscarPeliculas(2.5);
+                servicio.TopK(5, "comedy", TipoRanking::Peliculas);
+                servicio.TopK(5);
+            }
+        });
+    }
+    for (auto& hilo : hilos) {
+        hilo.join();
+    }
+    EXPECT_FALSE(inconsistente);
+
+    // Al terminar, cada título tiene todas sus calificaciones y los índices coinciden con un recorrido simple
+    auto todos = servicio.BuscarVideos(0.0, "");
+    ASSERT_EQ(todos.size(), 40u);
+    for (const Video* video : todos) {
+        EXPECT_EQ(video->GetCalificaciones().GetConteo(), 1u + escritores * lotes) << video->GetNombre();
+        if (const Serie* serie = ComoSerie(*video)) {
+            EXPECT_EQ(serie->GetEpisodios()[0].GetCalificaciones().GetConteo(), 1u + escritores * lotes);
+        }
+    }
+    for (double minimo : {0.0, 2.9, 3.0, 3.1}) {
+        std::vector<const Video*> esperados, peliculas;
+        for (const Video* video : todos) {
+            if (video->GetCalificacionPromedio() >= minimo) esperados.push_back(video);
+            if (video->GetCalificacionPromedio() >= minimo && ComoPelicula(*video)) peliculas.push_back(video);
+        }
+        EXPECT_EQ(servicio.BuscarVideos(minimo, ""), esperados) << "minimo=" << minimo;
+        EXPECT_EQ(servicio.BuscarPeliculas(minimo), peliculas) << "minimo=" << minimo;
+    }
+    // Las tablas por calificación también terminan con el promedio final de cada video
+    const auto ranking = servicio.TopK(todos.size());
+    ASSERT_EQ(ranking.size(), todos.size());
+    for (std::size_t i = 0; i < ranking.size(); ++i) {
+        EXPECT_DOUBLE_EQ(ranking[i].calificacion, ranking[i].video->GetCalificacionPromedio());
+        if (i > 0) {
+            EXPECT_GE(ranking[i - 1].calificacion, ranking[i].calificacion);
+        }
+    }
+    std::remove("temp_concurrente.txt");
+}
+
+// ============================================================================================
+// ================================= RECARGA EN CALIENTE ======================================
+// ============================================================================================
+
+TEST(ServicioStreamingTest, CatalogoTomadoSobreviveALaRecarga) {
+    OutputRedirector redirector;
+    std::ofstream("temp_recarga_a.txt") << "Pelicula,P1,Viejo,90,Drama,4\nSerie,S1,Serie Vieja,30,Drama,3;Ep Viejo:1:5\n";
+    std::ofstream("temp_recarga_b.txt") << "Pelicula,P2,Nuevo,90,Comedy,2\n";
+    ServicioStreaming servicio;
+    servicio.CargarArchivo("temp_recarga_a.txt");
+
+    std::shared_ptr<const Catalogo> anterior = servicio.GetCatalogo();
+    std::vector<const Video*> resultados = anterior->BuscarVideos(0.0, "drama");
+    const Serie* serie = anterior->BuscarSerie("serie vieja");
+    ASSERT_EQ(resultados.size(), 2u);
+    ASSERT_NE(serie, nullptr);
+
+    servicio.CargarArchivo("temp_recarga_b.txt");
+    // El servicio ya responde con el catálogo nuevo...
+    EXPECT_EQ(servicio.BuscarVideos(0.0, "drama").size(), 0u);
+    ASSERT_EQ(servicio.BuscarVideos(0.0, "").size(), 1u);
+    EXPECT_EQ(servicio.BuscarVideos(0.0, "")[0]->GetNombre(), "Nuevo");
+    EXPECT_NE(servicio.GetCatalogo(), anterior);
+    // ...y lo tomado antes de la recarga sigue vivo e intacto
+    EXPECT_EQ(resultados[0]->GetNombre(), "Viejo");
+    EXPECT_EQ(serie->GetEpisodios()[0].GetTitulo(), "Ep Viejo");
+    EXPECT_EQ(anterior->GetTamano(), 2u);
+
+    std::remove("temp_recarga_a.txt");
+    std::remove("temp_recarga_b.txt");
+}
+
+TEST(ServicioStreamingTest, CargaFallidaConservaElCatalogoPublicado) {
+    OutputRedirector redirector;
+    std::ofstream("temp_recarga_a.txt") << "Pelicula,P1,Viejo,90,Drama,4\n";
+    ServicioStreaming servicio;
+    servicio.CargarArchivo("temp_recarga_a.txt");
+    std::shared_ptr<const Catalogo> publicado = servicio.GetCatalogo();
+
+    servicio.CargarArchivo("no_existe.txt");
+    servicio.CargarArchivo("no_existe.txt", ModoCarga::Snapshot);
+    EXPECT_EQ(servicio.GetCatalogo(), publicado);
+    EXPECT_EQ(servicio.BuscarVideos(0.0, "").size(), 1u);
+    std::remove("temp_recarga_a.txt");
+}
+
+TEST(ServicioStreamingTest, ConsultasDuranteRecargasRepetidas) {
+    OutputRedirector redirector;
+    // Dos versiones con el mismo título y distinto tamaño: cada consulta ve una u otra, nunca una mezcla
+    for (int version = 0; version < 2; ++version) {
+        std::ofstream archivo("temp_recarga_" + std::to_string(version) + ".txt");
+        const int total = version == 0 ? 50 : 80;
+        for (int i = 0; i < total; ++i) {
+            archivo << "Pelicula,P" << i << ",Title " << i << ",90,Drama," << (version == 0 ? 2 : 4) << "\n";
+        }
+    }
+    ServicioStreaming servicio;
+    servicio.CargarArchivo("temp_recarga_0.txt");
+
+    std::atomic<bool> cargando{true};
+    std::atomic<bool> inconsistente{false};
+    std::atomic<int> consultas{0};
+    std::vector<std::thread> hilos;
+    for (int r = 0; r < 3; ++r) {
+        hilos.emplace_back([&]() {
+            while (cargando) {
+                std::shared_ptr<const Catalogo> catalogo = servicio.GetCatalogo();
+                const std::size_t total = catalogo->BuscarVideos(0.0, "").size();
+                const std::size_t altos = catalogo->BuscarVideos(3.0, "drama").size();
+                if (!((total == 50 && altos == 0) || (total == 80 && altos == 80))) {
+                    inconsistente = true;
+                }
+                if (servicio.BuscarSerie("Title 1") != nullptr || servicio.BuscarVideos(0.0, "").empty()) {
+                    inconsistente = true;
+                }
+                ++consultas;
+            }
+        });
+    }
+    // Un hilo califica mientras tanto (sobre la versión que esté publicada)
+    hilos.emplace_back([&]() {
+        while (cargando) {
+            servicio.CalificarLote({{"Title 3", 3}, {"Title 70", 5}});
+        }
+    });
+    for (int i = 0; i < 20; ++i) {
+        servicio.CargarArchivo("temp_recarga_" + std::to_string(i % 2) + ".txt", i % 3 == 0 ? ModoCarga::Mapeado : ModoCarga::Flujo);
+    }
+    cargando = false;
+    for (auto& hilo : hilos) {
+        hilo.join();
+    }
+    EXPECT_FALSE(inconsistente);
+    EXPECT_GT(consultas.load(), 0);
+    EXPECT_EQ(servicio.BuscarVideos(0.0, "").size(), 80u); // La última carga fue la versión 1
+    std::remove("temp_recarga_0.txt");
+    std::remove("temp_recarga_1.txt");
+}
+
+// ============================================================================================
+// ==================================== RANKING TOP-K =========================================
+// ============================================================================================
+
+TEST(TablaPosicionesTest, OrdenYActualizar) {
+    TablaPosiciones tabla;
+    tabla.Reconstruir({{3.0, 0}, {5.0, 1}, {1.0, 2}, {5.0, 3}, {4.0, 4}});
+    EXPECT_EQ(tabla.GetTamano(), 5u);
+    // A igual promedio, primero el identificador menor
+    using Entradas = std::vector<TablaPosiciones::Entrada>;
+    EXPECT_EQ(Entradas(tabla.begin(), tabla.end()), (Entradas{{5.0, 1}, {5.0, 3}, {4.0, 4}, {3.0, 0}, {1.0, 2}}));
+
+    tabla.Actualizar(2, 1.0, 4.5);
+    tabla.Actualizar(1, 5.0, 2.0);
+    tabla.Actualizar(4, 9.9, 1.0); // Promedio anterior incorrecto: se ignora
+    EXPECT_EQ(Entradas(tabla.begin(), tabla.end()), (Entradas{{5.0, 3}, {4.5, 2}, {4.0, 4}, {3.0, 0}, {2.0, 1}}));
+    EXPECT_EQ(tabla.GetTamano(), 5u);
+}
+
+TEST(IndiceCalificacionesTest, MejoresPorGeneroYTipo) {
+    std::vector<PtrVideo> videos;
+    const char* generos[] = {"Drama", "Comedy"};
+    int ratings[] = {3, 5, 1, 4, 5, 2};
+    for (int i = 0; i < 6; ++i) {
+        if (i % 3 == 2) {
+            videos.push_back(std::make_unique<Serie>("S" + std::to_string(i), "Serie " + std::to_string(i), 30, generos[i % 2]));
+        } else {
+            videos.push_back(std::make_unique<Pelicula>("P" + std::to_string(i), "Movie " + std::to_string(i), 90, generos[i % 2]));
+        }
+        videos.back()->Calificar(ratings[i]);
+        videos.back()->SetGeneroId(i % 2);
+    }
+    IndiceCalificaciones indice;
+    indice.Reconstruir(videos);
+    using Entradas = std::vector<TablaPosiciones::Entrada>;
+    CriterioFiltro todos;
+    EXPECT_EQ(indice.Mejores(4, todos), (Entradas{{5.0, 1}, {5.0, 4}, {4.0, 3}, {3.0, 0}}));
+    CriterioFiltro drama;
+    drama.generoId = 0;
+    EXPECT_EQ(indice.Mejores(10, drama), (Entradas{{5.0, 4}, {3.0, 0}, {1.0, 2}}));
+    CriterioFiltro seriesComedia;
+    seriesComedia.generoId = 1;
+    seriesComedia.tipo = ColumnasCatalogo::kTipoSerie;
+    EXPECT_EQ(indice.Mejores(10, seriesComedia), (Entradas{{2.0, 5}}));
+    CriterioFiltro minimo;
+    minimo.calificacionMinima = 4.0;
+    EXPECT_EQ(indice.Mejores(10, minimo), (Entradas{{5.0, 1}, {5.0, 4}, {4.0, 3}}));
+    EXPECT_TRUE(indice.Mejores(0, todos).empty());
+
+    indice.Actualizar(2, 4.5);
+    EXPECT_EQ(indice.Mejores(3, drama), (Entradas{{5.0, 4}, {4.5, 2}, {3.0, 0}}));
+    EXPECT_EQ(indice.BuscarDesde(4.0), (std::vector<size_t>{1, 2, 3, 4}));
+}
+
+TEST(ServicioStreamingTest, TopKPorGeneroYTipo) {
+    OutputRedirector redirector;
+    std::ofstream("temp_topk.txt")
+        << "Pelicula,P1,Peli Uno,90,Drama,3\n"
+        << "Pelicula,P2,Peli Dos,90,Comedy,5\n"
+        << "Serie,S1,Serie Uno,30,Drama,4;Ep A:1:5|Ep B:1:2\n"
+        << "Pelicula,P3,Peli Tres,90,Drama,5\n"
+        << "Serie,S2,Serie Dos,30,Comedy,1;Ep C:2:5|Ep D:1:4\n";
+    ServicioStreaming servicio;
+    servicio.CargarArchivo("temp_topk.txt");
+
+    auto nombres = [](const std::vector<PosicionRanking>& posiciones) {
+        std::vector<std::string> resultado;
+        for (const auto& posicion : posiciones) {
+            resultado.emplace_back(posicion.episodio != nullptr ? posicion.episodio->GetTitulo() : posicion.video->GetNombre());
+        }
+        return resultado;
+    };
+    using Nombres = std::vector<std::string>;
+    EXPECT_EQ(nombres(servicio.TopK(3)), (Nombres{"Peli Dos", "Peli Tres", "Serie Uno"}));
+    EXPECT_EQ(nombres(servicio.TopK(10, "DRAMA")), (Nombres{"Peli Tres", "Serie Uno", "Peli Uno"}));
+    EXPECT_EQ(nombres(servicio.TopK(10, "comedy", TipoRanking::Series)), (Nombres{"Serie Dos"}));
+    EXPECT_EQ(nombres(servicio.TopK(2, "", TipoRanking::Peliculas)), (Nombres{"Peli Dos", "Peli Tres"}));
+    EXPECT_EQ(nombres(servicio.TopK(3, "", TipoRanking::Episodios)), (Nombres{"Ep A", "Ep C", "Ep D"}));
+    EXPECT_EQ(nombres(servicio.TopK(10, "comedy", TipoRanking::Episodios)), (Nombres{"Ep C", "Ep D"}));
+    auto episodios = servicio.TopK(1, "drama", TipoRanking::Episodios);
+    ASSERT_EQ(episodios.size(), 1u);
+    EXPECT_EQ(episodios[0].video->GetNombre(), "Serie Uno");
+    EXPECT_DOUBLE_EQ(episodios[0].calificacion, 5.0);
+    EXPECT_TRUE(servicio.TopK(0).empty());
+    EXPECT_TRUE(servicio.TopK(5, "Terror").empty());
+
+    // Las tablas de posiciones siguen a las calificaciones
+    servicio.CalificarVideo("Peli Uno", 5);
+    servicio.CalificarVideo("Peli Uno", 5); // (3+5+5)/3 = 4.33
+    servicio.CalificarLote({{"Peli Dos", 1}, {"Serie Dos", 5}, {"Serie Dos", 5}});
+    EXPECT_EQ(nombres(servicio.TopK(2, "drama")), (Nombres{"Peli Tres", "Peli Uno"}));
+    EXPECT_EQ(nombres(servicio.TopK(10, "comedy")), (Nombres{"Serie Dos", "Peli Dos"}));
+    // Y coinciden con ordenar todo el catálogo
+    std::vector<const Video*> todos = servicio.BuscarVideos(0.0, "");
+    std::stable_sort(todos.begin(), todos.end(), [](const Video* a, const Video* b) {
+        return a->GetCalificacionPromedio() > b->GetCalificacionPromedio();
+    });
+    auto top = servicio.TopK(todos.size());
+    ASSERT_EQ(top.size(), todos.size());
+    for (std::size_t i = 0; i < top.size(); ++i) {
+        EXPECT_EQ(top[i].video, todos[i]) << "posicion " << i;
+        EXPECT_DOUBLE_EQ(top[i].calificacion, todos[i]->GetCalificacionPromedio());
+    }
+    std::remove("temp_topk.txt");
+}
+
+TEST(ServicioStreamingTest, MostrarTopK) {
+    OutputRedirector redirector;
+    std::ofstream("temp_topk.txt")
+        << "Pelicula,P1,Peli Uno,90,Drama,3\n"
+        << "Serie,S1,Serie Uno,30,Drama,4;Ep A:1:5|Ep B:1:2\n";
+    ServicioStreaming servicio;
+    servicio.CargarArchivo("temp_topk.txt");
+    redirector.Clear();
+
+    servicio.MostrarTopK(5, "", TipoRanking::Videos);
+    EXPECT_EQ(redirector.GetCout(),
+              "1. Serie 'Serie Uno' (Drama) - Calificacion promedio: 4.0\n"
+              "2. Pelicula 'Peli Uno' (Drama) - Calificacion promedio: 3.0\n");
+    redirector.Clear();
+    servicio.MostrarTopK(1, "drama", TipoRanking::Episodios);
+    EXPECT_EQ(redirector.GetCout(), "1. Episodio 'Ep A' de 'Serie Uno' (temporada 1) - Calificacion promedio: 5.0\n");
+    redirector.Clear();
+    servicio.MostrarTopK(3, "Terror", TipoRanking::Videos);
+    EXPECT_EQ(redirector.GetCout(), "No se encontraron contenidos para el ranking.\n");
+    std::remove("temp_topk.txt");
+}
+
+// ============================================================================================
+// ================================ BUSQUEDA DE TITULOS =======================================
+// ============================================================================================
+
+namespace {
+std::vector<PtrVideo> VideosConTitulos(const std::vector<std::string>& titulos) {
+    std::vector<PtrVideo> videos;
+    for (std::size_t i = 0; i < titulos.size(); ++i) {
+        videos.push_back(std::make_unique<Pelicula>("P" + std::to_string(i), titulos[i], 90, "Drama"));
+    }
+    return videos;
+}
+
+std::vector<std::size_t> Posiciones(const std::vector<CoincidenciaTitulo>& coincidencias) {
+    std::vector<std::size_t> resultado;
+    for (const auto& coincidencia : coincidencias) {
+        resultado.push_back(coincidencia.posicion);
+    }
+    return resultado;
+}
+} // namespace
+
+TEST(BuscadorTitulosTest, NormalizarIgnoraMayusculasYSignos) {
+    std::string normalizado;
+    BuscadorTitulos::Normalizar("  Breaking-Bad: THE Movie!", normalizado);
+    EXPECT_EQ(normalizado, "breaking bad the movie ");
+    BuscadorTitulos::Normalizar("...", normalizado);
+    EXPECT_EQ(normalizado, "");
+}
+
+TEST(BuscadorTitulosTest, PrefijoDeTituloYDePalabra) {
+    BuscadorTitulos buscador;
+    auto videos = VideosConTitulos({"Breaking Bad", "Bad Boys", "Breaking Point", "The Bad Batch", "Unbreakable", "Bad Bad Bad"});
+    buscador.Reconstruir(videos);
+    EXPECT_EQ(buscador.GetTamano(), 6u);
+
+    using Pos = std::vector<std::size_t>;
+    // Comienzo de título en orden alfabético, sin confundir "unbreakable"
+    EXPECT_EQ(Posiciones(buscador.BuscarPrefijo("BREAKING", 10)), (Pos{0, 2}));
+    // Primero los títulos que empiezan con "bad" y después los que tienen otra palabra que empieza así
+    EXPECT_EQ(Posiciones(buscador.BuscarPrefijo("bad", 10)), (Pos{5, 1, 0, 3}));
+    EXPECT_EQ(Posiciones(buscador.BuscarPrefijo("bad", 2)), (Pos{5, 1}));
+    EXPECT_EQ(Posiciones(buscador.BuscarPrefijo("breaking-b", 10)), (Pos{0}));
+    // Con espacio final la palabra debe estar completa: "Breaking Bad" ya no coincide
+    EXPECT_EQ(Posiciones(buscador.BuscarPrefijo("bad ", 10)), (Pos{5, 1, 3}));
+    EXPECT_TRUE(buscador.BuscarPrefijo("zzz", 10).empty());
+    EXPECT_TRUE(buscador.BuscarPrefijo("", 10).empty());
+
+    auto exacta = buscador.BuscarPrefijo("breaking bad", 1);
+    ASSERT_EQ(exacta.size(), 1u);
+    EXPECT_DOUBLE_EQ(exacta[0].puntaje, 1.0);
+}
+
+TEST(BuscadorTitulosTest, AproximadoToleraErroresDeTipeo) {
+    BuscadorTitulos buscador;
+    auto videos = VideosConTitulos({"Breaking Bad", "Better Call Saul", "Braking Point", "Game of Thrones", "Breaking Bad"});
+    buscador.Reconstruir(videos);
+
+    auto resultado = buscador.BuscarAproximado("braeking bad", 10);
+    ASSERT_GE(resultado.size(), 2u);
+    // Los dos "Breaking Bad" empatan: primero el anterior en el catálogo
+    EXPECT_EQ(resultado[0].posicion, 0u);
+    EXPECT_EQ(resultado[1].posicion, 4u);
+    EXPECT_GT(resultado[0].puntaje, 0.5);
+    for (std::size_t i = 1; i < resultado.size(); ++i) {
+        EXPECT_GE(resultado[i - 1].puntaje, resultado[i].puntaje);
+    }
+    EXPECT_EQ(buscador.BuscarAproximado("game of thornes", 1)[0].posicion, 3u);
+    EXPECT_TRUE(buscador.BuscarAproximado("xyzzy", 10).empty());
+    EXPECT_TRUE(buscador.BuscarAproximado("breaking bad", 0).empty());
+
+    // Consultas cortas: la mitad de los trigramas; largas: todos salvo tres por error tolerado
+    EXPECT_EQ(BuscadorTitulos::MinimoComunes(1), 1u);
+    EXPECT_EQ(BuscadorTitulos::MinimoComunes(7), 4u);
+    EXPECT_EQ(BuscadorTitulos::MinimoComunes(30), 30u - 3 * BuscadorTitulos::kErroresMaximos);
+}
+
+TEST(BuscadorTitulosTest, AproximadoIgualQueCompararTodosLosTitulos) {
+    std::vector<std::string> titulos;
+    const char* palabras[] = {"amor", "noche", "ciudad", "perdida", "sombra", "rio", "luz", "guerra", "mar", "tiempo"};
+    for (std::size_t i = 0; i < 400; ++i) {
+        titulos.push_back(std::string(palabras[i % 10]) + " " + palabras[(i / 10) % 10] + " " + std::to_string(i % 7));
+    }
+    auto videos = VideosConTitulos(titulos);
+    BuscadorTitulos buscador;
+    buscador.Reconstruir(videos);
+
+    // Trigramas con el mismo relleno de espacios que usa el buscador
+    auto trigramas = [](const std::string& texto) {
+        std::string normalizado;
+        BuscadorTitulos::Normalizar(texto, normalizado);
+        if (!normalizado.empty() && normalizado.back() == ' ') normalizado.pop_back();
+        std::string rodeado = " " + normalizado + " ";
+        std::set<std::string> resultado;
+        for (std::size_t i = 0; i + 3 <= rodeado.size(); ++i) {
+            resultado.insert(rodeado.substr(i, 3));
+        }
+        return resultado;
+    };
+    for (const std::string consulta : {"amro noche", "sombar rio 3", "ciudda perdia", "luz", "guera del mar",
+                                     "la sombra del rio y la ciudad perdida"}) {
+        const auto buscados = trigramas(consulta);
+        const std::size_t minimo = BuscadorTitulos::MinimoComunes(buscados.size());
+        std::vector<CoincidenciaTitulo> esperados;
+        for (std::size_t i = 0; i < titulos.size(); ++i) {
+            const auto propios = trigramas(titulos[i]);
+            std::size_t comunes = 0;
+            for (const auto& t : buscados) comunes += propios.count(t);
+            if (comunes >= minimo) {
+                esperados.push_back({i, 2.0 * comunes / (buscados.size() + propios.size())});
+            }
+        }
+        std::stable_sort(esperados.begin(), esperados.end(), [](const CoincidenciaTitulo& a, const CoincidenciaTitulo& b) {
+            return a.puntaje > b.puntaje;
+        });
+        auto obtenidos = buscador.BuscarAproximado(consulta, titulos.size());
+        ASSERT_EQ(obtenidos.size(), esperados.size()) << consulta;
+        for (std::size_t i = 0; i < obtenidos.size(); ++i) {
+            EXPECT_EQ(obtenidos[i].posicion, esperados[i].posicion) << consulta;
+            EXPECT_DOUBLE_EQ(obtenidos[i].puntaje, esperados[i].puntaje) << consulta;
+        }
+    }
+}
+
+TEST(ServicioStreamingTest, BuscarTitulosYSugerencias) {
+    OutputRedirector redirector;
+    std::ofstream("temp_titulos.txt")
+        << "Serie,S1,Breaking Bad,45,Drama,5;Pilot:1:5\n"
+        << "Pelicula,P1,Breaking Point,90,Action,3\n"
+        << "Serie,S2,Better Call Saul,45,Drama,4;Uno:1:4\n";
+    ServicioStreaming servicio;
+    servicio.CargarArchivo("temp_titulos.txt");
+
+    auto nombres = [](const std::vector<const Video*>& videos) {
+        std::vector<std::string> resultado;
+        for (const Video* video : videos) resultado.emplace_back(video->GetNombre());
+        return resultado;
+    };
+    using Nombres = std::vector<std::string>;
+    EXPECT_EQ(nombres(servicio.BuscarTitulos("breaking")), (Nombres{"Breaking Bad", "Breaking Point"}));
+    EXPECT_EQ(nombres(servicio.BuscarTitulos("saul")), (Nombres{"Better Call Saul"}));
+    // Prefijo primero, completado con títulos parecidos
+    EXPECT_EQ(nombres(servicio.BuscarTitulos("braking bad", 1)), (Nombres{"Breaking Bad"}));
+    EXPECT_EQ(servicio.BuscarTitulos("breaking", 1).size(), 1u);
+
+    redirector.Clear();
+    servicio.CalificarVideo("breaking", 4);
+    EXPECT_EQ(redirector.GetCout(), "Video o episodio 'breaking' no encontrado.\n"
+                                    "Quizas quiso decir: 'Breaking Bad', 'Breaking Point'\n");
+    redirector.Clear();
+    // Al buscar una serie solo se sugieren series
+    servicio.MostrarEpisodiosDeSerieConCalificacion("breaking", 0.0);
+    EXPECT_EQ(redirector.GetCout(), "Serie 'breaking' no encontrada.\n"
+                                    "Quizas quiso decir: 'Breaking Bad'\n");
+    redirector.Clear();
+    servicio.CalificarVideo("zzzz", 4);
+    EXPECT_EQ(redirector.GetCout(), "Video o episodio 'zzzz' no encontrado.\n");
+    std::remove("temp_titulos.txt");
+}
+
+// ============================================================================================
+// ================================= BUSQUEDA DE TEXTO ========================================
+// ============================================================================================
+
+TEST(ListaPostingsTest, CursorRecorreYSaltaBloques) {
+    // Diferencias de uno, dos y tres bytes, y varios bloques
+    std::vector<std::uint32_t> documentos;
+    for (std::uint32_t i = 0, documento = 3; i < 1000; ++i) {
+        documentos.push_back(documento);
+        documento += (i % 10 == 0) ? 20000 : (i % 3 == 0 ? 200 : 1);
+    }
+    ListaPostings lista;
+    for (std::uint32_t documento : documentos) {
+        lista.Agregar(documento);
+        lista.Agregar(documento); // Repetido: se ignora
+    }
+    ASSERT_EQ(lista.GetTamano(), documentos.size());
+    EXPECT_LT(lista.GetBytes(), documentos.size() * sizeof(std::uint32_t));
+
+    std::vector<std::uint32_t> recorridos;
+    ListaPostings::Cursor cursor(lista);
+    for (std::uint32_t d = cursor.Actual(); d != ListaPostings::kFin; d = cursor.Siguiente()) {
+        recorridos.push_back(d);
+    }
+    EXPECT_EQ(recorridos, documentos);
+
+    // Avanzar equivale a lower_bound desde la posición actual
+    ListaPostings::Cursor saltador(lista);
+    for (std::uint32_t objetivo : {0u, 3u, 4u, 250u, 250u, 20500u, 700000u, 700001u, documentos.back(), documentos.back() + 1}) {
+        auto esperado = std::lower_bound(documentos.begin(), documentos.end(), std::max(objetivo, saltador.Actual()));
+        EXPECT_EQ(saltador.Avanzar(objetivo), esperado == documentos.end() ? ListaPostings::kFin : *esperado) << objetivo;
+    }
+    EXPECT_EQ(ListaPostings::Cursor(ListaPostings()).Actual(), ListaPostings::kFin);
+}
+
+TEST(IndiceTextualTest, ConsultasIgualQueEvaluarCadaDocumento) {
+    // Documentos con las palabras a..e según los bits de su número
+    const char* letras[] = {"alfa", "beta", "gama", "delta", "epsilon"};
+    std::vector<PtrVideo> videos;
+    for (std::size_t i = 0; i < 700; ++i) {
+        std::string titulo;
+        for (std::size_t b = 0; b < 5; ++b) {
+            if ((i * 37 + i / 5) >> b & 1) titulo += std::string(letras[b]) + " ";
+        }
+        videos.push_back(std::make_unique<Pelicula>("P" + std::to_string(i), titulo + "x", 90, i % 3 == 0 ? "Drama" : "Comedia"));
+    }
+    IndiceTextual indice;
+    for (const auto& video : videos) indice.AgregarVideo(*video);
+    EXPECT_EQ(indice.GetDocumentos(), videos.size());
+    EXPECT_EQ(indice.GetPalabras(), 5u + 1 + 2); // Las letras, "x" y los dos géneros
+
+    using Predicado = bool (*)(const std::set<std::string>&);
+    const std::vector<std::pair<std::string, Predicado>> consultas = {
+        {"alfa AND beta", [](const std::set<std::string>& p) { return p.count("alfa") && p.count("beta"); }},
+        {"alfa beta", [](const std::set<std::string>& p) { return p.count("alfa") && p.count("beta"); }},
+        {"ALFA OR gama", [](const std::set<std::string>& p) { return p.count("alfa") || p.count("gama"); }},
+        {"drama AND alfa NOT delta", [](const std::set<std::string>& p) { return p.count("drama") && p.count("alfa") && !p.count("delta"); }},
+        {"NOT beta", [](const std::set<std::string>& p) { return !p.count("beta"); }},
+        {"NOT beta NOT gama", [](const std::set<std::string>& p) { return !p.count("beta") && !p.count("gama"); }},
+        {"NOT beta OR drama", [](const std::set<std::string>& p) { return !p.count("beta") || p.count("drama"); }},
+        {"(alfa OR beta) AND NOT (gama OR epsilon)", [](const std::set<std::string>& p) {
+             return (p.count("alfa") || p.count("beta")) && !(p.count("gama") || p.count("epsilon")); }},
+        {"comedia AND (NOT alfa OR NOT beta)", [](const std::set<std::string>& p) {
+             return p.count("comedia") && (!p.count("alfa") || !p.count("beta")); }},
+        {"alfa OR inexistente", [](const std::set<std::string>& p) { return p.count("alfa") > 0; }},
+        {"alfa AND inexistente", [](const std::set<std::string>&) { return false; }},
+        {"NOT inexistente", [](const std::set<std::string>&) { return true; }},
+    };
+    for (const auto& [consulta, cumple] : consultas) {
+        std::vector<const Video*> esperados;
+        for (const auto& video : videos) {
+            std::set<std::string> palabras;
+            std::istringstream texto(std::string(video->GetNombre()) + " " + std::string(video->GetGenero()));
+            for (std::string palabra; texto >> palabra;) {
+                std::transform(palabra.begin(), palabra.end(), palabra.begin(), ::tolower);
+                palabras.insert(palabra);
+            }
+            if (cumple(palabras)) esperados.push_back(video.get());
+        }
+        std::vector<const Video*> obtenidos;
+        for (const auto& resultado : indice.Buscar(consulta)) obtenidos.push_back(resultado.video);
+        EXPECT_EQ(obtenidos, esperados) << consulta;
+    }
+}
+
+TEST(IndiceTextualTest, ConsultasMalFormadasNoFallan) {
+    std::vector<PtrVideo> videos = VideosConTitulos({"Ciencia Ficcion", "Ciencia Natural", "Ficcion"});
+    IndiceTextual indice;
+    for (const auto& video : videos) indice.AgregarVideo(*video);
+    auto cuantos = [&](const std::string& consulta) { return indice.Buscar(consulta).size(); };
+    EXPECT_EQ(cuantos(""), 0u);
+    EXPECT_EQ(cuantos("AND OR NOT"), 0u);
+    EXPECT_EQ(cuantos("ciencia AND"), 2u);
+    EXPECT_EQ(cuantos("OR ficcion"), 2u);
+    EXPECT_EQ(cuantos("(ciencia OR ficcion"), 3u);
+    EXPECT_EQ(cuantos("ciencia) natural"), 1u);
+    // Una palabra con guion son dos palabras; el NOT se aplica a ambas juntas
+    EXPECT_EQ(cuantos("Ciencia-Ficcion"), 1u);
+    EXPECT_EQ(cuantos("NOT ciencia-ficcion"), 2u);
+    // Los operadores solo cuentan en mayúsculas
+    EXPECT_EQ(cuantos("ciencia or ficcion"), 0u);
+}
+
+TEST(ServicioStreamingTest, BuscarTextoSobreEpisodiosYGeneros) {
+    OutputRedirector redirector;
+    std::ofstream("temp_texto.txt")
+        << "Serie,S1,Breaking Bad,45,Drama,5;Pilot:1:5|Cat's in the Bag:1:4\n"
+        << "Serie,S2,The Office,22,Comedia,4;Pilot:1:3\n"
+        << "Pelicula,P1,Pilot Error,90,Drama,3\n";
+    ServicioStreaming servicio;
+    servicio.CargarArchivo("temp_texto.txt");
+
+    auto describir = [](const std::vector<ResultadoTexto>& resultados) {
+        std::vector<std::string> textos;
+        for (const auto& r : resultados) {
+            textos.push_back(r.episodio != nullptr ? std::string(r.video->GetNombre()) + "/" + std::string(r.episodio->GetTitulo())
+                                                   : std::string(r.video->GetNombre()));
+        }
+        return textos;
+    };
+    using Textos = std::vector<std::string>;
+    // Un episodio tiene el género de su serie
+    EXPECT_EQ(describir(servicio.BuscarTexto("drama AND pilot NOT comedia")), (Textos{"Breaking Bad/Pilot", "Pilot Error"}));
+    EXPECT_EQ(describir(servicio.BuscarTexto("pilot NOT drama")), (Textos{"The Office/Pilot"}));
+    EXPECT_EQ(describir(servicio.BuscarTexto("bag OR office")), (Textos{"Breaking Bad/Cat's in the Bag", "The Office"}));
+
+    // Los episodios agregados después de la carga también se indexan
+    ASSERT_TRUE(servicio.AgregarEpisodio("The Office", Episodio("Diversity Day", 1)));
+    EXPECT_EQ(describir(servicio.BuscarTexto("comedia day")), (Textos{"The Office/Diversity Day"}));
+
+    redirector.Clear();
+    servicio.MostrarBusquedaTexto("pilot AND drama");
+    EXPECT_EQ(redirector.GetCout(), "Episodio 'Pilot' de 'Breaking Bad' (temporada 1)\n"
+                                    "Pelicula 'Pilot Error' (Drama)\n");
+    redirector.Clear();
+    servicio.MostrarBusquedaTexto("pilot AND musical");
+    EXPECT_EQ(redirector.GetCout(), "No se encontraron contenidos para la consulta.\n");
+    std::remove("temp_texto.txt");
+}
+
+// ============================================================================================
+// ============================== FILTRADO SIN CARGAR (FLUJO) =================================
+// ============================================================================================
+
+TEST(FiltroFlujoTest, MismoResultadoQueCargarYConsultar) {
+    OutputRedirector redirector;
+    std::ofstream archivo("temp_flujo.txt", std::ios::binary);
+    for (int i = 0; i < 300; ++i) {
+        const char* genero = (i % 3 == 0) ? "Drama" : (i % 3 == 1 ? "comedia" : "Accion");
+        if (i % 2 == 0) {
+            archivo << "Pelicula,P" << i << ",Pelicula " << i << ",90," << genero << ',' << 1 + i % 5 << '-' << 1 + (i / 5) % 5 << "\r\n";
+        } else {
+            archivo << "Serie,S" << i << ",Serie " << i << ",45," << genero << ',' << 1 + i % 5 << ";Ep:1:5|Ep2:2:3\n";
+        }
+        if (i % 50 == 0) archivo << "\nDocumental,D1,Otro,10,Drama,5\n";
+    }
+    archivo.close();
+    ServicioStreaming servicio;
+    servicio.CargarArchivo("temp_flujo.txt");
+
+    auto filtrar = [&](const CriterioFlujo& criterio, ResumenFlujo* resumen = nullptr) {
+        std::vector<std::string> nombres;
+        ResumenFlujo r = servicio.FiltrarArchivo("temp_flujo.txt", criterio, [&](const Video& video) {
+            nombres.emplace_back(video.GetNombre());
+        });
+        if (resumen != nullptr) *resumen = r;
+        return nombres;
+    };
+    auto nombres = [](const std::vector<const Video*>& videos) {
+        std::vector<std::string> resultado;
+        for (const Video* video : videos) resultado.emplace_back(video->GetNombre());
+        return resultado;
+    };
+
+    CriterioFlujo porGenero;
+    porGenero.genero = "COMEDIA";
+    porGenero.calificacionMinima = 3.0;
+    ResumenFlujo resumen;
+    EXPECT_EQ(filtrar(porGenero, &resumen), nombres(servicio.BuscarVideos(3.0, "comedia")));
+    EXPECT_TRUE(resumen.abierto);
+    EXPECT_EQ(resumen.lineas, 300u + 2 * 6);
+    EXPECT_EQ(resumen.videos, 300u);
+    EXPECT_EQ(resumen.bufferMaximo, FiltroFlujo::kBloqueLectura);
+
+    CriterioFlujo peliculas;
+    peliculas.soloPeliculas = true;
+    peliculas.calificacionMinima = 2.5;
+    EXPECT_EQ(filtrar(peliculas, &resumen), nombres(servicio.BuscarPeliculas(2.5)));
+    EXPECT_EQ(resumen.videos, 150u); // Las series no se parsean
+
+    EXPECT_EQ(filtrar(CriterioFlujo()).size(), 300u);
+    std::remove("temp_flujo.txt");
+}
+
+TEST(FiltroFlujoTest, LineaMasLargaQueElBloqueDeLectura) {
+    // Una serie con tantos episodios que su línea no cabe en un bloque, sin salto de línea final
+    std::string texto = "Pelicula,P1,Corta,90,Drama,5\nSerie,S1,Larga,45,Drama,4;";
+    for (int e = 0; texto.size() < FiltroFlujo::kBloqueLectura + 1000; ++e) {
+        texto += "Episodio " + std::to_string(e) + ":1:5|";
+    }
+    const std::size_t episodios = static_cast<std::size_t>(std::count(texto.begin(), texto.end(), '|'));
+    std::istringstream entrada(texto);
+    std::ostringstream advertencias;
+    FiltroFlujo filtro(CriterioFlujo(), advertencias);
+    std::vector<std::pair<std::string, std::size_t>> vistos;
+    ResumenFlujo resumen = filtro.Procesar(entrada, [&](const Video& video) {
+        const Serie* serie = ComoSerie(video);
+        vistos.emplace_back(std::string(video.GetNombre()), serie != nullptr ? serie->GetEpisodios().size() : 0);
+    });
+    ASSERT_EQ(vistos.size(), 2u);
+    EXPECT_EQ(vistos[0], (std::pair<std::string, std::size_t>{"Corta", 0}));
+    EXPECT_EQ(vistos[1], (std::pair<std::string, std::size_t>{"Larga", episodios}));
+    EXPECT_EQ(resumen.lineas, 2u);
+    EXPECT_EQ(resumen.bufferMaximo, 2 * FiltroFlujo::kBloqueLectura);
+    EXPECT_TRUE(advertencias.str().empty());
+}
+
+TEST(ServicioStreamingTest, MostrarFiltroArchivo) {
+    OutputRedirector redirector;
+    std::ofstream("temp_flujo.txt") << "Pelicula,P1,Inception,148,Ciencia Ficcion,5-4\n"
+                                    << "Pelicula,P2,Mala,90,Ciencia Ficcion,1\n"
+                                    << "Serie,S1,Dark,60,Ciencia Ficcion,5;Secretos:1:5\n";
+    ServicioStreaming servicio;
+    CriterioFlujo criterio;
+    criterio.calificacionMinima = 4.0;
+    criterio.genero = "ciencia ficcion";
+    servicio.MostrarFiltroArchivo("temp_flujo.txt", criterio);
+    const std::string salida = redirector.GetCout();
+    EXPECT_NE(salida.find("Inception"), std::string::npos);
+    EXPECT_NE(salida.find("Dark"), std::string::npos);
+    EXPECT_EQ(salida.find("Mala"), std::string::npos);
+    // El catálogo del servicio no cambia
+    EXPECT_EQ(servicio.GetCatalogo()->GetTamano(), 0u);
+
+    redirector.Clear();
+    criterio.soloPeliculas = true;
+    criterio.calificacionMinima = 5.0;
+    servicio.MostrarFiltroArchivo("temp_flujo.txt", criterio);
+    EXPECT_EQ(redirector.GetCout(), "No se encontraron videos con los criterios especificados.\n");
+
+    redirector.Clear();
+    servicio.MostrarFiltroArchivo("no_existe_flujo.txt", criterio);
+    EXPECT_EQ(redirector.GetCout(), "");
+    EXPECT_NE(redirector.GetCerr().find("No se pudo abrir el archivo no_existe_flujo.txt"), std::string::npos);
+    std::remove("temp_flujo.txt");
+}
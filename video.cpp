@@ -6,47 +6,67 @@
  */
 
 #include "video.h"
-#include <numeric>
-#include <iostream>
-#include <iomanip>
 
-Video::Video(const std::string& id, const std::string& nombre, double duracion, const std::string& genero)
-    : id(id), nombre(nombre), duracion(duracion), genero(genero) {}
+Video::Video(std::string_view id, std::string_view nombre, double duracion, std::string_view genero, TipoContenido tipo,
+             std::pmr::memory_resource* recurso)
+    : textos(recurso), longitudId(static_cast<std::uint32_t>(id.size())),
+      longitudNombre(static_cast<std::uint32_t>(nombre.size())), duracion(duracion), tipo(tipo) {
+    textos.reserve(id.size() + nombre.size() + genero.size());
+    textos.append(id).append(nombre).append(genero);
+}
 
-std::string Video::GetId() const {
-    return id;
+std::string_view Video::GetId() const {
+    return std::string_view(textos).substr(0, longitudId);
 }
 
-std::string Video::GetNombre() const {
-    return nombre;
+std::string_view Video::GetNombre() const {
+    return std::string_view(textos).substr(longitudId, longitudNombre);
 }
 
 double Video::GetDuracion() const {
     return duracion;
 }
 
-std::string Video::GetGenero() const {
-    return genero;
+std::string_view Video::GetGenero() const {
+    return std::string_view(textos).substr(longitudId + longitudNombre);
+}
+
+TipoContenido Video::GetTipo() const {
+    return tipo;
+}
+
+std::uint32_t Video::GetGeneroId() const {
+    return generoId;
+}
+
+void Video::SetGeneroId(std::uint32_t id) {
+    generoId = id;
 }
 
 double Video::GetCalificacionPromedio() const {
-    if (calificaciones.empty()) {
-        return 0.0;
-    }
-    double sum = std::accumulate(calificaciones.begin(), calificaciones.end(), 0.0);
-    return sum / calificaciones.size();
+    return calificaciones.GetPromedio();
 }
 
-void Video::Calificar(int calificacion) {
-    if (calificacion >= 1 && calificacion <= 5) {
-        calificaciones.push_back(calificacion);
-    }
+const AgregadoCalificaciones& Video::GetCalificaciones() const {
+    return calificaciones;
 }
 
-void Video::ImprimirInfoBase() const {
-    std::cout << "ID: " << id << std::endl;
-    std::cout << "Nombre: " << nombre << std::endl;
-    std::cout << "Duracion: " << duracion << " mins" << std::endl;
-    std::cout << "Genero: " << genero << std::endl;
-    std::cout << "Calificacion promedio: " << std::fixed << std::setprecision(1) << GetCalificacionPromedio() << std::endl;
-}
\ No newline at end of file
+bool Video::Calificar(int calificacion) {
+    return calificaciones.Agregar(calificacion);
+}
+
+bool Video::Calificar(int calificacion, std::uint64_t veces) {
+    return calificaciones.Agregar(calificacion, veces);
+}
+
+bool Video::Calificar(const AgregadoCalificaciones::Frecuencias& frecuencias) {
+    return calificaciones.Agregar(frecuencias);
+}
+
+void BorradorVideo::operator()(Video* video) const {
+    if (arena == nullptr) {
+        delete video;
+        return;
+    }
+    video->~Video(); // La memoria la libera la arena
+}
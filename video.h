@@ -8,12 +8,29 @@
  * @date 2025-06-15
  */
 
+#include "calificaciones.h"
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <new>
 #include <string>
-#include <vector>
-#include <numeric>
+#include <string_view>
+#include <utility>
 #include <iostream>
 #include <iomanip>
 
+/**
+ * @enum TipoContenido
+ * @brief Tipo concreto de un Video, guardado en el propio objeto.
+ *
+ * Permite distinguir películas de series con una comparación de enteros, sin
+ * dynamic_cast (que recorre la información RTTI en cada llamada).
+ */
+enum class TipoContenido : std::uint8_t {
+    Pelicula = 0, ///< El video es una Pelicula.
+    Serie = 1     ///< El video es una Serie.
+};
+
 /**
  * @class Video
  * @brief Clase base para representar contenido de video en el servicio de streaming.
@@ -23,19 +40,15 @@
  */
 class Video {
 protected:
-    std::string id;
-    std::string nombre;
+    // id, nombre y género concatenados en un único búfer del recurso recibido al construir
+    // (ver CrearVideo); los getters devuelven vistas sobre él, sin copiar
+    std::pmr::string textos;
+    std::uint32_t longitudId;
+    std::uint32_t longitudNombre;
     double duracion;
-    std::string genero;
-    std::vector<int> calificaciones;
-
-    /**
-     * @brief Imprime la información base común a todos los videos.
-     *
-     * Este método es utilizado por las clases derivadas para mostrar datos
-     * como ID, nombre, duración, género y calificación promedio.
-     */
-    void ImprimirInfoBase() const;
+    std::uint32_t generoId = UINT32_MAX;
+    TipoContenido tipo;
+    AgregadoCalificaciones calificaciones;
 
 public:
     /**
@@ -44,8 +57,11 @@ public:
      * @param nombre El nombre o título del video.
      * @param duracion La duración del video en minutos.
      * @param genero El género del video.
+     * @param tipo El tipo concreto de la clase derivada.
+     * @param recurso El recurso de memoria de los textos (por defecto, el heap).
      */
-    Video(const std::string& id, const std::string& nombre, double duracion, const std::string& genero);
+    Video(std::string_view id, std::string_view nombre, double duracion, std::string_view genero, TipoContenido tipo,
+          std::pmr::memory_resource* recurso = std::pmr::get_default_resource());
 
     /**
      * @brief Destructor virtual por defecto.
@@ -56,29 +72,100 @@ public:
 
     // --- Getters ---
 
-    /** @brief Obtiene el ID del video. @return El ID. */
-    std::string GetId() const;
-    /** @brief Obtiene el nombre del video. @return El nombre. */
-    std::string GetNombre() const;
+    /** @brief Obtiene el ID del video. @return Una vista válida mientras exista el video. */
+    std::string_view GetId() const;
+    /** @brief Obtiene el nombre del video. @return Una vista válida mientras exista el video. */
+    std::string_view GetNombre() const;
     /** @brief Obtiene la duración del video. @return La duración en minutos. */
     double GetDuracion() const;
-    /** @brief Obtiene el género del video. @return El género. */
-    std::string GetGenero() const;
+    /** @brief Obtiene el género del video. @return Una vista válida mientras exista el video. */
+    std::string_view GetGenero() const;
+    /** @brief Obtiene el tipo concreto del video. @return TipoContenido::Pelicula o TipoContenido::Serie. */
+    TipoContenido GetTipo() const;
+    /** @brief Obtiene el identificador del género asignado al cargar el catálogo. @return El identificador (UINT32_MAX si no tiene). */
+    std::uint32_t GetGeneroId() const;
+    /** @brief Asigna el identificador del género (ver DiccionarioGeneros). @param id El identificador. */
+    void SetGeneroId(std::uint32_t id);
     /** @brief Calcula y obtiene la calificación promedio del video. @return La calificación promedio (0.0 si no hay calificaciones). */
     double GetCalificacionPromedio() const;
+    /** @brief Obtiene el resumen de calificaciones (conteo, suma e histograma). @return El resumen. */
+    const AgregadoCalificaciones& GetCalificaciones() const;
 
     /**
      * @brief Agrega una nueva calificación al video.
      * @param calificacion Un entero entre 1 y 5. Calificaciones fuera de este rango son ignoradas.
+     * @return false si no se agregó (ver AgregadoCalificaciones::Agregar(int)).
      */
-    void Calificar(int calificacion);
+    bool Calificar(int calificacion);
 
     /**
-     * @brief Muestra los datos completos del video.
+     * @brief Agrega varias veces la misma calificación al video en una sola operación.
+     * @param calificacion Un entero entre 1 y 5. Calificaciones fuera de este rango son ignoradas.
+     * @param veces Cuántas veces se agrega.
+     * @return false si no se agregó ninguna (ver AgregadoCalificaciones::Agregar(int, std::uint64_t)).
+     */
+    bool Calificar(int calificacion, std::uint64_t veces);
+
+    /**
+     * @brief Agrega al video un grupo de calificaciones distintas en una sola operación.
+     * @param frecuencias Cuántas veces se agrega cada calificación.
+     * @return false si no se agregó ninguna (ver AgregadoCalificaciones::Agregar(const Frecuencias&)).
+     */
+    bool Calificar(const AgregadoCalificaciones::Frecuencias& frecuencias);
+
+    /**
+     * @brief Muestra los datos completos del video en la consola.
      *
-     * Esta es una función virtual pura que debe ser implementada por las clases derivadas.
+     * Esta es una función virtual pura que debe ser implementada por las clases
+     * derivadas; el formato lo define la clase Formateador.
      */
     virtual void MostrarDatos() const = 0;
 };
 
+/**
+ * @class BorradorVideo
+ * @brief Borrador de PtrVideo que sabe si el video vive en una arena.
+ *
+ * Un video creado con new (por ejemplo, con std::make_unique) se elimina con
+ * delete. Un video creado con CrearVideo dentro de una arena solo se destruye:
+ * su memoria se libera de una vez junto con la arena.
+ */
+class BorradorVideo {
+private:
+    std::pmr::memory_resource* arena = nullptr;
+
+public:
+    /** @brief Borrador para videos creados con new. */
+    BorradorVideo() = default;
+    /** @brief Borrador para videos creados en una arena. @param arena La arena dueña de la memoria. */
+    explicit BorradorVideo(std::pmr::memory_resource* arena) : arena(arena) {}
+    /** @brief Permite convertir un std::unique_ptr de std::make_unique en PtrVideo. */
+    template <typename T>
+    BorradorVideo(const std::default_delete<T>&) {}
+
+    /** @brief Destruye el video y, si no vive en una arena, libera su memoria. @param video El video. */
+    void operator()(Video* video) const;
+};
+
+/** @brief Puntero dueño de un video del catálogo, creado con new o en una arena. */
+using PtrVideo = std::unique_ptr<Video, BorradorVideo>;
+
+/**
+ * @brief Crea un video (y sus textos) dentro de una arena de memoria.
+ *
+ * El objeto y sus cadenas se toman de la arena, así que cargar un catálogo no hace
+ * una reserva del heap por objeto y descartarlo no libera objeto por objeto.
+ * La arena debe sobrevivir al puntero devuelto.
+ * @tparam T Pelicula o Serie.
+ * @param arena La arena de la que se toma la memoria.
+ * @param argumentos Los argumentos del constructor de T (sin el recurso de memoria).
+ * @return El video creado.
+ */
+template <typename T, typename... Argumentos>
+PtrVideo CrearVideo(std::pmr::memory_resource* arena, Argumentos&&... argumentos) {
+    void* memoria = arena->allocate(sizeof(T), alignof(T));
+    T* video = new (memoria) T(std::forward<Argumentos>(argumentos)..., arena);
+    return PtrVideo(video, BorradorVideo(arena));
+}
+
 #endif // VIDEO_H
\ No newline at end of file